@@ -3,4 +3,6 @@
 #include "DynamicSplineMesh.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogDynamicSplineMesh);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, DynamicSplineMesh, "DynamicSplineMesh" );
@@ -1,12 +1,67 @@
 #include "DynamicSplineMeshActor.h"
 
+#include "DynamicSplineMesh.h"
+#include "DynamicSplineMeshStats.h"
+#include "DynamicSplineMeshSubsystem.h"
+#include "SplineLayoutAdapter.h"
+#include "SplineMeshSegmentComponent.h"
 #include "LevelEditorActions.h"
+#include "DrawDebugHelpers.h"
+#include "Algo/StableSort.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Hash/CityHash.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Net/UnrealNetwork.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/ConstructorHelpers.h"
+#include "UObject/CoreNet.h"
+#include "UObject/ObjectSaveContext.h"
+
+#if WITH_EDITOR
+#include "Framework/Application/SlateApplication.h"
+#include "WorldPartition/HLOD/HLODBuilder.h"
+#endif
+
+static TAutoConsoleVariable<int32> CVarLayoutTasks(
+	TEXT("dsm.Layout.Tasks"),
+	0,
+	TEXT("Maximum number of tasks computing the segments of a spline, 0 for one per worker thread and 1 to compute them on the calling thread"));
+
+/* Number of segments below which the segments are computed on the calling thread, the tasks would cost more than the work */
+static constexpr int MinParallelSegments = 256;
+
+/*
+ * Run a body for every index of a range, split in contiguous blocks between the layout tasks
+ * The body must only write the items of its index
+ */
+template <typename BodyType>
+static void ParallelForSegments(const int _count, const BodyType& _body)
+{
+	const int _maxTasks = CVarLayoutTasks.GetValueOnAnyThread();
+	const int _workersCount = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	const int _tasksCount = FMath::Clamp(_count / MinParallelSegments, 1, _maxTasks > 0 ? _maxTasks : _workersCount);
+
+	ParallelFor(_tasksCount, [_count, _tasksCount, &_body](const int32 _taskIndex)
+	{
+		const int _first = static_cast<int>(static_cast<int64>(_count) * _taskIndex / _tasksCount);
+		const int _last = static_cast<int>(static_cast<int64>(_count) * (_taskIndex + 1) / _tasksCount);
+		for (int _index = _first; _index < _last; _index++)
+		{
+			_body(_index);
+		}
+	}, _tasksCount == 1);
+}
+
+#if WITH_EDITOR
+FOnSplineMeshLayoutApplied ADynamicSplineMeshActor::onLayoutApplied = FOnSplineMeshLayoutApplied();
+#endif
 
 ADynamicSplineMeshActor::ADynamicSplineMeshActor()
 {
-	PrimaryActorTick.bCanEverTick = false;
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
 	
@@ -15,6 +70,124 @@ ADynamicSplineMeshActor::ADynamicSplineMeshActor()
 
 	directionalArrow = CreateDefaultSubobject<UArrowComponent>(TEXT("ArrowComponent"));
 	directionalArrow->SetupAttachment(spline);
+
+	// Lay the decks with the floor of the bridge props by default
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> DeckMesh(TEXT("/Game/Props/Bridges/46-bridge/floor.floor"));
+	if (DeckMesh.Succeeded()) bridgeDeckComposition.mesh = DeckMesh.Object;
+}
+
+void ADynamicSplineMeshActor::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Only the definition of the layout is replicated, the spline meshes stay local
+	if (replicateLayout && !isBaked && HasAuthority() && !GetIsReplicated() && GetWorld() && GetWorld()->IsGameWorld())
+	{
+		SetReplicates(true);
+	}
+
+	// The clients load the level actors as saved and spawn the others from the class defaults
+	if (replicateLayout && HasAuthority())
+	{
+		const ADynamicSplineMeshActor* _defaults = IsNetStartupActor() ? this : GetClass()->GetDefaultObject<ADynamicSplineMeshActor>();
+		netClientInputsHash = _defaults->ComputeNetInputsHash();
+	}
+}
+void ADynamicSplineMeshActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ADynamicSplineMeshActor, netDefinition);
+	DOREPLIFETIME(ADynamicSplineMeshActor, netSegments);
+}
+void ADynamicSplineMeshActor::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// The saved spline meshes are loaded without a rebuild
+	UpdateSpatialIndex();
+}
+void ADynamicSplineMeshActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	CancelGenerate();
+
+	if (UDynamicSplineMeshSubsystem* _subsystem = UWorld::GetSubsystem<UDynamicSplineMeshSubsystem>(GetWorld()))
+	{
+		_subsystem->RemoveActor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+void ADynamicSplineMeshActor::Destroyed()
+{
+	if (UDynamicSplineMeshSubsystem* _subsystem = UWorld::GetSubsystem<UDynamicSplineMeshSubsystem>(GetWorld()))
+	{
+		_subsystem->RemoveActor(this);
+	}
+
+	Super::Destroyed();
+}
+void ADynamicSplineMeshActor::BeginDestroy()
+{
+	// The promise of a running generation must be set before it is released
+	CancelGenerate();
+
+	Super::BeginDestroy();
+}
+void ADynamicSplineMeshActor::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	// Update the levels of detail from the camera distance
+	UpdateLOD();
+}
+bool ADynamicSplineMeshActor::ShouldTickIfViewportsOnly() const
+{
+	// Allow the levels of detail to be previewed in the editor viewports
+	return useLOD;
+}
+void ADynamicSplineMeshActor::Serialize(FArchive& Ar)
+{
+	#if WITH_EDITOR
+	if (Ar.IsCooking() && bakeOnCook)
+	{
+		// The inputs left out of the cooked actor, the spline meshes and the segments used by the queries are kept
+		FMeshComposition _meshComposition = FMeshComposition();
+		TArray<FMeshComposition> _meshesComposition = TArray<FMeshComposition>();
+		TArray<FMeshComposition> _startCapComposition = TArray<FMeshComposition>();
+		TArray<FMeshComposition> _endCapComposition = TArray<FMeshComposition>();
+		TArray<FSplineMeshLane> _lanes = TArray<FSplineMeshLane>();
+		TArray<FMeshRotation> _meshesRotation = TArray<FMeshRotation>();
+		TArray<FGroupMeshRotation> _groupMeshRotation = TArray<FGroupMeshRotation>();
+		TArray<FAngleMeshRotation> _angleMeshRotation = TArray<FAngleMeshRotation>();
+		TArray<FSplineScatterLayer> _scatterLayers = TArray<FSplineScatterLayer>();
+		TArray<FVector2D> _bridgeRanges = TArray<FVector2D>();
+		bool _isBaked = true;
+
+		// Swap the inputs with the empty values around the serialization, the editor actor is left as it was
+		const auto _swapInputs = [&]()
+		{
+			Swap(meshComposition, _meshComposition);
+			Swap(meshesComposition, _meshesComposition);
+			Swap(startCapComposition, _startCapComposition);
+			Swap(endCapComposition, _endCapComposition);
+			Swap(lanes, _lanes);
+			Swap(meshesRotation, _meshesRotation);
+			Swap(groupMeshRotation, _groupMeshRotation);
+			Swap(angleMeshRotation, _angleMeshRotation);
+			Swap(scatterLayers, _scatterLayers);
+			Swap(bridgeRanges, _bridgeRanges);
+			Swap(isBaked, _isBaked);
+		};
+
+		_swapInputs();
+		Super::Serialize(Ar);
+		_swapInputs();
+		return;
+	}
+	#endif
+
+	Super::Serialize(Ar);
 }
 
 #if WITH_EDITOR
@@ -22,9 +195,23 @@ ADynamicSplineMeshActor::ADynamicSplineMeshActor()
 void ADynamicSplineMeshActor::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
+
+	// The layout of this client comes from the server
+	if (IsLayoutFromServer()) return;
+	CancelGenerate();
 	
 	// Get TimerManager
 	FTimerManager& _timerManager = GetWorld()->GetTimerManager();
+
+	// Let the timer draw a cheap preview while dragging, the full update waits for the mouse release
+	// Checked first, hashing all the inputs on each construction of a drag would cost as much as the points
+	if (IsDragging())
+	{
+		// Keep a running preview timer, restarting it on each construction of the drag would never let it draw
+		const bool _isPreviewing = _timerManager.IsTimerActive(updateTimer) && _timerManager.GetTimerRemaining(updateTimer) <= previewRate;
+		if (!_isPreviewing) _timerManager.SetTimer(updateTimer, this, &ADynamicSplineMeshActor::OnUpdateTimer, previewRate);
+		return;
+	}
 	
 	// Check if the check timer is already active
 	if (_timerManager.IsTimerActive(updateTimer))
@@ -32,9 +219,45 @@ void ADynamicSplineMeshActor::OnConstruction(const FTransform& Transform)
 		// If yes, reset it
 		_timerManager.ClearTimer(updateTimer);
 	}
-	
+
+	// Restore the saved layout if none of its inputs has changed
+	if (layoutHash != 0 && layoutHash == ComputeLayoutHash())
+	{
+		RestoreLayout();
+		return;
+	}
+
 	// Start a new timer
-	_timerManager.SetTimer(updateTimer, this, &ADynamicSplineMeshActor::UpdateSpline, updateTimerRate);
+	_timerManager.SetTimer(updateTimer, this, &ADynamicSplineMeshActor::OnUpdateTimer, updateTimerRate);
+}
+void ADynamicSplineMeshActor::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	Super::PreSave(ObjectSaveContext);
+	if (!ObjectSaveContext.IsCooking() || !bakeOnCook) return;
+
+	// The cooked spline meshes are the saved ones, the cooker doesn't trace the ground again
+	CancelGenerate();
+	if (splineMeshes.IsEmpty() || IsLayoutOutdated())
+	{
+		UE_LOG(LogDynamicSplineMesh, Warning, TEXT("%s is baked with an outdated layout, rebuild and save its level before cooking"), *GetPathName());
+	}
+}
+void ADynamicSplineMeshActor::PostEditMove(bool bFinished)
+{
+	Super::PostEditMove(bFinished);
+	if (!bFinished) return;
+
+	// The drag is over, rebuild at full quality right away
+	GetWorld()->GetTimerManager().ClearTimer(updateTimer);
+	if (layoutHash == 0 || layoutHash != ComputeLayoutHash()) UpdateSpline();
+}
+void ADynamicSplineMeshActor::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	// The generated meshes are not part of the transaction, regenerate them from the restored inputs
+	GetWorld()->GetTimerManager().ClearTimer(updateTimer);
+	if (layoutHash != ComputeLayoutHash()) UpdateSpline();
 }
 void ADynamicSplineMeshActor::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
@@ -93,6 +316,8 @@ void ADynamicSplineMeshActor::PostEditChangeProperty(FPropertyChangedEvent& Prop
 
 void ADynamicSplineMeshActor::ResetSpline()
 {
+	CancelGenerate();
+
 	// Flush all debugs
 	FlushDebug();
 	
@@ -111,8 +336,26 @@ void ADynamicSplineMeshActor::ResetSpline()
 	// Update the spline
 	UpdateSpline();
 }
+void ADynamicSplineMeshActor::SetSplinePoints(const TArray<FVector>& _points, const ESplineCoordinateSpace::Type _coordinateSpace)
+{
+	CancelGenerate();
+
+	// Assign the points without updating the spline
+	spline->SetSplinePoints(_points, _coordinateSpace, false);
+	const int _pointsCount = _points.Num();
+	for (int _splinePointIndex = 0; _splinePointIndex < _pointsCount; _splinePointIndex++)
+	{
+		spline->SetSplinePointType(_splinePointIndex, splinePointType, false);
+	}
+
+	// Update it once
+	spline->UpdateSpline();
+	lenght = spline->GetSplineLength();
+}
 void ADynamicSplineMeshActor::SetSplineLenght(const float _lenght)
 {
+	CancelGenerate();
+
 	// Update the spline lenght
 	lenght = _lenght;
 	
@@ -128,283 +371,1449 @@ void ADynamicSplineMeshActor::SetSplineLenght(const float _lenght)
 
 #pragma endregion
 
-#pragma region Update
+#pragma region Update
+
+void ADynamicSplineMeshActor::UpdateSpline()
+{
+	DSM_SCOPE_CYCLE_COUNTER(UpdateSpline);
+	if (IsLayoutFromServer()) return;
+	if (isBaked)
+	{
+		UE_LOG(LogDynamicSplineMesh, Warning, TEXT("%s was baked when cooked and can't be rebuilt"), *GetName());
+		return;
+	}
+	CancelGenerate();
+
+	// Prepare the spline
+	PrepareLayout();
+	FSplineNetDefinition _definition = FSplineNetDefinition();
+	const bool _sendLayout = PrepareNetDefinition(_definition);
+
+	// Compute the segments and create their meshes
+	ComputeLayout();
+	FinishLayout();
+
+	// Send the definition with the checksum of the segments
+	if (_sendLayout) SendNetDefinition(_definition);
+}
+void ADynamicSplineMeshActor::OnUpdateTimer()
+{
+	// Keep the preview while the mouse is held
+	if (IsDragging())
+	{
+		DrawPreview();
+		GetWorld()->GetTimerManager().SetTimer(updateTimer, this, &ADynamicSplineMeshActor::OnUpdateTimer, previewRate);
+		return;
+	}
+
+	// A drag may end on the inputs of the saved layout
+	if (layoutHash != 0 && layoutHash == ComputeLayoutHash())
+	{
+		RestoreLayout();
+		return;
+	}
+
+	UpdateSpline();
+}
+bool ADynamicSplineMeshActor::IsDragging() const
+{
+#if WITH_EDITOR
+	if (!usePreview || !FSlateApplication::IsInitialized()) return false;
+
+	// The preview is only for the editor worlds
+	const UWorld* _world = GetWorld();
+	if (!_world || _world->IsGameWorld()) return false;
+
+	return FSlateApplication::Get().GetPressedMouseButtons().Contains(EKeys::LeftMouseButton);
+#else
+	return false;
+#endif
+}
+void ADynamicSplineMeshActor::DrawPreview() const
+{
+	// Get the mesh giving the size of the boxes
+	const FMeshComposition& _meshComposition = compositionMethod != FILL && meshesComposition.Num() > 0 ? meshesComposition[0] : meshComposition;
+	const UStaticMesh* _mesh = _meshComposition.mesh;
+	const FVector& _meshSize = IsValid(_mesh) ? _mesh->GetBoundingBox().GetSize() * _meshComposition.scaleFactor : FVector(100.0f);
+
+	// Spread the boxes along the spline, a box covers several meshes on long splines
+	const float _splineLength = spline->GetSplineLength();
+	const float _meshLength = FMath::Max(_meshSize.X + (placementMethod == DUPLICATE ? gap : 0.0f), 1.0f);
+	const int _boxesCount = FMath::Clamp(FMath::CeilToInt(_splineLength / _meshLength), 1, previewBoxCount);
+	const float _boxLength = _splineLength / _boxesCount;
+	const FVector& _extent = FVector(_boxLength / 2.0f, _meshSize.Y / 2.0f, _meshSize.Z / 2.0f);
+
+	// The boxes last until the next refresh of the timer, so none are left behind once the spline moved
+	const float _lifeTime = previewRate;
+	for (int _boxIndex = 0; _boxIndex < _boxesCount; _boxIndex++)
+	{
+		const float _distance = (_boxIndex + 0.5f) * _boxLength;
+		const FVector& _location = spline->GetLocationAtDistanceAlongSpline(_distance, ESplineCoordinateSpace::World);
+		const FQuat& _rotation = spline->GetQuaternionAtDistanceAlongSpline(_distance, ESplineCoordinateSpace::World);
+		DrawDebugBox(GetWorld(), _location, _extent, _rotation, previewColor, false, _lifeTime);
+	}
+}
+void ADynamicSplineMeshActor::PrepareLayout()
+{
+	lenght = spline->GetSplineLength();
+	buildStats = FSplineMeshBuildStats();
+
+	// Snap the spline on the ground, the previous meshes and segments are kept until the new segments are taken
+	{
+		FScopedDurationTimer _timer(buildStats.snapTime);
+		SnapOnGround();
+	}
+
+	// Enable bridge mode
+	{
+		FScopedDurationTimer _timer(buildStats.bridgeTime);
+		MakeBridge();
+	}
+
+	// Copy the inputs of the layout, they are the only ones read while the segments are computed
+	layoutInputs = MakeLayoutInputs();
+}
+FSplineMeshLayoutInputs ADynamicSplineMeshActor::MakeLayoutInputs() const
+{
+	FSplineMeshLayoutInputs _inputs = FSplineMeshLayoutInputs();
+	_inputs.hermiteSpline = SplineLayoutAdapter::MakeHermiteSpline(spline);
+	_inputs.mainLane = MakeMainLane();
+	_inputs.lanes = lanes;
+	_inputs.laneFrameSpacing = laneFrameSpacing;
+	_inputs.seed = seed;
+	_inputs.groundUp = snapOnGround ? GetActorUpVector() : FVector::ZeroVector;
+	_inputs.bridgeRanges = bridgeRanges;
+	_inputs.hasBridgeDecks = HasBridgeDecks();
+	_inputs.deckComposition = GetDeckComposition();
+	_inputs.sagProfile = bridgeMethod == PARABOLA ? SplineLayout::SagProfile::Parabola : SplineLayout::SagProfile::Catenary;
+	_inputs.sag = reverseTension ? tension : -tension;
+	_inputs.supportSpacing = supportSpacing;
+	_inputs.deckUp = spline->GetComponentTransform().InverseTransformVectorNoScale(FVector::UpVector);
+	_inputs.cacheKey = FSplineMeshLayoutCache::IsEnabled() ? ComputeLayoutCacheKey(_inputs) : 0;
+	return _inputs;
+}
+void ADynamicSplineMeshActor::FinishLayout()
+{
+	// Create the meshes of the segments
+	TakeComputedLayout();
+	ApplyLayout();
+
+	// Register the inputs used by this layout
+	layoutHash = ComputeLayoutHash();
+	buildStats.endTime = FPlatformTime::Seconds();
+}
+void ADynamicSplineMeshActor::FlushSpline()
+{
+	DSM_SCOPE_CYCLE_COUNTER(FlushSpline);
+
+	// Run through the spline meshes
+	const int _splineMeshCount = splineMeshes.Num();
+	for (int _splineMeshIndex = 0; _splineMeshIndex < _splineMeshCount; _splineMeshIndex++)
+	{
+		// Get the current spline mesh and destroy it, the construction script may already have destroyed it
+		USplineMeshComponent* _currentSplineMesh = splineMeshes[_splineMeshIndex];
+		if (!IsValid(_currentSplineMesh)) continue;
+		_currentSplineMesh->DestroyComponent();
+		DSM_INC_COUNTER(ComponentsDestroyed, 1);
+	}
+
+	// Run through the level of detail chunks
+	const int _lodChunkCount = lodChunks.Num();
+	for (int _lodChunkIndex = 0; _lodChunkIndex < _lodChunkCount; _lodChunkIndex++)
+	{
+		// Destroy the merged mesh of the chunk
+		USplineMeshComponent* _mergedMesh = lodChunks[_lodChunkIndex].mergedMesh;
+		if (!IsValid(_mergedMesh)) continue;
+		_mergedMesh->DestroyComponent();
+		DSM_INC_COUNTER(ComponentsDestroyed, 1);
+	}
+
+	// Clear the spline meshes
+	splineMeshes.Empty();
+	lodChunks.Empty();
+}
+void ADynamicSplineMeshActor::ComputeLayout()
+{
+	computedLayoutTime = 0.0;
+	FScopedDurationTimer _timer(computedLayoutTime);
+
+	// Clear the previous segments
+	computedSegments.Reset();
+
+	// Copy the segments of an identical spline when they are cached, only their rotation and their meshes are left to this actor
+	FSplineMeshLayoutCache& _layoutCache = FSplineMeshLayoutCache::Get();
+	if (layoutInputs.cacheKey != 0 && _layoutCache.Find(layoutInputs.cacheKey, computedSegments)) return;
+
+	// Restart the random composition so the same inputs give the same meshes
+	FRandomStream _randomStream = FRandomStream(layoutInputs.seed);
+	
+	// Select the method associated with the placement method
+	switch (layoutInputs.mainLane.placementMethod)
+	{
+		case DUPLICATE:
+			DuplicateMesh(layoutInputs, _randomStream, computedSegments);
+			break;
+
+		case EXTEND:
+			ExtendMesh(layoutInputs, computedSegments);
+			break;
+
+		default:
+			break;
+	}
+
+	// Add the lanes after the spline
+	ComputeLanes(layoutInputs, _randomStream, computedSegments);
+
+	if (layoutInputs.cacheKey != 0) _layoutCache.Add(layoutInputs.cacheKey, computedSegments);
+}
+void ADynamicSplineMeshActor::TakeComputedLayout()
+{
+	// Flush the previous meshes only now, they stay visible and indexed while the new segments are computed
+	{
+		FScopedDurationTimer _timer(buildStats.flushTime);
+		FlushSpline();
+	}
+
+	segments = MoveTemp(computedSegments);
+	buildStats.layoutTime = computedLayoutTime;
+}
+void ADynamicSplineMeshActor::ApplyLayout()
+{
+	AddSegmentMeshes(0, segments.Num());
+	FinishApplyLayout();
+}
+void ADynamicSplineMeshActor::AddSegmentMeshes(const int _firstSegment, const int _count)
+{
+	FScopedDurationTimer _timer(buildStats.meshesTime);
+
+	const int _lastSegment = FMath::Min(_firstSegment + _count, segments.Num());
+	const int _segmentsCount = FMath::Max(_lastSegment - _firstSegment, 0);
+
+	// Rotate the segments in parallel, only the components are created on this thread
+	TArray<FSplineMeshValues> _meshesValues = TArray<FSplineMeshValues>();
+	{
+		DSM_SCOPE_CYCLE_COUNTER(RotateSplineMesh);
+		FScopedDurationTimer _rotateTimer(buildStats.rotateTime);
+		_meshesValues.SetNum(_segmentsCount);
+		ParallelForSegments(_segmentsCount, [this, _firstSegment, &_meshesValues](const int _index)
+		{
+			const FSplineMeshSegment& _segment = segments[_firstSegment + _index];
+			_meshesValues[_index] = RotateSegment(_segment.values, _segment.index);
+		});
+	}
+
+	// Run through the segments
+	for (int _index = 0; _index < _segmentsCount; _index++)
+	{
+		// Add the spline mesh of the segment
+		AddSplineMesh(segments[_firstSegment + _index].meshComposition, _meshesValues[_index]);
+	}
+}
+void ADynamicSplineMeshActor::FinishApplyLayout()
+{
+	// Prepare the levels of detail of the new meshes
+	{
+		FScopedDurationTimer _timer(buildStats.meshesTime);
+		BuildLOD();
+	}
+
+	BuildCollision();
+	BuildScatter();
+	UpdateSpatialIndex();
+
+	#if WITH_EDITOR
+	onLayoutApplied.Broadcast(this);
+	#endif
+}
+void ADynamicSplineMeshActor::BuildCollision()
+{
+	DSM_SCOPE_CYCLE_COUNTER(BuildCollision);
+	FScopedDurationTimer _timer(buildStats.collisionTime);
+
+	// Destroy the chunks that are no longer needed
+	const int _splineMeshCount = splineMeshes.Num();
+	const int _chunksCount = collisionMode == NO_COLLISION ? 0 : FMath::DivideAndRoundUp(_splineMeshCount, collisionChunkSize);
+	while (collisionChunks.Num() > _chunksCount)
+	{
+		USplineMeshCollisionComponent* _collisionChunk = collisionChunks.Pop();
+		if (IsValid(_collisionChunk)) _collisionChunk->DestroyComponent();
+	}
+
+	// Run through the chunks
+	const bool _useConvex = collisionMode == CONVEX;
+	collisionChunks.SetNum(_chunksCount);
+	for (int _chunkIndex = 0; _chunkIndex < _chunksCount; _chunkIndex++)
+	{
+		// Fit a shape around each spline mesh of the chunk
+		FKAggregateGeom _geometry = FKAggregateGeom();
+		const int _firstIndex = _chunkIndex * collisionChunkSize;
+		const int _lastIndex = FMath::Min(_firstIndex + collisionChunkSize, _splineMeshCount);
+		for (int _splineMeshIndex = _firstIndex; _splineMeshIndex < _lastIndex; _splineMeshIndex++)
+		{
+			USplineMeshCollisionComponent::AddSplineMeshShape(splineMeshes[_splineMeshIndex], _useConvex, _geometry);
+		}
+
+		// Get the body of the chunk, a body destroyed with the construction script is created again
+		USplineMeshCollisionComponent*& _collisionChunk = collisionChunks[_chunkIndex];
+		if (!IsValid(_collisionChunk)) _collisionChunk = CreateAttachedComponent<USplineMeshCollisionComponent>();
+		if (!_collisionChunk) continue;
+
+		if (_collisionChunk->GetCollisionProfileName() != collisionProfile.Name)
+		{
+			_collisionChunk->SetCollisionProfileName(collisionProfile.Name);
+		}
+
+		// Only the chunks whose shapes changed are rebuilt
+		if (_collisionChunk->SetGeometry(_geometry))
+		{
+			DSM_INC_COUNTER(CollisionChunksRebuilt, 1);
+			buildStats.collisionChunksRebuilt++;
+		}
+	}
+}
+void ADynamicSplineMeshActor::BuildScatter()
+{
+	DSM_SCOPE_CYCLE_COUNTER(BuildScatter);
+	FScopedDurationTimer _timer(buildStats.scatterTime);
+
+	// Destroy the instanced meshes of the removed layers
+	const int _layersCount = scatterLayers.Num();
+	while (scatterComponents.Num() > _layersCount)
+	{
+		UInstancedStaticMeshComponent* _scatterComponent = scatterComponents.Pop();
+		if (IsValid(_scatterComponent)) _scatterComponent->DestroyComponent();
+	}
+
+	// Run through the layers
+	TArray<FTransform> _transforms = TArray<FTransform>();
+	scatterComponents.SetNum(_layersCount);
+	for (int _layerIndex = 0; _layerIndex < _layersCount; _layerIndex++)
+	{
+		const FSplineScatterLayer& _layer = scatterLayers[_layerIndex];
+		UInstancedStaticMeshComponent*& _scatterComponent = scatterComponents[_layerIndex];
+		if (!IsValid(_scatterComponent)) _scatterComponent = CreateAttachedComponent<UInstancedStaticMeshComponent>();
+		if (!_scatterComponent) continue;
+
+		// Apply the settings of the layer
+		_scatterComponent->ClearInstances();
+		_scatterComponent->SetStaticMesh(_layer.mesh);
+		_scatterComponent->SetCollisionEnabled(_layer.useCollision ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+		_scatterComponent->SetCanEverAffectNavigation(_layer.useCollision);
+		_scatterComponent->SetCullDistances(0, FMath::RoundToInt(_layer.cullDistance));
+		if (!IsValid(_layer.mesh)) continue;
+
+		// Add all the props at once
+		ComputeScatterTransforms(_layer, _transforms);
+		_scatterComponent->AddInstances(_transforms, false);
+		DSM_INC_COUNTER(ScatteredProps, _transforms.Num());
+		buildStats.scatteredProps += _transforms.Num();
+	}
+}
+void ADynamicSplineMeshActor::ComputeScatterTransforms(const FSplineScatterLayer& _layer, TArray<FTransform>& _transforms) const
+{
+	// The values of a prop drawn before its evaluation
+	struct FScatterProp
+	{
+		double distance = 0.0;
+		float sideJitter = 0.0f;
+		float yaw = 0.0f;
+		float scale = 1.0f;
+	};
+
+	// Init local values
+	const float _splineLength = spline->GetSplineLength();
+	const float _spacing = FMath::Max(_layer.spacing, 1.0f);
+	const int _propsCount = _layer.startOffset > _splineLength ? 0 : FMath::FloorToInt((_splineLength - _layer.startOffset) / _spacing) + 1;
+	FRandomStream _random = FRandomStream(_layer.seed);
+	TArray<FScatterProp> _props = TArray<FScatterProp>();
+	_props.Reserve(_propsCount);
+
+	// Run through the props
+	for (int _propIndex = 0; _propIndex < _propsCount; _propIndex++)
+	{
+		// Draw every random value first so the props don't shift when one is skipped
+		FScatterProp _prop = FScatterProp();
+		const float _alongJitter = _random.FRandRange(-_layer.jitter, _layer.jitter);
+		_prop.sideJitter = _random.FRandRange(-_layer.lateralJitter, _layer.lateralJitter);
+		_prop.yaw = _random.FRandRange(-_layer.yawJitter, _layer.yawJitter);
+		_prop.scale = _random.FRandRange(_layer.scaleRange.X, _layer.scaleRange.Y);
+
+		// Compute the distance of the prop and keep it off the bridges
+		_prop.distance = FMath::Clamp(_layer.startOffset + _propIndex * _spacing + _alongJitter, 0.0f, _splineLength);
+		if (_layer.excludeBridges && IsOnBridge(_prop.distance, _layer.bridgeMargin)) continue;
+		_props.Add(_prop);
+	}
+
+	// Evaluate all the props in one batch, sorted first since the jitter can swap two neighbours
+	_props.StableSort([](const FScatterProp& _a, const FScatterProp& _b) { return _a.distance < _b.distance; });
+	const int _keptCount = _props.Num();
+	TArray<double> _distances = TArray<double>();
+	_distances.SetNumUninitialized(_keptCount);
+	for (int _propIndex = 0; _propIndex < _keptCount; _propIndex++)
+	{
+		_distances[_propIndex] = _props[_propIndex].distance;
+	}
+
+	const SplineLayout::HermiteSpline& _hermiteSpline = SplineLayoutAdapter::MakeHermiteSpline(spline);
+	SplineLayout::SplineSamples _samples = SplineLayout::SplineSamples();
+	SplineLayout::BatchEvaluator(_hermiteSpline).EvaluateDistances(_distances.GetData(), _distances.Num(), _samples);
+
+	// The ground is traced in world space, the transforms stay in the space of the spline
+	const FTransform& _splineTransform = spline->GetComponentTransform();
+	_transforms.Reset(_keptCount);
+	for (int _propIndex = 0; _propIndex < _keptCount; _propIndex++)
+	{
+		const FScatterProp& _prop = _props[_propIndex];
+		const FVector& _direction = SplineLayoutAdapter::ToEngine(_samples.GetTangent(_propIndex)).GetSafeNormal();
+		const float _splineYaw = FMath::RadiansToDegrees(FMath::Atan2(_direction.Y, _direction.X));
+
+		// Offset the prop to the side of the spline
+		const FVector& _side = FRotator(0.0f, _splineYaw, 0.0f).RotateVector(FVector::RightVector);
+		const FVector& _location = SplineLayoutAdapter::ToEngine(_samples.GetLocation(_propIndex)) + _side * (_layer.lateralOffset + _prop.sideJitter);
+
+		// Follow the normal of the ground under the prop, the slope of the spline when nothing is hit, or stay upright
+		FQuat _rotation = FRotator(0.0f, _splineYaw, 0.0f).Quaternion();
+		if (_layer.alignToGround)
+		{
+			FVector _groundNormal = FVector::UpVector;
+			const bool _hasGround = TraceGroundNormal(_splineTransform.TransformPosition(_location), _groundNormal);
+			_rotation = _hasGround ? FRotationMatrix::MakeFromZX(_splineTransform.InverseTransformVectorNoScale(_groundNormal), _direction).ToQuat() : FRotationMatrix::MakeFromX(_direction).ToQuat();
+		}
+
+		// Turn the prop around its own up axis
+		_rotation = _rotation * FQuat(FVector::UpVector, FMath::DegreesToRadians(_prop.yaw));
+		_transforms.Add(FTransform(_rotation, _location, FVector(_prop.scale)));
+	}
+}
+void ADynamicSplineMeshActor::GetCollisionCounts(int& _bodies, int& _shapes) const
+{
+	_bodies = 0;
+	_shapes = 0;
+	for (const USplineMeshCollisionComponent* _collisionChunk : collisionChunks)
+	{
+		if (!IsValid(_collisionChunk) || _collisionChunk->GetShapeCount() == 0) continue;
+		_bodies++;
+		_shapes += _collisionChunk->GetShapeCount();
+	}
+}
+void ADynamicSplineMeshActor::UpdateSpatialIndex()
+{
+	if (UDynamicSplineMeshSubsystem* _subsystem = UWorld::GetSubsystem<UDynamicSplineMeshSubsystem>(GetWorld()))
+	{
+		_subsystem->UpdateActor(this);
+	}
+}
+void ADynamicSplineMeshActor::GatherSpatialEntries(TArray<FSplineMeshSpatialEntry>& _entries) const
+{
+	// Run through the spline meshes, in the order of the segments
+	const int _splineMeshCount = splineMeshes.Num();
+	_entries.Reset(_splineMeshCount);
+	for (int _splineMeshIndex = 0; _splineMeshIndex < _splineMeshCount; _splineMeshIndex++)
+	{
+		const USplineMeshComponent* _splineMesh = splineMeshes[_splineMeshIndex];
+		if (!IsValid(_splineMesh)) continue;
+
+		// Get the world centerline of the mesh
+		const FTransform& _transform = _splineMesh->GetComponentTransform();
+		FSplineMeshSpatialEntry _entry = FSplineMeshSpatialEntry();
+		_entry.segmentIndex = _splineMeshIndex;
+		_entry.bounds = _splineMesh->CalcBounds(_transform).GetBox();
+		_entry.start = _transform.TransformPosition(_splineMesh->GetStartPosition());
+		_entry.end = _transform.TransformPosition(_splineMesh->GetEndPosition());
+
+		if (segments.IsValidIndex(_splineMeshIndex))
+		{
+			_entry.startDistance = segments[_splineMeshIndex].startDistance;
+			_entry.endDistance = segments[_splineMeshIndex].endDistance;
+		}
+
+		_entries.Add(_entry);
+	}
+}
+const FSplineMeshSegment* ADynamicSplineMeshActor::FindSegment(const USplineMeshComponent* _splineMesh) const
+{
+	const int _splineMeshIndex = splineMeshes.IndexOfByKey(_splineMesh);
+	return segments.IsValidIndex(_splineMeshIndex) ? &segments[_splineMeshIndex] : nullptr;
+}
+void ADynamicSplineMeshActor::GetUsedMeshes(TSet<UStaticMesh*>& _meshes) const
+{
+	// Add the meshes of a composition that are set
+	const auto _addMeshes = [&_meshes](const FMeshComposition& _meshComposition)
+	{
+		if (IsValid(_meshComposition.mesh)) _meshes.Add(_meshComposition.mesh);
+		if (IsValid(_meshComposition.lodMesh)) _meshes.Add(_meshComposition.lodMesh);
+	};
+	const auto _addLaneMeshes = [&_addMeshes](const FSplineMeshLane& _lane)
+	{
+		_addMeshes(_lane.meshComposition);
+		for (const FMeshComposition& _meshComposition : _lane.meshesComposition) _addMeshes(_meshComposition);
+		for (const FMeshComposition& _meshComposition : _lane.startCapComposition) _addMeshes(_meshComposition);
+		for (const FMeshComposition& _meshComposition : _lane.endCapComposition) _addMeshes(_meshComposition);
+	};
+
+	// The spline itself and its lanes
+	_addLaneMeshes(MakeMainLane());
+	if (HasBridgeDecks()) _addMeshes(GetDeckComposition());
+	for (const FSplineMeshLane& _lane : lanes)
+	{
+		_addLaneMeshes(_lane);
+	}
+}
+#if WITH_EDITOR
+TSubclassOf<UHLODBuilder> ADynamicSplineMeshActor::GetHLODBuilderClass() const
+{
+	// The default builder lives in the editor module, it is only found once this module is loaded
+	return hlodBuilderClass.IsValid() ? TSubclassOf<UHLODBuilder>(hlodBuilderClass.ResolveClass()) : nullptr;
+}
+#endif
+void ADynamicSplineMeshActor::RestoreLayout()
+{
+	DSM_SCOPE_CYCLE_COUNTER(RestoreLayout);
+
+	buildStats = FSplineMeshBuildStats();
+
+	// Recreate the spline meshes without any ground check
+	{
+		FScopedDurationTimer _timer(buildStats.flushTime);
+		FlushSpline();
+	}
+	ApplyLayout();
+	buildStats.endTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogDynamicSplineMesh, Verbose, TEXT("%s: restored %d segments in %.3f ms"), *GetName(), segments.Num(), buildStats.GetTotalTime() * 1000.0);
+}
+uint64 ADynamicSplineMeshActor::ComputeLayoutHash() const
+{
+	TArray<uint8> _bytes = TArray<uint8>();
+	FMemoryWriter _writer(_bytes);
+
+	#pragma region Spline
+
+	FName _version = version;
+	FTransform _transform = GetActorTransform();
+	FInterpCurveVector _positions = spline->SplineCurves.Position;
+	bool _isClosedLoop = spline->IsClosedLoop();
+	TEnumAsByte<ESplinePointType::Type> _splinePointType = splinePointType;
+	_writer << _version << _transform << _positions << _isClosedLoop << _splinePointType;
+
+	#pragma endregion
+
+	#pragma region Composition
+
+	TEnumAsByte<ECompositionMethod> _compositionMethod = compositionMethod;
+	int _seed = seed;
+	_writer << _compositionMethod << _seed;
+	WriteMeshComposition(_writer, meshComposition);
+	WriteMeshCompositions(_writer, meshesComposition);
+	WriteMeshCompositions(_writer, startCapComposition);
+	WriteMeshCompositions(_writer, endCapComposition);
+
+	#pragma endregion
+
+	#pragma region Placement
+
+	TEnumAsByte<EPlacementMethod> _placementMethod = placementMethod;
+	float _gap = gap;
+	_writer << _placementMethod << _gap;
+
+	#pragma endregion
+
+	#pragma region Lanes
+
+	float _laneFrameSpacing = laneFrameSpacing;
+	int _lanesCount = lanes.Num();
+	_writer << _laneFrameSpacing << _lanesCount;
+	for (const FSplineMeshLane& _lane : lanes)
+	{
+		WriteLane(_writer, _lane);
+	}
+
+	#pragma endregion
+
+	#pragma region Rotation
+
+	WriteMeshRotations(_writer);
+
+	#pragma endregion
+
+	#pragma region Ground
+
+	bool _snapOnGround = snapOnGround;
+	float _zGroundCheckOffset = zGroundCheckOffset;
+	float _checkGroundDepth = checkGroundDepth;
+	TArray<TEnumAsByte<EObjectTypeQuery>> _groundLayer = groundLayer;
+	TEnumAsByte<ECheckGroundMethod> _checkGroundMethod = checkGroundMethod;
+	int _checkGroundPointsCount = checkGroundPointsCount;
+	float _checkGroundSpacing = checkGroundSpacing;
+	_writer << _snapOnGround << _zGroundCheckOffset << _checkGroundDepth << _groundLayer << _checkGroundMethod << _checkGroundPointsCount << _checkGroundSpacing;
+
+	#pragma endregion
+
+	#pragma region Bridge
+
+	bool _isBridge = isBridge;
+	bool _reverseTension = reverseTension;
+	float _tension = tension;
+	float _bridgeDepth = bridgeDepth;
+	TEnumAsByte<EBridgeMethod> _bridgeMethod = bridgeMethod;
+	float _supportSpacing = supportSpacing;
+	_writer << _isBridge << _reverseTension << _tension << _bridgeDepth << _bridgeMethod << _supportSpacing;
+	WriteMeshComposition(_writer, bridgeDeckComposition);
+
+	#pragma endregion
+
+	return CityHash64(reinterpret_cast<const char*>(_bytes.GetData()), _bytes.Num());
+}
+void ADynamicSplineMeshActor::WriteMeshComposition(FArchive& _archive, const FMeshComposition& _meshComposition) const
+{
+	// The lighting guid changes each time the mesh is rebuilt or reimported
+	const UStaticMesh* _mesh = _meshComposition.mesh;
+	FString _path = IsValid(_mesh) ? _mesh->GetPathName() : FString();
+	FBox _bounds = IsValid(_mesh) ? _mesh->GetBoundingBox() : FBox(ForceInit);
+	FGuid _meshVersion = IsValid(_mesh) ? _mesh->GetLightingGuid() : FGuid();
+	FString _lodPath = IsValid(_meshComposition.lodMesh) ? _meshComposition.lodMesh->GetPathName() : FString();
+	float _scaleFactor = _meshComposition.scaleFactor;
+	_archive << _path << _bounds << _meshVersion << _lodPath << _scaleFactor;
+}
+void ADynamicSplineMeshActor::WriteMeshCompositions(FArchive& _archive, const TArray<FMeshComposition>& _meshesComposition) const
+{
+	// The count separates the arrays written one after the other
+	int _count = _meshesComposition.Num();
+	_archive << _count;
+	for (const FMeshComposition& _meshComposition : _meshesComposition)
+	{
+		WriteMeshComposition(_archive, _meshComposition);
+	}
+}
+void ADynamicSplineMeshActor::WriteLane(FArchive& _archive, const FSplineMeshLane& _lane) const
+{
+	float _lateralOffset = _lane.lateralOffset;
+	float _verticalOffset = _lane.verticalOffset;
+	TEnumAsByte<ECompositionMethod> _compositionMethod = _lane.compositionMethod;
+	TEnumAsByte<EPlacementMethod> _placementMethod = _lane.placementMethod;
+	float _gap = _lane.gap;
+	_archive << _lateralOffset << _verticalOffset << _compositionMethod << _placementMethod << _gap;
+	WriteMeshComposition(_archive, _lane.meshComposition);
+	WriteMeshCompositions(_archive, _lane.meshesComposition);
+	WriteMeshCompositions(_archive, _lane.startCapComposition);
+	WriteMeshCompositions(_archive, _lane.endCapComposition);
+}
+void ADynamicSplineMeshActor::WriteMeshRotations(FArchive& _archive) const
+{
+	// Write the values of a mesh rotation
+	const auto _writeMeshRotation = [&_archive](const FMeshRotation& _meshRotation)
+	{
+		TEnumAsByte<EAxisRotation> _axisRotation = _meshRotation.axisRotation;
+		float _angle = _meshRotation.angle;
+		_archive << _axisRotation << _angle;
+	};
+
+	TEnumAsByte<ERotationMethod> _rotationMethod = rotationMethod;
+	_archive << _rotationMethod;
+	_writeMeshRotation(meshRotation);
+	for (const FMeshRotation& _meshRotation : meshesRotation)
+	{
+		_writeMeshRotation(_meshRotation);
+	}
+
+	for (const FGroupMeshRotation& _groupMesh : groupMeshRotation)
+	{
+		int _startIndex = _groupMesh.startIndex;
+		int _endIndex = _groupMesh.endIndex;
+		_archive << _startIndex << _endIndex;
+		_writeMeshRotation(_groupMesh.meshRotation);
+	}
+
+	for (const FAngleMeshRotation& _angleMesh : angleMeshRotation)
+	{
+		TArray<unsigned int> _indexes = _angleMesh.indexes;
+		_archive << _indexes;
+		_writeMeshRotation(_angleMesh.meshRotation);
+	}
+}
+uint64 ADynamicSplineMeshActor::ComputeLayoutCacheKey(const FSplineMeshLayoutInputs& _inputs) const
+{
+	TArray<uint8> _bytes = TArray<uint8>();
+	FMemoryWriter _writer(_bytes);
+
+	// The local curve, once snapped on the ground and bridged, the transform of the actor is left out
+	FName _version = version;
+	FInterpCurveVector _positions = spline->SplineCurves.Position;
+	bool _isClosedLoop = spline->IsClosedLoop();
+	int32 _stepsPerSegment = spline->ReparamStepsPerSegment;
+	_writer << _version << _positions << _isClosedLoop << _stepsPerSegment;
+
+	// The compositions and the placements of the spline and its lanes
+	WriteLane(_writer, _inputs.mainLane);
+	float _laneFrameSpacing = _inputs.laneFrameSpacing;
+	int _lanesCount = _inputs.lanes.Num();
+	_writer << _laneFrameSpacing << _lanesCount;
+	for (const FSplineMeshLane& _lane : _inputs.lanes)
+	{
+		WriteLane(_writer, _lane);
+	}
+
+	// The rotations and the seed
+	WriteMeshRotations(_writer);
+	int _seed = _inputs.seed;
+	FVector _groundUp = _inputs.groundUp;
+	_writer << _seed << _groundUp;
+
+	// The bridges
+	TArray<FVector2D> _bridgeRanges = _inputs.bridgeRanges;
+	bool _hasBridgeDecks = _inputs.hasBridgeDecks;
+	uint8 _sagProfile = static_cast<uint8>(_inputs.sagProfile);
+	double _sag = _inputs.sag;
+	float _supportSpacing = _inputs.supportSpacing;
+	FVector _deckUp = _inputs.deckUp;
+	_writer << _bridgeRanges << _hasBridgeDecks << _sagProfile << _sag << _supportSpacing << _deckUp;
+	WriteMeshComposition(_writer, _inputs.deckComposition);
+
+	// 0 marks the inputs that aren't cached
+	const uint64 _key = CityHash64(reinterpret_cast<const char*>(_bytes.GetData()), _bytes.Num());
+	return _key != 0 ? _key : 1;
+}
+
+#pragma endregion
+
+#pragma region Network
+
+void ADynamicSplineMeshActor::Rebuild()
+{
+	UpdateSpline();
+}
+uint32 ADynamicSplineMeshActor::ComputeSegmentsChecksum() const
+{
+	TArray<uint8> _bytes = TArray<uint8>();
+	FMemoryWriter _writer(_bytes);
+
+	// Run through the segments
+	for (const FSplineMeshSegment& _segment : segments)
+	{
+		const UStaticMesh* _mesh = _segment.meshComposition.mesh;
+		FString _path = IsValid(_mesh) ? _mesh->GetPathName() : FString();
+		FSplineMeshValues _values = _segment.values;
+		int _index = _segment.index;
+		_writer << _path << _values.start << _values.startTangent << _values.end << _values.endTangent << _values.startScale << _values.endScale << _index;
+	}
+
+	return CityHash32(reinterpret_cast<const char*>(_bytes.GetData()), _bytes.Num());
+}
+uint32 ADynamicSplineMeshActor::ComputeNetInputsHash() const
+{
+	TArray<uint8> _bytes = TArray<uint8>();
+	FMemoryWriter _writer(_bytes);
+
+	// The compositions of the spline and of its lanes
+	WriteMeshComposition(_writer, meshComposition);
+	WriteMeshCompositions(_writer, meshesComposition);
+	WriteMeshCompositions(_writer, startCapComposition);
+	WriteMeshCompositions(_writer, endCapComposition);
+
+	float _laneFrameSpacing = laneFrameSpacing;
+	int _lanesCount = lanes.Num();
+	_writer << _laneFrameSpacing << _lanesCount;
+	for (const FSplineMeshLane& _lane : lanes)
+	{
+		float _lateralOffset = _lane.lateralOffset;
+		float _verticalOffset = _lane.verticalOffset;
+		TEnumAsByte<ECompositionMethod> _laneCompositionMethod = _lane.compositionMethod;
+		TEnumAsByte<EPlacementMethod> _lanePlacementMethod = _lane.placementMethod;
+		float _laneGap = _lane.gap;
+		_writer << _lateralOffset << _verticalOffset << _laneCompositionMethod << _lanePlacementMethod << _laneGap;
+		WriteMeshComposition(_writer, _lane.meshComposition);
+		WriteMeshCompositions(_writer, _lane.meshesComposition);
+		WriteMeshCompositions(_writer, _lane.startCapComposition);
+		WriteMeshCompositions(_writer, _lane.endCapComposition);
+	}
+
+	// The ground offset of the meshes and the decks of the bridges
+	bool _snapOnGround = snapOnGround;
+	bool _isBridge = isBridge;
+	bool _reverseTension = reverseTension;
+	float _tension = tension;
+	TEnumAsByte<EBridgeMethod> _bridgeMethod = bridgeMethod;
+	float _supportSpacing = supportSpacing;
+	_writer << _snapOnGround << _isBridge << _reverseTension << _tension << _bridgeMethod << _supportSpacing;
+	WriteMeshComposition(_writer, bridgeDeckComposition);
+
+	return CityHash32(reinterpret_cast<const char*>(_bytes.GetData()), _bytes.Num());
+}
+int ADynamicSplineMeshActor::QuantizeNetDefinition(FSplineNetDefinition& _definition)
+{
+	// Write the definition as it is sent
+	FNetBitWriter _writer(nullptr, 256);
+	bool _success = false;
+	_definition.NetSerialize(_writer, nullptr, _success);
+
+	// Read it back to get the quantized values
+	FNetBitReader _reader(nullptr, _writer.GetData(), _writer.GetNumBits());
+	_definition.NetSerialize(_reader, nullptr, _success);
+	if (!_success || _reader.IsError())
+	{
+		UE_LOG(LogDynamicSplineMesh, Warning, TEXT("Failed to quantize a spline definition of %d points"), _definition.points.Num());
+	}
+
+	return static_cast<int>(_writer.GetNumBits());
+}
+FSplineNetDefinition ADynamicSplineMeshActor::MakeNetDefinition() const
+{
+	FSplineNetDefinition _definition = FSplineNetDefinition();
+
+	// Run through the spline points
+	const int _pointsCount = spline->GetNumberOfSplinePoints();
+	_definition.points.Reserve(_pointsCount);
+	_definition.pointTypes.Reserve(_pointsCount);
+	_definition.arriveTangents.Reserve(_pointsCount);
+	_definition.leaveTangents.Reserve(_pointsCount);
+	_definition.rotations.Reserve(_pointsCount);
+	_definition.scales.Reserve(_pointsCount);
+	for (int _splinePointIndex = 0; _splinePointIndex < _pointsCount; _splinePointIndex++)
+	{
+		const FRotator& _rotation = spline->GetRotationAtSplinePoint(_splinePointIndex, ESplineCoordinateSpace::Local);
+		const FVector& _scale = spline->GetScaleAtSplinePoint(_splinePointIndex);
+		_definition.points.Add(spline->GetLocationAtSplinePoint(_splinePointIndex, ESplineCoordinateSpace::Local));
+		_definition.pointTypes.Add(static_cast<uint8>(spline->GetSplinePointType(_splinePointIndex)));
+		_definition.arriveTangents.Add(spline->GetArriveTangentAtSplinePoint(_splinePointIndex, ESplineCoordinateSpace::Local));
+		_definition.leaveTangents.Add(spline->GetLeaveTangentAtSplinePoint(_splinePointIndex, ESplineCoordinateSpace::Local));
+		_definition.rotations.Add(_rotation);
+		_definition.scales.Add(_scale);
+		_definition.hasPointTransforms |= !_rotation.IsNearlyZero() || !_scale.Equals(FVector::OneVector);
+	}
+
+	// The rotations and the scales are only sent when a point has one
+	if (!_definition.hasPointTransforms)
+	{
+		_definition.rotations.Empty();
+		_definition.scales.Empty();
+	}
+
+	_definition.closedLoop = spline->IsClosedLoop();
+	_definition.compositionMethod = static_cast<uint8>(compositionMethod.GetValue());
+	_definition.placementMethod = static_cast<uint8>(placementMethod.GetValue());
+	_definition.rotationMethod = static_cast<uint8>(rotationMethod.GetValue());
+	_definition.rotationAxis = static_cast<uint8>(meshRotation.axisRotation.GetValue());
+	_definition.rotationAngle = meshRotation.angle;
+	if (rotationMethod != NONE && rotationMethod != REGULAR) _definition.meshesRotation = meshesRotation;
+	_definition.gap = gap;
+	_definition.bridgeRanges = bridgeRanges;
+	_definition.seed = seed;
+	_definition.inputsHash = ComputeNetInputsHash();
+	return _definition;
+}
+void ADynamicSplineMeshActor::ApplyNetDefinition(const FSplineNetDefinition& _definition)
+{
+	// Restore the spline points, the tangents of the automatic points are computed from the positions
+	spline->ClearSplinePoints(false);
+	const int _pointsCount = _definition.points.Num();
+	for (int _splinePointIndex = 0; _splinePointIndex < _pointsCount; _splinePointIndex++)
+	{
+		const FRotator& _rotation = _definition.hasPointTransforms ? _definition.rotations[_splinePointIndex] : FRotator::ZeroRotator;
+		const FVector& _scale = _definition.hasPointTransforms ? _definition.scales[_splinePointIndex] : FVector::OneVector;
+		spline->AddPoint(FSplinePoint(static_cast<float>(_splinePointIndex), _definition.points[_splinePointIndex], _definition.arriveTangents[_splinePointIndex], _definition.leaveTangents[_splinePointIndex],
+									  _rotation, _scale, static_cast<ESplinePointType::Type>(_definition.pointTypes[_splinePointIndex])), false);
+	}
+
+	spline->SetClosedLoop(_definition.closedLoop, false);
+	spline->UpdateSpline();
+
+	// Restore the methods
+	compositionMethod = static_cast<ECompositionMethod>(_definition.compositionMethod);
+	placementMethod = static_cast<EPlacementMethod>(_definition.placementMethod);
+	rotationMethod = static_cast<ERotationMethod>(_definition.rotationMethod);
+	meshRotation.axisRotation = static_cast<EAxisRotation>(_definition.rotationAxis);
+	meshRotation.angle = _definition.rotationAngle;
+	if (rotationMethod != NONE && rotationMethod != REGULAR) meshesRotation = _definition.meshesRotation;
+	gap = _definition.gap;
+	bridgeRanges = _definition.bridgeRanges;
+	seed = _definition.seed;
+
+	// The layout is computed from the applied definition
+	layoutInputs = MakeLayoutInputs();
+}
+void ADynamicSplineMeshActor::OnRep_NetDefinition()
+{
+	DSM_SCOPE_CYCLE_COUNTER(UpdateSpline);
+	CancelGenerate();
+
+	buildStats = FSplineMeshBuildStats();
+
+	// Regenerate the layout from the definition, or take the segments of the server when its compositions differ from the ones of this client
+	ApplyNetDefinition(netDefinition);
+	lenght = spline->GetSplineLength();
+	if (netSegments.IsEmpty())
+	{
+		if (netDefinition.inputsHash != ComputeNetInputsHash())
+		{
+			UE_LOG(LogDynamicSplineMesh, Warning, TEXT("%s: the compositions of this client differ from the server, its layout won't match"), *GetName());
+		}
+
+		ComputeLayout();
+	}
+
+	else
+	{
+		computedSegments = netSegments;
+		computedLayoutTime = 0.0;
+	}
+
+	FinishLayout();
+
+	// Check the layout against the one of the server
+	netChecksumMatches = ComputeSegmentsChecksum() == netDefinition.checksum;
+	if (!netChecksumMatches)
+	{
+		DSM_INC_COUNTER(NetChecksumMismatches, 1);
+		UE_LOG(LogDynamicSplineMesh, Warning, TEXT("%s: the %d segments generated from the replicated definition differ from the server"), *GetName(), segments.Num());
+	}
+}
+bool ADynamicSplineMeshActor::PrepareNetDefinition(FSplineNetDefinition& _definition)
+{
+	if (!ShouldSendLayout()) return false;
+
+	// Build from the quantized definition the clients will receive, so both compute the same segments
+	_definition = MakeNetDefinition();
+	netDefinitionBits = QuantizeNetDefinition(_definition);
+	ApplyNetDefinition(_definition);
+	return true;
+}
+void ADynamicSplineMeshActor::SendNetDefinition(FSplineNetDefinition& _definition)
+{
+	_definition.checksum = ComputeSegmentsChecksum();
+	netDefinition = _definition;
+
+	// The clients can't build the layout from inputs they don't have, send them the segments instead
+	if (_definition.inputsHash != netClientInputsHash) netSegments = segments;
+	else netSegments.Empty();
+}
+
+#pragma endregion
+
+#pragma region Generate
 
-void ADynamicSplineMeshActor::UpdateSpline()
+TFuture<FSplineMeshGenerateResult> ADynamicSplineMeshActor::GenerateAsync(const FSplineMeshGenerateSettings& _settings, const FOnSplineMeshGenerateProgress& _onProgress)
 {
-	lenght = spline->GetSplineLength();
-	
-	// Flush the meshes from the spline
-	FlushSpline();
+	CancelGenerate();
 
-	// Snap the spline on the ground
-	SnapOnGround();
+	generation = MakeUnique<FSplineMeshGeneration>();
+	generation->settings = _settings;
+	generation->onProgress = _onProgress;
+	generation->startTime = FPlatformTime::Seconds();
+	TFuture<FSplineMeshGenerateResult> _future = generation->promise.GetFuture();
 
-	// Enable bridge mode
-	MakeBridge();
-	
-	// Select the method associated with the placement method
-	switch (placementMethod)
+	// The layout of this client comes from the server, and the baked splines keep their cooked meshes
+	if (IsLayoutFromServer() || isBaked)
 	{
-		case DUPLICATE:
-			DuplicateMesh();
-			break;
+		CompleteGenerate(true);
+		return _future;
+	}
 
-		case EXTEND:
-			ExtendMesh();
-			break;
+	// Prepare the spline on the game thread, the ground checks need the world
+	PrepareLayout();
+	generation->sendLayout = PrepareNetDefinition(generation->netDefinition);
 
-		default:
-			break;
+	// Compute the segments from the copied inputs, the ticker takes them once the task is completed
+	if (_settings.computeOnWorker)
+	{
+		generation->layoutTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]() { ComputeLayout(); });
+	}
+
+	else
+	{
+		ComputeLayout();
 	}
+
+	// Create the spline meshes from the next frame
+	generation->tickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ADynamicSplineMeshActor::TickGenerate));
+	return _future;
 }
-void ADynamicSplineMeshActor::FlushSpline()
+void ADynamicSplineMeshActor::CancelGenerate()
 {
-	// Run through the spline meshes
-	const int _splineMeshCount = splineMeshes.Num();
-	for (int _splineMeshIndex = 0; _splineMeshIndex < _splineMeshCount; _splineMeshIndex++)
+	if (!generation) return;
+
+	// The worker reads the copied inputs and writes the computed segments, wait for it before they are replaced
+	generation->layoutTask.Wait();
+	computedSegments.Reset();
+
+	// Once taken, the previous meshes are gone and only a part of the new ones exist, clear both with the segments
+	// The object being destroyed releases its components itself
+	if (generation->layoutTaken && !HasAnyFlags(RF_BeginDestroyed))
 	{
-		// Get the current spline mesh and destroy it
-		USplineMeshComponent* _currentSplineMesh = splineMeshes[_splineMeshIndex];
-		if (!_currentSplineMesh) continue;
-		_currentSplineMesh->DestroyComponent();
+		FlushSpline();
+		segments.Empty();
+		BuildCollision();
+		UpdateSpatialIndex();
 	}
 
-	// Clear the spline meshes
-	splineMeshes.Empty();
+	// The spline may be snapped already, the next construction rebuilds it whatever its inputs
+	layoutHash = 0;
+	CompleteGenerate(true);
+}
+bool ADynamicSplineMeshActor::TickGenerate(float _deltaTime)
+{
+	if (!generation) return false;
+
+	// Wait for the segments
+	if (!generation->layoutTask.IsCompleted()) return true;
+	if (!generation->layoutTaken)
+	{
+		// The previous meshes leave the spatial index with the flush, the new ones enter it in the last frame
+		TakeComputedLayout();
+		UpdateSpatialIndex();
+		generation->layoutTaken = true;
+	}
+
+	// Create a slice of the spline meshes
+	const int _segmentCount = segments.Num();
+	const int _count = FMath::Max(generation->settings.meshesPerFrame, 1);
+	AddSegmentMeshes(generation->nextSegment, _count);
+	generation->nextSegment = FMath::Min(generation->nextSegment + _count, _segmentCount);
+	generation->onProgress.ExecuteIfBound(_segmentCount > 0 ? static_cast<float>(generation->nextSegment) / _segmentCount : 1.0f);
+	if (generation->nextSegment < _segmentCount) return true;
+
+	// Finish the layout in the last frame
+	FinishApplyLayout();
+	layoutHash = ComputeLayoutHash();
+	buildStats.endTime = FPlatformTime::Seconds();
+	if (generation->sendLayout) SendNetDefinition(generation->netDefinition);
+
+	CompleteGenerate(false);
+	return false;
+}
+void ADynamicSplineMeshActor::CompleteGenerate(const bool _cancelled)
+{
+	if (!generation) return;
+
+	// Release the generation first, the callbacks of the future may start a new one
+	const TUniquePtr<FSplineMeshGeneration> _generation = MoveTemp(generation);
+	FTSTicker::GetCoreTicker().RemoveTicker(_generation->tickerHandle);
+
+	FSplineMeshGenerateResult _result = FSplineMeshGenerateResult();
+	_result.cancelled = _cancelled;
+	_result.segmentCount = segments.Num();
+	_result.prepareTime = (buildStats.flushTime + buildStats.snapTime + buildStats.bridgeTime) * 1000.0;
+	_result.layoutTime = buildStats.layoutTime * 1000.0;
+	_result.applyTime = (buildStats.meshesTime + buildStats.collisionTime + buildStats.scatterTime) * 1000.0;
+	_result.totalTime = (FPlatformTime::Seconds() - _generation->startTime) * 1000.0;
+	_generation->promise.SetValue(_result);
 }
 
 #pragma endregion
 
 #pragma region Composition
 
-void ADynamicSplineMeshActor::DuplicateMesh()
+void ADynamicSplineMeshActor::DuplicateMesh(const FSplineMeshLayoutInputs& _inputs, FRandomStream& _randomStream, TArray<FSplineMeshSegment>& _segments)
 {
-	// Init local values
-	const float _splineLength = spline->GetSplineLength();
-	TArray<FMeshComposition> _meshesCompositions = TArray<FMeshComposition>();
-	float _totalLength = 0.0f;
+	DSM_SCOPE_CYCLE_COUNTER(DuplicateMesh);
 
-	// If the composition method is set to "Fill"
-	if (compositionMethod == FILL)
+	// Init local values
+	const SplineLayout::HermiteSpline& _hermiteSpline = _inputs.hermiteSpline;
+	const float _splineLength = static_cast<float>(_hermiteSpline.GetLength());
+
+	// Get the plan of the meshes
+	const FSplineMeshLane& _mainLane = _inputs.mainLane;
+	const FSplineMeshPlan& _plan = ComputePlan(_mainLane, _splineLength, _randomStream);
+
+	// Evaluate the ends of all the meshes in one batch, the plan is sorted along the spline
+	const int _entriesCount = _plan.entries.Num();
+	TArray<double> _distances = TArray<double>();
+	_distances.SetNumUninitialized(_entriesCount * 2);
+	for (int _entryIndex = 0; _entryIndex < _entriesCount; _entryIndex++)
 	{
-		// Get the mesh that will compose the spline
-		const UStaticMesh* _mesh = meshComposition.mesh;
-		if (!IsValid(_mesh)) return;
-
-		// Get the length of a single mesh
-		const float _sectionLength = _mesh->GetBoundingBox().GetSize().X * meshComposition.scaleFactor;
+		const FSplineMeshPlanEntry& _entry = _plan.entries[_entryIndex];
+		_distances[_entryIndex * 2] = _entry.startDistance;
+		_distances[_entryIndex * 2 + 1] = _entry.length + _entry.startDistance;
+	}
 
-		// As long as the meshes can pass on the spline
-		while (true)
-		{
-			// If the spline is full
-			if (_totalLength + _sectionLength + gap > _splineLength) break;
+	SplineLayout::SplineSamples _samples = SplineLayout::SplineSamples();
+	SplineLayout::BatchEvaluator(_hermiteSpline).EvaluateDistances(_distances.GetData(), _distances.Num(), _samples);
 
-			// Add a mesh to the spline
-			_totalLength += _sectionLength + gap;
-			_meshesCompositions.Add(meshComposition);
-		}
+	// Keep the meshes of the plan that are set, each one gets its slot in the segments
+	// The meshes crossing a bridge are replaced by its deck
+	const bool _hasBridgeDecks = _inputs.hasBridgeDecks;
+	TArray<int> _validEntries = TArray<int>();
+	_validEntries.Reserve(_entriesCount);
+	for (int _entryIndex = 0; _entryIndex < _entriesCount; _entryIndex++)
+	{
+		const FSplineMeshPlanEntry& _entry = _plan.entries[_entryIndex];
+		if (!IsValid(_mainLane.GetPlanComposition(_entry.compositionIndex).mesh)) continue;
+		if (_hasBridgeDecks && _inputs.bridgeRanges.ContainsByPredicate([&_entry](const FVector2D& _bridgeRange) { return _entry.startDistance < _bridgeRange.Y && _entry.startDistance + _entry.length > _bridgeRange.X; })) continue;
+		_validEntries.Add(_entryIndex);
 	}
 
-	// If the composition method is set to "Usual"
-	else if (compositionMethod == USUAL)
+	// Compute the segments in parallel, each one only writes its own slot
+	const int _firstSegment = _segments.Num();
+	_segments.SetNum(_firstSegment + _validEntries.Num());
+	ParallelForSegments(_validEntries.Num(), [&](const int _validIndex)
 	{
-		// Run through the meshes composition
-		const int _meshesCount = meshesComposition.Num();
-		for (int _meshIndex = 0; _meshIndex < _meshesCount; _meshIndex++)
-		{
-			// Get the current mesh composition
-			const FMeshComposition& _meshComposition = meshesComposition[_meshIndex];
-			if (!IsValid(_meshComposition.mesh)) continue;
+		// Get mesh composition values
+		const int _entryIndex = _validEntries[_validIndex];
+		const FSplineMeshPlanEntry& _entry = _plan.entries[_entryIndex];
+		const FMeshComposition& _meshComposition = _mainLane.GetPlanComposition(_entry.compositionIndex);
+		const float _scale = _meshComposition.scaleFactor;
 
-			// Get the lenght of a single mesh
-			const float _meshLength = _meshComposition.mesh->GetBoundingBox().GetSize().X * _meshComposition.scaleFactor;
+		// Compute start point value
+		const float _sectionLength = _entry.length;
+		const float _startDistance = _entry.startDistance;
+		FVector _startLocation = SplineLayoutAdapter::ToEngine(_samples.GetLocation(_entryIndex * 2));
+		const FVector& _clampedStartTangent = SplineLayoutAdapter::ToEngine(_samples.GetTangent(_entryIndex * 2).GetClampedToSize(0.0, _sectionLength));
 
-			// Check if the spline is full
-			if (_totalLength + _meshLength + gap > _splineLength) break;
+		// Compute end point value
+		const float _endDistance = _sectionLength + _startDistance;
+		FVector _endLocation = SplineLayoutAdapter::ToEngine(_samples.GetLocation(_entryIndex * 2 + 1));
+		const FVector& _clampedEndTangent = SplineLayoutAdapter::ToEngine(_samples.GetTangent(_entryIndex * 2 + 1).GetClampedToSize(0.0, _sectionLength));
 
-			// Add a mesh to the spline
-			_totalLength += _meshLength + gap;
-			_meshesCompositions.Add(_meshComposition);
-		}
-	}
+		// Lift the mesh above the ground
+		const FVector& _groundOffset = GetGroundOffset(_inputs, _meshComposition);
+		_startLocation += _groundOffset;
+		_endLocation += _groundOffset;
+		
+		// Write the segment
+		const FSplineMeshValues& _values = FSplineMeshValues(_startLocation, _clampedStartTangent, _endLocation, _clampedEndTangent, FVector2D(_scale), FVector2D(_scale));
+		_segments[_firstSegment + _validIndex] = FSplineMeshSegment(_meshComposition, _values, _entryIndex, _startDistance, _endDistance);
+	});
 
-	// If the composition method is set to "Random"
-	else
+	// Lay the decks in the gaps left by the bridges
+	if (_hasBridgeDecks) AddBridgeDecks(_inputs, _firstSegment, _segments);
+}
+FSplineMeshLane ADynamicSplineMeshActor::MakeMainLane() const
+{
+	FSplineMeshLane _lane = FSplineMeshLane();
+	_lane.compositionMethod = compositionMethod;
+	_lane.meshComposition = meshComposition;
+	_lane.meshesComposition = meshesComposition;
+	_lane.startCapComposition = startCapComposition;
+	_lane.endCapComposition = endCapComposition;
+	_lane.placementMethod = placementMethod;
+	_lane.gap = gap;
+	return _lane;
+}
+FSplineMeshPlan ADynamicSplineMeshActor::ComputePlan(const FSplineMeshLane& _lane, const float _splineLength, FRandomStream& _randomStream)
+{
+	// Init local values
+	FSplineMeshPlan _plan = FSplineMeshPlan();
+
+	// Add a mesh to the plan
+	const auto _addEntry = [&_plan](const int _compositionIndex, const double _startDistance, const double _meshLength)
 	{
-		// As long as the meshes can pass on the spline
-		while (true)
-		{
-			// Get the current mesh composition
-			const FMeshComposition& _meshComposition = GetRandomMeshComposition();
-			if (!IsValid(_meshComposition.mesh)) continue;
+		_plan.entries.Add(FSplineMeshPlanEntry(_compositionIndex, static_cast<float>(_startDistance), static_cast<float>(_meshLength)));
+	};
 
-			// Get the lenght of a single mesh
-			const float _meshLength = _meshComposition.mesh->GetBoundingBox().GetSize().X * _meshComposition.scaleFactor;
+	// Get the lenght of a mesh of the composition, negative when the mesh isn't set
+	const auto _getCompositionLength = [](const FMeshComposition& _meshComposition)
+	{
+		return IsValid(_meshComposition.mesh) ? _meshComposition.mesh->GetBoundingBox().GetSize().X * _meshComposition.scaleFactor : -1.0;
+	};
+	const TArray<FMeshComposition>& _meshesComposition = _lane.meshesComposition;
+	const auto _getLength = [&_meshesComposition, &_getCompositionLength](const int _meshIndex)
+	{
+		return _getCompositionLength(_meshesComposition[_meshIndex]);
+	};
 
-			// Check if the spline is full
-			if (_totalLength + _meshLength + gap > _splineLength) break;
+	// If the composition method is set to "Fill"
+	if (_lane.compositionMethod == FILL)
+	{
+		// Get the mesh that will compose the spline
+		const UStaticMesh* _mesh = _lane.meshComposition.mesh;
+		if (!IsValid(_mesh)) return _plan;
 
-			// Add a mesh to the spline
-			_totalLength += _meshLength + gap;
-			_meshesCompositions.Add(_meshComposition);
-		}
+		// Fill the spline with the mesh
+		const float _sectionLength = _mesh->GetBoundingBox().GetSize().X * _lane.meshComposition.scaleFactor;
+		SplineLayout::FillPlan(_sectionLength, _lane.gap, _splineLength, [&_addEntry](const double _startDistance, const double _meshLength)
+		{
+			_addEntry(INDEX_NONE, _startDistance, _meshLength);
+		});
 	}
 
-	// Run through the meshes composition
-	float _previousEnd = 0.0f;
-	const int _meshLengthCount = _meshesCompositions.Num();
-	for (int _meshCompositionIndex = 0; _meshCompositionIndex < _meshLengthCount; _meshCompositionIndex++)
+	// If the composition method is set to "Usual"
+	else if (_lane.compositionMethod == USUAL)
 	{
-		// Get mesh composition values
-		const FMeshComposition& _meshComposition = _meshesCompositions[_meshCompositionIndex];
-		const UStaticMesh* _staticMesh = _meshComposition.mesh;
-		if (!IsValid(_staticMesh)) continue;
-		const float _scale = _meshComposition.scaleFactor;
-
-		// Compute start point value
-		const float _sectionLength = _staticMesh->GetBoundingBox().GetSize().X * _scale;
-		const float _startDistance = _meshCompositionIndex > 0 ? _previousEnd + gap : 0.0f;
-		FVector _startLocation = spline->GetLocationAtDistanceAlongSpline(_startDistance, ESplineCoordinateSpace::Local);
-		const FVector& _startTangent = spline->GetTangentAtDistanceAlongSpline(_startDistance, ESplineCoordinateSpace::Local);
-		const FVector& _clampedStartTangent = _startTangent.GetClampedToSize(0.0f, _sectionLength);
-
-		// Compute end point value
-		const float _endDistance = _sectionLength + _startDistance;
-		_previousEnd = _endDistance;
-		FVector _endLocation = spline->GetLocationAtDistanceAlongSpline(_endDistance, ESplineCoordinateSpace::Local);
-		const FVector& _endTangent = spline->GetTangentAtDistanceAlongSpline(_endDistance, ESplineCoordinateSpace::Local);
-		const FVector& _clampedEndTangent = _endTangent.GetClampedToSize(0.0f, _sectionLength);
+		SplineLayout::SequencePlan(_meshesComposition.Num(), _lane.gap, _splineLength, _getLength, _addEntry);
+	}
 
-		if (snapOnGround)
+	// If the composition method is set to "Pattern"
+	else if (_lane.compositionMethod == PATTERN)
+	{
+		// Get the lenghts of each part of the pattern
+		const auto _getLengths = [&_getCompositionLength](const TArray<FMeshComposition>& _compositions)
 		{
-			// Get the lenght of a single mesh
-			const float _meshHeight = _meshComposition.mesh->GetBoundingBox().GetSize().Z * _meshComposition.scaleFactor;
-			
-			// Compute the mesh offset
-			const FVector& _meshOffset = GetActorUpVector() * (_meshHeight / 2.0f);
+			std::vector<double> _lengths = std::vector<double>();
+			_lengths.reserve(_compositions.Num());
+			for (const FMeshComposition& _meshComposition : _compositions)
+			{
+				_lengths.push_back(_getCompositionLength(_meshComposition));
+			}
+			return _lengths;
+		};
+
+		// The caps are indexed after the meshes composition, see FSplineMeshLane::GetPlanComposition
+		const int _meshesCount = _meshesComposition.Num();
+		const int _startCapCount = _lane.startCapComposition.Num();
+		SplineLayout::PatternPlan(_getLengths(_lane.startCapComposition), _getLengths(_meshesComposition), _getLengths(_lane.endCapComposition), _lane.gap, _splineLength,
+			[&_plan](const int _count) { _plan.entries.Reserve(_count); },
+			[&_addEntry, _meshesCount, _startCapCount](const SplineLayout::PatternPart _part, const int _index, const double _startDistance, const double _meshLength)
+			{
+				const int _compositionIndex = _part == SplineLayout::PatternPart::Pattern ? _index
+											: _part == SplineLayout::PatternPart::StartCap ? _meshesCount + _index
+											: _meshesCount + _startCapCount + _index;
+				_addEntry(_compositionIndex, _startDistance, _meshLength);
+			});
+	}
 
-			// Update start and end spline mesh locations
-			_startLocation += _meshOffset;
-			_endLocation += _meshOffset;
-		}
-		
-		// Add a new spline mesh
-		AddSplineMesh(_meshComposition, FSplineMeshValues(_startLocation, _clampedStartTangent, _endLocation, _clampedEndTangent, FVector2D(_scale), FVector2D(_scale)), _meshCompositionIndex);
+	// If the composition method is set to "Random"
+	else if (!_meshesComposition.IsEmpty())
+	{
+		const int _meshesCount = _meshesComposition.Num();
+		SplineLayout::RandomPlan(_meshesCount, _lane.gap, _splineLength, [&_randomStream, _meshesCount]() { return _randomStream.RandRange(0, _meshesCount - 1); }, _getLength, _addEntry);
 	}
+
+	return _plan;
 }
-void ADynamicSplineMeshActor::ExtendMesh()
+void ADynamicSplineMeshActor::ExtendMesh(const FSplineMeshLayoutInputs& _inputs, TArray<FSplineMeshSegment>& _segments)
 {
+	DSM_SCOPE_CYCLE_COUNTER(ExtendMesh);
+
 	// Run through the spline points 
-	const int32 _pointsCount = spline->GetNumberOfSplinePoints();
+	const SplineLayout::HermiteSpline& _hermiteSpline = _inputs.hermiteSpline;
+	const FSplineMeshLane& _mainLane = _inputs.mainLane;
+	const int32 _pointsCount = _hermiteSpline.GetPointCount();
 	for (int _splinePointIndex = 0; _splinePointIndex < _pointsCount - 1; _splinePointIndex++)
 	{
 		// Get the mesh composition according to the composition method
-		const FMeshComposition& _meshComposition = compositionMethod != FILL && meshesComposition.Num() > 0 ? meshesComposition[0] : meshComposition;
+		const FMeshComposition& _meshComposition = _mainLane.compositionMethod != FILL && _mainLane.meshesComposition.Num() > 0 ? _mainLane.meshesComposition[0] : _mainLane.meshComposition;
 		const UStaticMesh* _staticMesh = _meshComposition.mesh;
 		if (!IsValid(_staticMesh)) continue;
 		
 		// Compute the start point of the spline
-		FVector _startLocation = spline->GetLocationAtSplinePoint(_splinePointIndex, ESplineCoordinateSpace::Local);
-		const FVector& _startTangent = spline->GetTangentAtSplinePoint(_splinePointIndex, ESplineCoordinateSpace::Local);
+		const SplineLayout::SplinePoint& _startPoint = _hermiteSpline.GetPoint(_splinePointIndex);
+		FVector _startLocation = SplineLayoutAdapter::ToEngine(_startPoint.position);
+		const FVector& _startTangent = SplineLayoutAdapter::ToEngine(_startPoint.leaveTangent);
 
 		// Compute the end point of the spline
-		FVector _endLocation = spline->GetLocationAtSplinePoint(_splinePointIndex + 1, ESplineCoordinateSpace::Local);
-		const FVector& _endTangent = spline->GetTangentAtSplinePoint(_splinePointIndex + 1, ESplineCoordinateSpace::Local);
+		const SplineLayout::SplinePoint& _endPoint = _hermiteSpline.GetPoint(_splinePointIndex + 1);
+		FVector _endLocation = SplineLayoutAdapter::ToEngine(_endPoint.position);
+		const FVector& _endTangent = SplineLayoutAdapter::ToEngine(_endPoint.leaveTangent);
 
 		// Compute a new SplineMeshValue to be added as a spline mesh
 		const float _meshSizeX = _staticMesh->GetBoundingBox().GetSize().X;
-		const float _scale = FMath::Abs((_endLocation - _startLocation).Length() / _meshSizeX);
+		const float _scale = SplineLayout::GetExtendScale(_startPoint.position, _endPoint.position, _meshSizeX);
 
-		if (snapOnGround)
-		{
-			// Get the lenght of a single mesh
-			const float _meshHeight = _meshComposition.mesh->GetBoundingBox().GetSize().Z * _meshComposition.scaleFactor;
-			
-			// Compute the mesh offset
-			const FVector& _meshOffset = GetActorUpVector() * (_meshHeight / 2.0f);
-
-			// Update start and end spline mesh locations
-			_startLocation += _meshOffset;
-			_endLocation += _meshOffset;
-		}
+		// Lift the mesh above the ground
+		const FVector& _groundOffset = GetGroundOffset(_inputs, _meshComposition);
+		_startLocation += _groundOffset;
+		_endLocation += _groundOffset;
 		
-		AddSplineMesh(_meshComposition, FSplineMeshValues(_startLocation, _startTangent, _endLocation, _endTangent, FVector2D(_scale), FVector2D(_scale)), _splinePointIndex);
+		// Add a new segment
+		const FSplineMeshValues& _values = FSplineMeshValues(_startLocation, _startTangent, _endLocation, _endTangent, FVector2D(_scale), FVector2D(_scale));
+		const float _startDistance = _hermiteSpline.GetDistanceAtPoint(_splinePointIndex);
+		const float _endDistance = _hermiteSpline.GetDistanceAtPoint(_splinePointIndex + 1);
+		_segments.Add(FSplineMeshSegment(_meshComposition, _values, _splinePointIndex, _startDistance, _endDistance));
 	}
 }
-FMeshComposition ADynamicSplineMeshActor::GetRandomMeshComposition() const
-{
-	const int _randomIndex = FMath::RandRange(0, meshesComposition.Num() - 1);
-	return meshesComposition[_randomIndex];
-}
 void ADynamicSplineMeshActor::RandomizeSpline()
 {
+	CancelGenerate();
+
 	const int _splineMeshCount = splineMeshes.Num();
 	for	(int _splineMeshIndex = 0; _splineMeshIndex < _splineMeshCount; _splineMeshIndex++)
 	{
+		// The lanes have their own compositions
+		if (segments.IsValidIndex(_splineMeshIndex) && segments[_splineMeshIndex].lane != 0) continue;
+
 		const int _randomIndex = FMath::RandRange(0, meshesComposition.Num() - 1);
 		if (meshesComposition.Num() > _randomIndex)
 		{
 			splineMeshes[_splineMeshIndex]->SetStaticMesh(meshesComposition[_randomIndex].mesh);
+			if (segments.IsValidIndex(_splineMeshIndex)) segments[_splineMeshIndex].meshComposition = meshesComposition[_randomIndex];
 		}
 	}
 }
+void ADynamicSplineMeshActor::ComputeLanes(const FSplineMeshLayoutInputs& _inputs, FRandomStream& _randomStream, TArray<FSplineMeshSegment>& _segments)
+{
+	if (_inputs.lanes.IsEmpty()) return;
+	DSM_SCOPE_CYCLE_COUNTER(ComputeLanes);
+
+	// Sample the spline once for every lane
+	const SplineLayout::HermiteSpline& _hermiteSpline = _inputs.hermiteSpline;
+	SplineLayout::FrameTable _frameTable = SplineLayout::FrameTable();
+	_frameTable.Build(_hermiteSpline, _inputs.laneFrameSpacing, SplineLayout::Vector3(0.0, 0.0, 1.0));
+
+	// Run through the lanes, the lane 0 is the spline itself
+	const int _lanesCount = _inputs.lanes.Num();
+	for (int _laneIndex = 0; _laneIndex < _lanesCount; _laneIndex++)
+	{
+		const FSplineMeshLane& _lane = _inputs.lanes[_laneIndex];
+		if (_lane.placementMethod == EXTEND)
+		{
+			ExtendLane(_inputs, _lane, _laneIndex + 1, _frameTable, _segments);
+		}
+
+		else
+		{
+			DuplicateLane(_inputs, _lane, _laneIndex + 1, _frameTable, _randomStream, _segments);
+		}
+	}
+}
+void ADynamicSplineMeshActor::DuplicateLane(const FSplineMeshLayoutInputs& _inputs, const FSplineMeshLane& _lane, const int _laneIndex, const SplineLayout::FrameTable& _frameTable, FRandomStream& _randomStream, TArray<FSplineMeshSegment>& _segments)
+{
+	// Get the plan of the meshes of the lane, along the spline distances
+	const float _splineLength = static_cast<float>(_frameTable.GetLength());
+	const FSplineMeshPlan& _plan = ComputePlan(_lane, _splineLength, _randomStream);
+
+	// Keep the meshes of the plan that are set, each one gets its slot in the segments
+	const int _entriesCount = _plan.entries.Num();
+	TArray<int> _validEntries = TArray<int>();
+	_validEntries.Reserve(_entriesCount);
+	for (int _entryIndex = 0; _entryIndex < _entriesCount; _entryIndex++)
+	{
+		if (IsValid(_lane.GetPlanComposition(_plan.entries[_entryIndex].compositionIndex).mesh)) _validEntries.Add(_entryIndex);
+	}
+
+	// Compute the segments in parallel, each one only writes its own slot
+	const int _firstSegment = _segments.Num();
+	_segments.SetNum(_firstSegment + _validEntries.Num());
+	ParallelForSegments(_validEntries.Num(), [&](const int _validIndex)
+	{
+		// Get mesh composition values
+		const int _entryIndex = _validEntries[_validIndex];
+		const FSplineMeshPlanEntry& _entry = _plan.entries[_entryIndex];
+		const FMeshComposition& _meshComposition = _lane.GetPlanComposition(_entry.compositionIndex);
+		const float _scale = _meshComposition.scaleFactor;
+
+		// Read the frames at both ends of the mesh
+		const float _sectionLength = _entry.length;
+		const float _startDistance = _entry.startDistance;
+		const float _endDistance = _sectionLength + _startDistance;
+		const SplineLayout::SplineFrame& _startFrame = _frameTable.GetFrameAtDistance(_startDistance);
+		const SplineLayout::SplineFrame& _endFrame = _frameTable.GetFrameAtDistance(_endDistance);
+
+		// Offset the ends of the mesh from the spline
+		const FVector& _groundOffset = GetGroundOffset(_inputs, _meshComposition);
+		const FVector& _startLocation = SplineLayoutAdapter::ToEngine(_startFrame.GetOffsetLocation(_lane.lateralOffset, _lane.verticalOffset)) + _groundOffset;
+		const FVector& _endLocation = SplineLayoutAdapter::ToEngine(_endFrame.GetOffsetLocation(_lane.lateralOffset, _lane.verticalOffset)) + _groundOffset;
+		const FVector& _startTangent = SplineLayoutAdapter::ToEngine(_startFrame.tangent.GetClampedToSize(0.0, _sectionLength));
+		const FVector& _endTangent = SplineLayoutAdapter::ToEngine(_endFrame.tangent.GetClampedToSize(0.0, _sectionLength));
+
+		// Write the segment
+		const FSplineMeshValues& _values = FSplineMeshValues(_startLocation, _startTangent, _endLocation, _endTangent, FVector2D(_scale), FVector2D(_scale));
+		FSplineMeshSegment& _segment = _segments[_firstSegment + _validIndex];
+		_segment = FSplineMeshSegment(_meshComposition, _values, _entryIndex, _startDistance, _endDistance);
+		_segment.lane = _laneIndex;
+	});
+}
+void ADynamicSplineMeshActor::ExtendLane(const FSplineMeshLayoutInputs& _inputs, const FSplineMeshLane& _lane, const int _laneIndex, const SplineLayout::FrameTable& _frameTable, TArray<FSplineMeshSegment>& _segments)
+{
+	// Get the mesh composition according to the composition method
+	const FMeshComposition& _meshComposition = _lane.compositionMethod != FILL && _lane.meshesComposition.Num() > 0 ? _lane.meshesComposition[0] : _lane.meshComposition;
+	const UStaticMesh* _staticMesh = _meshComposition.mesh;
+	if (!IsValid(_staticMesh)) return;
+	const float _meshSizeX = _staticMesh->GetBoundingBox().GetSize().X;
+	const FVector& _groundOffset = GetGroundOffset(_inputs, _meshComposition);
+
+	// Run through the spline points
+	const SplineLayout::HermiteSpline& _hermiteSpline = _inputs.hermiteSpline;
+	const int32 _pointsCount = _hermiteSpline.GetPointCount();
+	for (int _splinePointIndex = 0; _splinePointIndex < _pointsCount - 1; _splinePointIndex++)
+	{
+		// Read the frames at both spline points
+		const float _startDistance = _hermiteSpline.GetDistanceAtPoint(_splinePointIndex);
+		const float _endDistance = _hermiteSpline.GetDistanceAtPoint(_splinePointIndex + 1);
+		const SplineLayout::SplineFrame& _startFrame = _frameTable.GetFrameAtDistance(_startDistance);
+		const SplineLayout::SplineFrame& _endFrame = _frameTable.GetFrameAtDistance(_endDistance);
+
+		// Stretch the mesh between the offset points
+		const SplineLayout::Vector3& _start = _startFrame.GetOffsetLocation(_lane.lateralOffset, _lane.verticalOffset);
+		const SplineLayout::Vector3& _end = _endFrame.GetOffsetLocation(_lane.lateralOffset, _lane.verticalOffset);
+		const float _scale = SplineLayout::GetExtendScale(_start, _end, _meshSizeX);
+
+		// Add a new segment
+		const FSplineMeshValues& _values = FSplineMeshValues(SplineLayoutAdapter::ToEngine(_start) + _groundOffset, SplineLayoutAdapter::ToEngine(_startFrame.tangent),
+															 SplineLayoutAdapter::ToEngine(_end) + _groundOffset, SplineLayoutAdapter::ToEngine(_endFrame.tangent), FVector2D(_scale), FVector2D(_scale));
+		FSplineMeshSegment& _segment = _segments.Add_GetRef(FSplineMeshSegment(_meshComposition, _values, _splinePointIndex, _startDistance, _endDistance));
+		_segment.lane = _laneIndex;
+	}
+}
+FVector ADynamicSplineMeshActor::GetGroundOffset(const FSplineMeshLayoutInputs& _inputs, const FMeshComposition& _meshComposition)
+{
+	if (_inputs.groundUp.IsZero() || !IsValid(_meshComposition.mesh)) return FVector::ZeroVector;
+
+	// Half of the height of the mesh, so it lies on the ground
+	const float _meshHeight = _meshComposition.mesh->GetBoundingBox().GetSize().Z * _meshComposition.scaleFactor;
+	return _inputs.groundUp * (_meshHeight / 2.0f);
+}
 
 #pragma endregion
 
 #pragma region Placement
 
-void ADynamicSplineMeshActor::AddSplineMesh(const FMeshComposition& _meshComposition, const FSplineMeshValues& _values, const int _index)
+USplineMeshComponent* ADynamicSplineMeshActor::CreateSplineMeshComponent(UStaticMesh* _mesh)
 {
-	USplineMeshComponent* _splineMesh = NewObject<USplineMeshComponent>(this, USplineMeshComponent::StaticClass());
-	if (!_splineMesh) return;
+	USplineMeshComponent* _splineMesh = NewObject<USplineMeshSegmentComponent>(this, USplineMeshSegmentComponent::StaticClass());
+	if (!_splineMesh) return nullptr;
+
+	// Keep the generated mesh out of the undo buffer, it is derived from the inputs of the actor
+	_splineMesh->ClearFlags(RF_Transactional);
 
 	// Apply mesh
-	if (IsValid(_meshComposition.mesh))
+	if (IsValid(_mesh))
 	{
-		_splineMesh->SetStaticMesh(_meshComposition.mesh);
+		_splineMesh->SetStaticMesh(_mesh);
 	}
 
 	_splineMesh->SetMobility(EComponentMobility::Movable);
 	_splineMesh->CreationMethod = EComponentCreationMethod::UserConstructionScript;
+	_splineMesh->SetCanEverAffectNavigation(false);
 	_splineMesh->RegisterComponentWithWorld(GetWorld());
 	_splineMesh->AttachToComponent(spline, FAttachmentTransformRules::KeepRelativeTransform);
 	_splineMesh->SetForwardAxis(ESplineMeshAxis::X);
 	_splineMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	DSM_INC_COUNTER(ComponentsCreated, 1);
+	buildStats.componentsCreated++;
+
+	return _splineMesh;
+}
+void ADynamicSplineMeshActor::AddSplineMesh(const FMeshComposition& _meshComposition, const FSplineMeshValues& _values)
+{
+	DSM_SCOPE_CYCLE_COUNTER(AddSplineMesh);
+
+	USplineMeshComponent* _splineMesh = CreateSplineMeshComponent(_meshComposition.mesh);
+	if (!_splineMesh) return;
 	
-	RotateSplineMesh(_splineMesh, _values, _index);
-	_splineMesh->SetStartScale(_values.startScale, true);
-	_splineMesh->SetEndScale(_values.endScale, true);
+	// The mesh is updated once by the last call
+	_splineMesh->SetStartRoll(_values.roll, false);
+	_splineMesh->SetEndRoll(_values.roll, false);
+	_splineMesh->SetStartScale(_values.startScale, false);
+	_splineMesh->SetEndScale(_values.endScale, false);
+	_splineMesh->SetStartAndEnd(_values.start, _values.startTangent, _values.end, _values.endTangent, true);
 	
 	splineMeshes.Add(_splineMesh);
 }
-void ADynamicSplineMeshActor::RotateSplineMesh(USplineMeshComponent* _splineMesh, const FSplineMeshValues& _values, const unsigned int _index) const
+FSplineMeshValues ADynamicSplineMeshActor::RotateSegment(const FSplineMeshValues& _values, const unsigned int _index) const
 {
+	FSplineMeshValues _rotatedValues = _values;
+
 	if (rotationMethod == NONE)
 	{
-		_splineMesh->SetStartAndEnd(_values.start, _values.startTangent, _values.end, _values.startTangent);
-		return;
+		_rotatedValues.endTangent = _values.startTangent;
+		return _rotatedValues;
 	}
 	
 	const FMeshRotation& _meshRotation = GetMeshRotation(_index);
 	
 	if (_meshRotation.axisRotation == ROTATE_X)
 	{
-		const float _angle = FMath::DegreesToRadians(_meshRotation.angle);
-		_splineMesh->SetStartRoll(_angle);
-		_splineMesh->SetEndRoll(_angle);
-		_splineMesh->SetStartAndEnd(_values.start, _values.startTangent, _values.end, _values.endTangent);
-		return;
+		_rotatedValues.roll = FMath::DegreesToRadians(_meshRotation.angle);
+		return _rotatedValues;
 	}
 
-	const float _size = (_values.end - _values.start).Size();
-	const FVector& _newEndLocation = _values.start + _size * GetRotatedVector(_meshRotation);
-	const float _xTangents = _newEndLocation.X - _values.start.X;
-	const FVector& _newTangentsLocation = _meshRotation.axisRotation == ROTATE_Y ? FVector(_xTangents, 0.0f, _newEndLocation.Z)
-																				  : FVector(_xTangents, _newEndLocation.Y, 0.0f);
-	
-	_splineMesh->SetStartAndEnd(_values.start, _newTangentsLocation, _newEndLocation, _newTangentsLocation);
+	const SplineLayout::RotatedSegment& _rotatedSegment = SplineLayout::RotateSegment(SplineLayoutAdapter::ToLayout(_values.start), SplineLayoutAdapter::ToLayout(_values.end),
+																					  SplineLayoutAdapter::ToLayout(_meshRotation.axisRotation), _meshRotation.angle);
+	_rotatedValues.end = SplineLayoutAdapter::ToEngine(_rotatedSegment.end);
+	_rotatedValues.startTangent = SplineLayoutAdapter::ToEngine(_rotatedSegment.tangent);
+	_rotatedValues.endTangent = _rotatedValues.startTangent;
+	return _rotatedValues;
 }
 
 #pragma endregion
@@ -516,9 +1925,12 @@ void ADynamicSplineMeshActor::SetRotationForAngle()
 
 void ADynamicSplineMeshActor::SnapOnGround()
 {
+	DSM_SCOPE_CYCLE_COUNTER(SnapOnGround);
+
 	if (!snapOnGround || groundLayer.IsEmpty()) return;
 		
 	TArray<FVector> _splinePoints = TArray<FVector>();
+	TArray<double> _distances = TArray<double>();
 	
 	if (checkGroundMethod == POINTS)
 	{
@@ -527,7 +1939,7 @@ void ADynamicSplineMeshActor::SnapOnGround()
 
 		for (int _splinePointIndex = 0; _splinePointIndex <= _pointsCount; _splinePointIndex++)
 		{
-			CheckGround(_splinePoints, _splinePointIndex * _gap, checkGroundDepth);
+			_distances.Add(_splinePointIndex * _gap);
 		}
 	}
 
@@ -536,11 +1948,19 @@ void ADynamicSplineMeshActor::SnapOnGround()
 		float _distance = 0.0f;
 		while (_distance <= lenght)
 		{
-			CheckGround(_splinePoints, _distance, checkGroundDepth);
+			_distances.Add(_distance);
 			_distance += checkGroundSpacing;
 		}
 	}
 
+	// Evaluate the samples in one batch before tracing them
+	const TArray<FVector>& _sampleLocations = GetWorldLocationsAtDistances(_distances);
+	for (const FVector& _sampleLocation : _sampleLocations)
+	{
+		CheckGround(_splinePoints, _sampleLocation, checkGroundDepth);
+		buildStats.snapTraces++;
+	}
+
 	spline->ClearSplinePoints();
 		
 	const int _splinePointsCount = _splinePoints.Num();
@@ -550,19 +1970,55 @@ void ADynamicSplineMeshActor::SnapOnGround()
 		spline->SetSplinePointType(_splinePointIndex, splinePointType);
 	}
 }
-void ADynamicSplineMeshActor::CheckGround(TArray<FVector>& _splinePoints, float _distance, float _depth)
+TArray<FVector> ADynamicSplineMeshActor::GetWorldLocationsAtDistances(const TArray<double>& _distances) const
+{
+	const SplineLayout::HermiteSpline& _hermiteSpline = SplineLayoutAdapter::MakeHermiteSpline(spline);
+	SplineLayout::SplineSamples _samples = SplineLayout::SplineSamples();
+	SplineLayout::BatchEvaluator(_hermiteSpline).EvaluateDistances(_distances.GetData(), _distances.Num(), _samples);
+
+	const FTransform& _splineTransform = spline->GetComponentTransform();
+	TArray<FVector> _locations = TArray<FVector>();
+	_locations.SetNumUninitialized(_distances.Num());
+	for (int _index = 0; _index < _distances.Num(); _index++)
+	{
+		_locations[_index] = _splineTransform.TransformPosition(SplineLayoutAdapter::ToEngine(_samples.GetLocation(_index)));
+	}
+
+	return _locations;
+}
+void ADynamicSplineMeshActor::CheckGround(TArray<FVector>& _splinePoints, const FVector& _splinePointLocation, float _depth)
 {
+	DSM_SCOPE_CYCLE_COUNTER(CheckGround);
+
 	FHitResult _hitResult = FHitResult();
-	const FVector& _splinePointLocation = spline->GetWorldLocationAtDistanceAlongSpline(_distance);
 	const FVector& _startLocation = _splinePointLocation + FVector::UpVector * zGroundCheckOffset;
 	const FVector& _endLocation = _startLocation + FVector::DownVector * _depth;
-	const bool _hasHit = UKismetSystemLibrary::LineTraceSingleForObjects(GetWorld(), _startLocation, _endLocation, groundLayer, false, TArray<AActor*>(), EDrawDebugTrace::None, _hitResult, true);
+
+	// Ignore the spline itself, its previous collision chunks are kept until the new layout is applied
+	const TArray<AActor*> _ignoredActors = { this };
+	const bool _hasHit = UKismetSystemLibrary::LineTraceSingleForObjects(GetWorld(), _startLocation, _endLocation, groundLayer, false, _ignoredActors, EDrawDebugTrace::None, _hitResult, true);
+	DSM_INC_COUNTER(GroundTraces, 1);
 
 	if (_hasHit)
 	{
 		_splinePoints.Add(_hitResult.ImpactPoint);
 	}
 }
+bool ADynamicSplineMeshActor::TraceGroundNormal(const FVector& _location, FVector& _normal) const
+{
+	DSM_SCOPE_CYCLE_COUNTER(CheckGround);
+
+	// Ignore the spline itself, its collision chunks are not the ground
+	FHitResult _hitResult = FHitResult();
+	const FVector& _startLocation = _location + FVector::UpVector * zGroundCheckOffset;
+	const FVector& _endLocation = _startLocation + FVector::DownVector * checkGroundDepth;
+	FCollisionQueryParams _queryParams = FCollisionQueryParams(SCENE_QUERY_STAT(DynamicSplineMeshScatterGround), true, this);
+	const bool _hasHit = GetWorld()->LineTraceSingleByObjectType(_hitResult, _startLocation, _endLocation, FCollisionObjectQueryParams(groundLayer), _queryParams);
+	DSM_INC_COUNTER(GroundTraces, 1);
+
+	if (_hasHit) _normal = _hitResult.ImpactNormal;
+	return _hasHit;
+}
 
 #pragma endregion
 
@@ -570,46 +2026,44 @@ void ADynamicSplineMeshActor::CheckGround(TArray<FVector>& _splinePoints, float
 
 void ADynamicSplineMeshActor::MakeBridge()
 {
+	DSM_SCOPE_CYCLE_COUNTER(MakeBridge);
+
+	bridgeRanges.Empty();
 	if (!isBridge) return;
 	
 	const int _pointsCount = checkGroundPointsCount;
 	const float _gap = lenght / _pointsCount;
 	TArray<FVector> _splinePoints = TArray<FVector>();
 	
+	TArray<double> _distances = TArray<double>();
 	for (int _splinePointIndex = 0; _splinePointIndex <= _pointsCount; _splinePointIndex++)
 	{
-		CheckGround(_splinePoints, _splinePointIndex * _gap, bridgeDepth);
+		_distances.Add(_splinePointIndex * _gap);
 	}
 
-	const int _splinePointsCount = _splinePoints.Num();
-	FVector _previousSplinePoint = FVector();
-	TArray<FBridge> _bridges = TArray<FBridge>();
-	FVector _startLocation = FVector();
-	bool _hasStarted = false;
-	
-	for	(int _splinePointIndex = 0; _splinePointIndex < _splinePointsCount; _splinePointIndex++)
+	const TArray<FVector>& _sampleLocations = GetWorldLocationsAtDistances(_distances);
+	for (const FVector& _sampleLocation : _sampleLocations)
 	{
-		const FVector& _currentSplinePoint = _splinePoints[_splinePointIndex];
-
-		if (_splinePointIndex >= 1 && _currentSplinePoint.Z != _previousSplinePoint.Z)
-		{
-			if (!_hasStarted)
-			{
-				_startLocation = FVector(_currentSplinePoint.X - _gap, _currentSplinePoint.Y, _previousSplinePoint.Z);
-				_hasStarted = true;
-			}
-			
-			else
-			{
-				_bridges.Add(FBridge(_startLocation, _currentSplinePoint));
-				_hasStarted = false;
-			}
-		}
+		CheckGround(_splinePoints, _sampleLocation, bridgeDepth);
+		buildStats.bridgeTraces++;
+	}
 
-		_previousSplinePoint = _currentSplinePoint;
+	// Find the bridges along the ground samples
+	TArray<FBridge> _bridges = TArray<FBridge>();
+	TArray<SplineLayout::Vector3> _groundPoints = TArray<SplineLayout::Vector3>();
+	_groundPoints.Reserve(_splinePoints.Num());
+	for (const FVector& _splinePoint : _splinePoints)
+	{
+		_groundPoints.Add(SplineLayoutAdapter::ToLayout(_splinePoint));
 	}
 
-	const int _bridgesCount = _bridges.Num();
+	SplineLayout::DetectBridges(_groundPoints.GetData(), _groundPoints.Num(), _gap, [&_bridges](const SplineLayout::Bridge& _bridge)
+	{
+		_bridges.Add(FBridge(SplineLayoutAdapter::ToEngine(_bridge.start), SplineLayoutAdapter::ToEngine(_bridge.end)));
+	});
+
+	// The decks follow their own profile, the spline stays straight across the bridges
+	const int _bridgesCount = HasBridgeDecks() ? 0 : _bridges.Num();
 	for	(int _bridgeIndex = 0; _bridgeIndex < _bridgesCount; _bridgeIndex++)
 	{
 		const FBridge& _bridge = _bridges[_bridgeIndex];
@@ -620,6 +2074,228 @@ void ADynamicSplineMeshActor::MakeBridge()
 		spline->AddSplinePointAtIndex(_middleLocation, _inputKey, ESplineCoordinateSpace::World);
 		spline->SetSplinePointType(_inputKey, ESplinePointType::Curve);
 	}
+
+	// Register the distances of the bridges once all their points are added
+	for (const FBridge& _bridge : _bridges)
+	{
+		const float _startDistance = spline->GetDistanceAlongSplineAtSplineInputKey(spline->FindInputKeyClosestToWorldLocation(_bridge.startLocation));
+		const float _endDistance = spline->GetDistanceAlongSplineAtSplineInputKey(spline->FindInputKeyClosestToWorldLocation(_bridge.endLocation));
+		bridgeRanges.Add(FVector2D(FMath::Min(_startDistance, _endDistance), FMath::Max(_startDistance, _endDistance)));
+	}
+}
+const FMeshComposition& ADynamicSplineMeshActor::GetDeckComposition() const
+{
+	return IsValid(bridgeDeckComposition.mesh) ? bridgeDeckComposition : meshComposition;
+}
+bool ADynamicSplineMeshActor::HasBridgeDecks() const
+{
+	// The extended meshes can't be cut in planks, they keep the middle point
+	return isBridge && bridgeMethod != MIDDLE_POINT && placementMethod == DUPLICATE && IsValid(GetDeckComposition().mesh);
+}
+void ADynamicSplineMeshActor::AddBridgeDecks(const FSplineMeshLayoutInputs& _inputs, const int _firstSegment, TArray<FSplineMeshSegment>& _segments)
+{
+	DSM_SCOPE_CYCLE_COUNTER(AddBridgeDecks);
+
+	// Init local values
+	const SplineLayout::HermiteSpline& _hermiteSpline = _inputs.hermiteSpline;
+	const FMeshComposition& _deckComposition = _inputs.deckComposition;
+	const float _scale = _deckComposition.scaleFactor;
+	const double _plankLength = _deckComposition.mesh->GetBoundingBox().GetSize().X * _scale;
+	const FVector& _groundOffset = GetGroundOffset(_inputs, _deckComposition);
+	const SplineLayout::Vector3& _deckUp = SplineLayoutAdapter::ToLayout(_inputs.deckUp);
+
+	for (const FVector2D& _bridgeRange : _inputs.bridgeRanges)
+	{
+		// Tabulate the profile of the deck once, between the ends of the bridge on the spline
+		SplineLayout::BridgeSpan _span = SplineLayout::BridgeSpan();
+		_span.Build(_hermiteSpline.GetLocationAtDistance(_bridgeRange.X), _hermiteSpline.GetLocationAtDistance(_bridgeRange.Y), _deckUp, _inputs.sag, _inputs.sagProfile, _inputs.supportSpacing);
+
+		// Place the planks straight from the table, the distances along the spline are spread over the bridge
+		const double _distanceRatio = _span.GetLength() > 0.0 ? (_bridgeRange.Y - _bridgeRange.X) / _span.GetLength() : 0.0;
+		SplineLayout::PlaceDeck(_span, _plankLength, _inputs.mainLane.gap, [&](const double _startDeckDistance, const double _endDeckDistance)
+		{
+			const double _sectionLength = _endDeckDistance - _startDeckDistance;
+			SplineLayout::Vector3 _start = SplineLayout::Vector3(), _startDirection = SplineLayout::Vector3();
+			SplineLayout::Vector3 _end = SplineLayout::Vector3(), _endDirection = SplineLayout::Vector3();
+			_span.GetAtDistance(_startDeckDistance, _start, _startDirection);
+			_span.GetAtDistance(_endDeckDistance, _end, _endDirection);
+
+			const FSplineMeshValues& _values = FSplineMeshValues(SplineLayoutAdapter::ToEngine(_start) + _groundOffset, SplineLayoutAdapter::ToEngine(_startDirection * _sectionLength),
+																 SplineLayoutAdapter::ToEngine(_end) + _groundOffset, SplineLayoutAdapter::ToEngine(_endDirection * _sectionLength), FVector2D(_scale), FVector2D(_scale));
+			const float _startDistance = static_cast<float>(_bridgeRange.X + _startDeckDistance * _distanceRatio);
+			const float _endDistance = static_cast<float>(_bridgeRange.X + _endDeckDistance * _distanceRatio);
+			_segments.Add(FSplineMeshSegment(_deckComposition, _values, 0, _startDistance, _endDistance));
+		});
+	}
+
+	// Put the planks back in order along the spline, the rotations use the index of the segments
+	const int _segmentsCount = _segments.Num() - _firstSegment;
+	TArrayView<FSplineMeshSegment> _splineSegments = MakeArrayView(_segments.GetData() + _firstSegment, _segmentsCount);
+	Algo::StableSortBy(_splineSegments, &FSplineMeshSegment::startDistance);
+	for (int _segmentIndex = 0; _segmentIndex < _segmentsCount; _segmentIndex++)
+	{
+		_splineSegments[_segmentIndex].index = _segmentIndex;
+	}
+}
+
+#pragma endregion
+
+#pragma region LOD
+
+void ADynamicSplineMeshActor::BuildLOD()
+{
+	// Run through the spline meshes to set their cull distance
+	const int _splineMeshCount = splineMeshes.Num();
+	for (int _splineMeshIndex = 0; _splineMeshIndex < _splineMeshCount; _splineMeshIndex++)
+	{
+		USplineMeshComponent* _splineMesh = splineMeshes[_splineMeshIndex];
+		if (!IsValid(_splineMesh)) continue;
+		_splineMesh->UpdateBounds();
+		SetAutoCullDistance(_splineMesh);
+	}
+
+	// Tick only when the levels of detail are used
+	const bool _hasLOD = useLOD && !lods.IsEmpty() && _splineMeshCount > 0;
+	SetActorTickInterval(lodUpdateRate);
+	SetActorTickEnabled(_hasLOD);
+	if (!_hasLOD) return;
+
+	// Split the spline meshes in chunks, a chunk never spans two lanes
+	const auto _getLane = [this](const int _splineMeshIndex) { return segments.IsValidIndex(_splineMeshIndex) ? segments[_splineMeshIndex].lane : 0; };
+	for (int _firstIndex = 0; _firstIndex < _splineMeshCount; )
+	{
+		int _count = 1;
+		while (_count < lodChunkSize && _firstIndex + _count < _splineMeshCount && _getLane(_firstIndex + _count) == _getLane(_firstIndex)) _count++;
+		FSplineMeshLODChunk _chunk = FSplineMeshLODChunk(_firstIndex, _count);
+		_firstIndex += _count;
+
+		// Compute the bounds of the chunk from its meshes
+		for (int _splineMeshIndex = _chunk.firstIndex; _splineMeshIndex < _chunk.firstIndex + _chunk.count; _splineMeshIndex++)
+		{
+			const USplineMeshComponent* _splineMesh = splineMeshes[_splineMeshIndex];
+			if (!IsValid(_splineMesh)) continue;
+			_chunk.bounds += _splineMesh->Bounds.GetBox();
+		}
+
+		lodChunks.Add(_chunk);
+	}
+
+	// Apply the current levels of detail
+	UpdateLOD();
+}
+void ADynamicSplineMeshActor::UpdateLOD()
+{
+	const UWorld* _world = GetWorld();
+	if (!_world || lodChunks.IsEmpty()) return;
+
+	// Get the locations of the cameras
+	const TArray<FVector>& _viewLocations = _world->ViewLocationsRenderedLastFrame;
+	if (_viewLocations.IsEmpty()) return;
+
+	// Run through the chunks
+	const int _lodChunkCount = lodChunks.Num();
+	for (int _lodChunkIndex = 0; _lodChunkIndex < _lodChunkCount; _lodChunkIndex++)
+	{
+		FSplineMeshLODChunk& _chunk = lodChunks[_lodChunkIndex];
+
+		// Get the distance to the closest camera
+		double _squaredDistance = TNumericLimits<double>::Max();
+		for (const FVector& _viewLocation : _viewLocations)
+		{
+			_squaredDistance = FMath::Min(_squaredDistance, _chunk.bounds.ComputeSquaredDistanceToPoint(_viewLocation));
+		}
+
+		// Update the chunk only if its level has changed
+		const int _level = GetLODLevel(FMath::Sqrt(_squaredDistance));
+		if (_level == _chunk.currentLevel) continue;
+		ApplyLOD(_chunk, _level);
+	}
+}
+int ADynamicSplineMeshActor::GetLODLevel(const float _distance) const
+{
+	// Get the farthest level of detail reached
+	int _level = 0;
+	float _levelDistance = 0.0f;
+	const int _lodCount = lods.Num();
+	for (int _lodIndex = 0; _lodIndex < _lodCount; _lodIndex++)
+	{
+		const float _lodDistance = lods[_lodIndex].distance;
+		if (_distance < _lodDistance || _lodDistance < _levelDistance) continue;
+
+		_level = _lodIndex + 1;
+		_levelDistance = _lodDistance;
+	}
+
+	return _level;
+}
+void ADynamicSplineMeshActor::ApplyLOD(FSplineMeshLODChunk& _chunk, const int _level)
+{
+	const FSplineMeshLOD* _lod = _level > 0 ? &lods[_level - 1] : nullptr;
+	const int _lastIndex = _chunk.firstIndex + _chunk.count - 1;
+	const USplineMeshComponent* _firstSplineMesh = splineMeshes[_chunk.firstIndex];
+	const USplineMeshComponent* _lastSplineMesh = splineMeshes[_lastIndex];
+
+	// Merge the chunk only if its ends can be stretched over, else keep its spline meshes visible
+	bool _isMerged = _lod && _lod->mergeSegments && IsValid(_firstSplineMesh) && IsValid(_lastSplineMesh);
+
+	// Get the mesh of the merged chunk
+	const FMeshComposition& _mergedComposition = segments[_chunk.firstIndex].meshComposition;
+	UStaticMesh* _mesh = _lod && _lod->useLODMesh && IsValid(_mergedComposition.lodMesh) ? _mergedComposition.lodMesh : _mergedComposition.mesh;
+
+	// Create the merged mesh the first time the chunk is merged
+	if (_isMerged && !_chunk.mergedMesh) _chunk.mergedMesh = CreateSplineMeshComponent(_mesh);
+	_isMerged = _isMerged && _chunk.mergedMesh;
+
+	// Run through the spline meshes of the chunk
+	for (int _splineMeshIndex = _chunk.firstIndex; _splineMeshIndex <= _lastIndex; _splineMeshIndex++)
+	{
+		USplineMeshComponent* _splineMesh = splineMeshes[_splineMeshIndex];
+		if (!IsValid(_splineMesh)) continue;
+
+		// Hide the spline mesh if the chunk is merged
+		_splineMesh->SetVisibility(!_isMerged);
+		if (_isMerged) continue;
+
+		// Swap to the LOD mesh if it is set
+		const FMeshComposition& _meshComposition = segments[_splineMeshIndex].meshComposition;
+		const bool _useLODMesh = _lod && _lod->useLODMesh && IsValid(_meshComposition.lodMesh);
+		_splineMesh->SetStaticMesh(_useLODMesh ? _meshComposition.lodMesh : _meshComposition.mesh);
+	}
+
+	// Hide the merged mesh if the chunk isn't merged
+	if (!_isMerged)
+	{
+		if (_chunk.mergedMesh) _chunk.mergedMesh->SetVisibility(false);
+		_chunk.currentLevel = _level;
+		return;
+	}
+
+	// Stretch the merged mesh from the start of the first mesh to the end of the last one
+	const FVector& _startLocation = _firstSplineMesh->GetStartPosition();
+	const FVector& _endLocation = _lastSplineMesh->GetEndPosition();
+	const float _length = (_endLocation - _startLocation).Size();
+	const FVector& _startTangent = _firstSplineMesh->GetStartTangent().GetSafeNormal() * _length;
+	const FVector& _endTangent = _lastSplineMesh->GetEndTangent().GetSafeNormal() * _length;
+
+	USplineMeshComponent* _mergedMesh = _chunk.mergedMesh;
+	_mergedMesh->SetStaticMesh(_mesh);
+	_mergedMesh->SetStartRoll(_firstSplineMesh->GetStartRoll(), false);
+	_mergedMesh->SetEndRoll(_lastSplineMesh->GetEndRoll(), false);
+	_mergedMesh->SetStartScale(_firstSplineMesh->GetStartScale(), false);
+	_mergedMesh->SetEndScale(_lastSplineMesh->GetEndScale(), false);
+	_mergedMesh->SetStartAndEnd(_startLocation, _startTangent, _endLocation, _endTangent, true);
+	_mergedMesh->SetVisibility(true);
+	_mergedMesh->UpdateBounds();
+	SetAutoCullDistance(_mergedMesh);
+
+	_chunk.currentLevel = _level;
+}
+void ADynamicSplineMeshActor::SetAutoCullDistance(USplineMeshComponent* _splineMesh) const
+{
+	if (!autoCullDistance || !IsValid(_splineMesh)) return;
+
+	// Cull the mesh once it is small enough on the screen
+	_splineMesh->SetCullDistance(_splineMesh->Bounds.SphereRadius * cullDistanceScale);
 }
 
 #pragma endregion
\ No newline at end of file
@@ -17,6 +17,8 @@
 #include "ENUM_PlacementMethod.h"
 #include "ENUM_RotationMethod.h"
 #include "ENUM_CheckGroundMethod.h"
+#include "ENUM_SplineCollisionMode.h"
+#include "ENUM_BridgeMethod.h"
 
 #pragma endregion
 
@@ -27,14 +29,35 @@
 #include "STRUCT_AngleMeshRotation.h"
 #include "STRUCT_GroupMeshRotation.h"
 #include "STRUCT_SplineMeshValues.h"
+#include "STRUCT_SplineMeshSegment.h"
+#include "STRUCT_SplineMeshLOD.h"
+#include "STRUCT_SplineScatterLayer.h"
+#include "STRUCT_SplineMeshLane.h"
+#include "STRUCT_SplineNetDefinition.h"
+#include "STRUCT_SplineMeshGenerateSettings.h"
+#include "STRUCT_SplineMeshGenerateResult.h"
 
 #pragma endregion
 
 #pragma endregion 
 
+#include "SplineMeshPlan.h"
+#include "SplineMeshLayoutCache.h"
+#include "SplineMeshLayoutInputs.h"
+#include "SplineMeshSpatialIndex.h"
+#include "SplineMeshCollisionComponent.h"
+#include "SplineLayoutAdapter.h"
+#include "DynamicSplineMeshStats.h"
+#include "Async/Future.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Containers/Ticker.h"
+#include "Tasks/Task.h"
+#include "Engine/CollisionProfile.h"
 #include "GameFramework/Actor.h"
 #include "DynamicSplineMeshActor.generated.h"
 
+class UHLODBuilder;
+
 USTRUCT()
 struct FBridge
 {
@@ -62,6 +85,76 @@ struct FBridge
 	}
 };
 
+USTRUCT()
+struct FSplineMeshLODChunk
+{
+	GENERATED_BODY()
+
+	/* Index of the first spline mesh of the chunk */
+	UPROPERTY()
+		int firstIndex = 0;
+
+	/* Number of spline meshes in the chunk */
+	UPROPERTY()
+		int count = 0;
+
+	/* Level of detail currently applied, 0 is the full detail */
+	UPROPERTY()
+		int currentLevel = 0;
+
+	/* World bounds of the chunk */
+	UPROPERTY()
+		FBox bounds = FBox(ForceInit);
+
+	/* Stretched mesh replacing the chunk when it is merged */
+	UPROPERTY()
+		USplineMeshComponent* mergedMesh = nullptr;
+
+	FSplineMeshLODChunk() { }
+	FSplineMeshLODChunk(const int _firstIndex, const int _count)
+	{
+		firstIndex = _firstIndex;
+		count = _count;
+	}
+};
+
+/* Called with the fraction of the spline meshes created by an async generation */
+DECLARE_DELEGATE_OneParam(FOnSplineMeshGenerateProgress, float);
+
+/* Called with a spline actor each time its spline meshes are created */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSplineMeshLayoutApplied, class ADynamicSplineMeshActor*);
+
+/* State of an async generation of the spline meshes */
+struct FSplineMeshGeneration
+{
+	FSplineMeshGenerateSettings settings = FSplineMeshGenerateSettings();
+
+	/* Called each time a slice of spline meshes is created */
+	FOnSplineMeshGenerateProgress onProgress = FOnSplineMeshGenerateProgress();
+
+	/* Set once the generation is completed or cancelled */
+	TPromise<FSplineMeshGenerateResult> promise;
+
+	/* Task computing the segments on a worker */
+	UE::Tasks::FTask layoutTask = UE::Tasks::FTask();
+
+	/* Ticker creating the spline meshes, a slice per frame */
+	FTSTicker::FDelegateHandle tickerHandle = FTSTicker::FDelegateHandle();
+
+	/* Index of the next segment whose spline mesh is created */
+	int nextSegment = 0;
+
+	/* Whether the segments computed by the task are moved into the layout */
+	bool layoutTaken = false;
+
+	/* The definition sent to the clients once the layout is created */
+	FSplineNetDefinition netDefinition = FSplineNetDefinition();
+	bool sendLayout = false;
+
+	/* Platform time of the start of the generation */
+	double startTime = 0.0;
+};
+
 UCLASS()
 class DYNAMICSPLINEMESH_API ADynamicSplineMeshActor : public AActor
 {
@@ -109,6 +202,32 @@ class DYNAMICSPLINEMESH_API ADynamicSplineMeshActor : public AActor
 
 	#pragma endregion
 
+	#pragma region Preview
+
+	/*
+	 * Draw a cheap preview while the spline or the actor is dragged in the editor
+	 * The full rebuild runs once the mouse is released
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Preview")
+		bool usePreview = true;
+
+	/*
+	 * Maximum number of boxes drawn by the preview
+	 * Bounds the preview cost whatever the spline lenght
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Preview", meta = (ClampMin = "1", ClampMax = "1024", EditCondition = "usePreview", EditConditionHides))
+		int previewBoxCount = 64;
+
+	/* Rate used to refresh the preview while the mouse is held */
+	UPROPERTY(EditAnywhere, Category = "Spline | Preview", meta = (ClampMin = "0.01", ClampMax = "1.0", EditCondition = "usePreview", EditConditionHides))
+		float previewRate = 0.1f;
+
+	/* Color of the preview boxes */
+	UPROPERTY(EditAnywhere, Category = "Spline | Preview", meta = (EditCondition = "usePreview", EditConditionHides))
+		FColor previewColor = FColor::Cyan;
+
+	#pragma endregion
+
 	#pragma region Composition
 
 	/*
@@ -136,11 +255,33 @@ class DYNAMICSPLINEMESH_API ADynamicSplineMeshActor : public AActor
 	
 	/*
 	 * The array of meshes composition used for the spline mesh
-	 * Is active only when the composition method is set to "USUAL" or "RANDOM"
+	 * Is active only when the composition method is set to "USUAL", "RANDOM" or "PATTERN"
+	 * The pattern repeats the whole array until the spline is full
 	 */
-	UPROPERTY(EditAnywhere, Category = "Spline | Composition", meta = (EditCondition = "compositionMethod == ECompositionMethod::USUAL || compositionMethod == ECompositionMethod::RANDOM", EditConditionHides))
+	UPROPERTY(EditAnywhere, Category = "Spline | Composition", meta = (EditCondition = "compositionMethod != ECompositionMethod::FILL", EditConditionHides))
 		TArray<FMeshComposition> meshesComposition = TArray<FMeshComposition>();
 
+	/*
+	 * The meshes placed once at the start of the spline, before the pattern
+	 * Is active only when the composition method is set to "PATTERN"
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Composition", meta = (EditCondition = "compositionMethod == ECompositionMethod::PATTERN", EditConditionHides))
+		TArray<FMeshComposition> startCapComposition = TArray<FMeshComposition>();
+
+	/*
+	 * The meshes placed once after the pattern, only when they all fit
+	 * Is active only when the composition method is set to "PATTERN"
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Composition", meta = (EditCondition = "compositionMethod == ECompositionMethod::PATTERN", EditConditionHides))
+		TArray<FMeshComposition> endCapComposition = TArray<FMeshComposition>();
+
+	/*
+	 * Seed of the random composition
+	 * The same seed gives the same meshes on every machine
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Composition", meta = (EditCondition = "compositionMethod == ECompositionMethod::RANDOM", EditConditionHides))
+		int seed = 0;
+
 	#pragma endregion
 
 	#pragma region Placement
@@ -156,10 +297,54 @@ class DYNAMICSPLINEMESH_API ADynamicSplineMeshActor : public AActor
 	UPROPERTY(EditAnywhere, Category = "Spline | Placement", meta = (EditCondition = "placementMethod == EPlacementMethod::DUPLICATE", EditConditionHides))
 		float gap = 0.0f;
 
-	/* The array of the meshes currently set on the spline */
-	UPROPERTY(/*VisibleAnywhere, Category = "Spline | Placement"*/)
+	/*
+	 * The array of the meshes currently set on the spline
+	 * Derived from the inputs, kept out of the undo buffer and regenerated on undo
+	 */
+	UPROPERTY(NonTransactional/*, VisibleAnywhere, Category = "Spline | Placement"*/)
 		TArray<USplineMeshComponent*> splineMeshes = TArray<USplineMeshComponent*>();
 
+	/*
+	 * The layout of the spline, one segment per spline mesh in the same order
+	 * Saved with the actor to restore the spline meshes without computing the layout
+	 */
+	UPROPERTY(NonTransactional)
+		TArray<FSplineMeshSegment> segments = TArray<FSplineMeshSegment>();
+
+	/*
+	 * Hash of every input of the layout when it was computed
+	 * The saved layout is restored when the inputs still match it
+	 */
+	UPROPERTY(NonTransactional)
+		uint64 layoutHash = 0;
+
+	/* Copy of the inputs of the next layout, taken on the game thread */
+	FSplineMeshLayoutInputs layoutInputs = FSplineMeshLayoutInputs();
+
+	/* The segments computed from the copied inputs, moved into the layout on the game thread */
+	TArray<FSplineMeshSegment> computedSegments = TArray<FSplineMeshSegment>();
+
+	/* Time spent to compute the segments, in seconds */
+	double computedLayoutTime = 0.0;
+
+	#pragma endregion
+
+	#pragma region Lanes
+
+	/*
+	 * Meshes placed at an offset of the spline, each lane with its own composition and placement
+	 * All the lanes read one table of frames and the ground profile of the spline
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Lanes")
+		TArray<FSplineMeshLane> lanes = TArray<FSplineMeshLane>();
+
+	/*
+	 * Distance between two frames of the table read by the lanes
+	 * Lower values follow the curves closer and cost more spline evaluations
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Lanes", meta = (ClampMin = "1.0", ClampMax = "1000.0"))
+		float laneFrameSpacing = 25.0f;
+
 	#pragma endregion
 
 	#pragma region Rotation
@@ -229,25 +414,375 @@ class DYNAMICSPLINEMESH_API ADynamicSplineMeshActor : public AActor
 	UPROPERTY(EditAnywhere, Category = "Spline | Bridge")
 		bool isBridge = false;
 
+	/* Lower the middle of the bridges by the tension instead of raising it, the decks sag instead of making an arch */
 	UPROPERTY(EditAnywhere, Category = "Spline | Bridge")
 		bool reverseTension = false;
 	
+	/*
+	 * Height of the middle of the bridges above the line between their ends, the same for every bridge method
+	 * Raises the middle point or makes each bay of the decks an arch, lowers them when the tension is reversed
+	 */
 	UPROPERTY(EditAnywhere, Category = "Spline | Bridge", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
 		float tension = 0.0f;
 
 	UPROPERTY(EditAnywhere, Category = "Spline | Bridge", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
 		float bridgeDepth = 0.0f;
 
+	/*
+	 * How the bridges bend between their ends
+	 * The middle point bends the spline itself, the catenary and the parabola lay a deck of planks along an exact profile bent by the tension
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Bridge")
+		TEnumAsByte<EBridgeMethod> bridgeMethod = MIDDLE_POINT;
+
+	/* Maximum distance between the supports of a deck, each bay between two supports is bent by the tension, 0 for a single bay */
+	UPROPERTY(EditAnywhere, Category = "Spline | Bridge", meta = (ClampMin = "0.0", ClampMax = "100000.0", EditCondition = "bridgeMethod != EBridgeMethod::MIDDLE_POINT", EditConditionHides))
+		float supportSpacing = 0.0f;
+
+	/* The plank of the decks, the floor of the bridge props by default and the mesh of the spline when it is not set */
+	UPROPERTY(EditAnywhere, Category = "Spline | Bridge", meta = (EditCondition = "bridgeMethod != EBridgeMethod::MIDDLE_POINT", EditConditionHides))
+		FMeshComposition bridgeDeckComposition = FMeshComposition();
+
 	#pragma endregion
-	
+
+	#pragma region LOD
+
+	/* Enable the distance based levels of detail of the spline meshes */
+	UPROPERTY(EditAnywhere, Category = "Spline | LOD")
+		bool useLOD = false;
+
+	/*
+	 * Number of consecutive meshes sharing the same level of detail
+	 * A merged level of detail replaces them with a single stretched mesh
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | LOD", meta = (ClampMin = "2", ClampMax = "64", EditCondition = "useLOD", EditConditionHides))
+		int lodChunkSize = 4;
+
+	/* Rate used to check the distance to the camera */
+	UPROPERTY(EditAnywhere, Category = "Spline | LOD", meta = (ClampMin = "0.0", ClampMax = "10.0", EditCondition = "useLOD", EditConditionHides))
+		float lodUpdateRate = 0.25f;
+
+	/*
+	 * The levels of detail of the spline meshes
+	 * The farthest level whose distance is reached is used
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | LOD", meta = (EditCondition = "useLOD", EditConditionHides))
+		TArray<FSplineMeshLOD> lods = TArray<FSplineMeshLOD>();
+
+	/* Set the cull distance of each mesh from its bounds */
+	UPROPERTY(EditAnywhere, Category = "Spline | LOD")
+		bool autoCullDistance = false;
+
+	/* Multiplier applied to the bounds radius of a mesh to get its cull distance */
+	UPROPERTY(EditAnywhere, Category = "Spline | LOD", meta = (ClampMin = "1.0", ClampMax = "10000.0", EditCondition = "autoCullDistance", EditConditionHides))
+		float cullDistanceScale = 200.0f;
+
+	/* The chunks of spline meshes handled by the levels of detail */
+	UPROPERTY(NonTransactional)
+		TArray<FSplineMeshLODChunk> lodChunks = TArray<FSplineMeshLODChunk>();
+
+	#pragma endregion
+
+	#pragma region HLOD
+
+	/*
+	 * The builder merging the spline meshes in the HLOD proxies of the world partition
+	 * The proxies are only rebuilt when the layout or the placement of the actor changes
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | HLOD", meta = (MetaClass = "/Script/Engine.HLODBuilder"))
+		FSoftClassPath hlodBuilderClass = FSoftClassPath(TEXT("/Script/DynamicSplineMeshEditor.DynamicSplineMeshHLODBuilder"));
+
+	#pragma endregion
+
+	#pragma region Cook
+
+	/*
+	 * Cook the spline meshes as they are saved and strip the inputs of the layout from the cooked actor
+	 * The cooked spline can't be rebuilt, leave it off for the splines built or replicated in game
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Cook")
+		bool bakeOnCook = false;
+
+	/* Set in the cooked actors whose inputs were stripped */
+	UPROPERTY()
+		bool isBaked = false;
+
+	#pragma endregion
+
+	#pragma region Collision
+
+	/*
+	 * The simplified collision generated for the spline meshes
+	 * The shapes are merged in a single body per chunk of consecutive meshes
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Collision")
+		TEnumAsByte<ESplineCollisionMode> collisionMode = TEnumAsByte<ESplineCollisionMode>();
+
+	/* Number of consecutive spline meshes sharing a collision body */
+	UPROPERTY(EditAnywhere, Category = "Spline | Collision", meta = (ClampMin = "1", ClampMax = "256", EditCondition = "collisionMode != ESplineCollisionMode::NO_COLLISION", EditConditionHides))
+		int collisionChunkSize = 16;
+
+	/* The collision profile of the collision bodies */
+	UPROPERTY(EditAnywhere, Category = "Spline | Collision", meta = (EditCondition = "collisionMode != ESplineCollisionMode::NO_COLLISION", EditConditionHides))
+		FCollisionProfileName collisionProfile = FCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+
+	/*
+	 * The collision bodies of the chunks
+	 * Kept between the rebuilds so the unchanged chunks don't dirty the navigation
+	 */
+	UPROPERTY(NonTransactional)
+		TArray<USplineMeshCollisionComponent*> collisionChunks = TArray<USplineMeshCollisionComponent*>();
+
+	#pragma endregion
+
+	#pragma region Scatter
+
+	/* Props placed along the spline, one instanced mesh per layer */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter")
+		TArray<FSplineScatterLayer> scatterLayers = TArray<FSplineScatterLayer>();
+
+	/* The instanced meshes of the scatter layers, in the same order */
+	UPROPERTY(NonTransactional)
+		TArray<UInstancedStaticMeshComponent*> scatterComponents = TArray<UInstancedStaticMeshComponent*>();
+
+	/*
+	 * Distances along the spline of the start and the end of each bridge
+	 * Computed with the bridges and used to keep the props off them
+	 */
+	UPROPERTY(NonTransactional)
+		TArray<FVector2D> bridgeRanges = TArray<FVector2D>();
+
+	#pragma endregion
+
+	#pragma region Network
+
+	/*
+	 * Replicate the definition of the spline built at runtime instead of its meshes
+	 * The clients regenerate the same layout from it
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Network")
+		bool replicateLayout = false;
+
+	/* The quantized definition of the last layout built by the server */
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_NetDefinition)
+		FSplineNetDefinition netDefinition = FSplineNetDefinition();
+
+	/*
+	 * The segments of the last layout built by the server, only sent when its compositions differ from the ones of the clients
+	 * Received along with the definition, read by its notify
+	 */
+	UPROPERTY(Transient, Replicated)
+		TArray<FSplineMeshSegment> netSegments = TArray<FSplineMeshSegment>();
+
+	/* Hash of the inputs not sent in the definition, as the clients have them */
+	uint32 netClientInputsHash = 0;
+
+	/* Size in bits of the replicated definition */
+	int netDefinitionBits = 0;
+
+	/* Whether the layout generated by this client matches the checksum of the server */
+	bool netChecksumMatches = true;
+
+	#pragma endregion
+
+	#pragma region Stats
+
+	/* Timings and counters of the last rebuild */
+	FSplineMeshBuildStats buildStats = FSplineMeshBuildStats();
+
+	#pragma endregion
+
+	#pragma region Generate
+
+	/* The running async generation, null when there is none */
+	TUniquePtr<FSplineMeshGeneration> generation = nullptr;
+
+	#pragma endregion
+
 public:	
 	ADynamicSplineMeshActor();
+
+	virtual void PostInitializeComponents() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Destroyed() override;
+	virtual void BeginDestroy() override;
+	virtual void Tick(float DeltaSeconds) override;
+	virtual bool ShouldTickIfViewportsOnly() const override;
+	virtual void Serialize(FArchive& Ar) override;
+
+	#pragma region Layout
+
+	/*
+	 * Snap the spline on the ground, make the bridges and copy the inputs of the layout
+	 * The previous meshes and segments are kept until FinishLayout
+	 * Must run on the game thread before ComputeLayout
+	 */
+	void PrepareLayout();
+
+	/*
+	 * Compute the segments with the placement method
+	 * Only reads the copied inputs and writes the computed segments, so it can run on any thread once the layout is prepared
+	 */
+	void ComputeLayout();
+
+	/*
+	 * Create the spline meshes of the computed segments and register the layout inputs
+	 * Must run on the game thread after ComputeLayout
+	 */
+	void FinishLayout();
+
+	/* Get the number of segments of the current layout */
+	FORCEINLINE int GetSegmentCount() const
+	{
+		return segments.Num();
+	}
+
+	/* Get the timings and counters of the last rebuild */
+	FORCEINLINE const FSplineMeshBuildStats& GetBuildStats() const
+	{
+		return buildStats;
+	}
+
+	/* Get the number of points of the spline */
+	FORCEINLINE int GetSplinePointCount() const
+	{
+		return spline ? spline->GetNumberOfSplinePoints() : 0;
+	}
+
+	/* Get the number of spline meshes currently set on the spline */
+	FORCEINLINE int GetSplineMeshCount() const
+	{
+		return splineMeshes.Num();
+	}
+
+	/*
+	 * Replace the points of the spline in a single assignment
+	 * The spline is updated once, whatever the number of points
+	 */
+	void SetSplinePoints(const TArray<FVector>& _points, const ESplineCoordinateSpace::Type _coordinateSpace);
+
+	/* Get the number of collision bodies and of their shapes */
+	void GetCollisionCounts(int& _bodies, int& _shapes) const;
+
+	/* Get the world bounds and centerline of each spline mesh, for the spatial index of the world */
+	void GatherSpatialEntries(TArray<FSplineMeshSpatialEntry>& _entries) const;
+
+	/* Get the hash of the inputs of the current layout */
+	FORCEINLINE uint64 GetLayoutHash() const
+	{
+		return layoutHash;
+	}
+
+	/* Get the segment of a spline mesh of the layout, null for the merged levels of detail and the other components */
+	const FSplineMeshSegment* FindSegment(const USplineMeshComponent* _splineMesh) const;
+
+	/* Add the meshes, and their LOD meshes, of every composition of the spline and of its lanes */
+	void GetUsedMeshes(TSet<UStaticMesh*>& _meshes) const;
+
+	/* Check if an input of the layout, like the bounds of a mesh, changed since the last rebuild */
+	FORCEINLINE bool IsLayoutOutdated() const
+	{
+		return layoutHash != ComputeLayoutHash();
+	}
+
+	#if WITH_EDITOR
+
+	/* Get the builder of the HLOD proxies of the spline meshes, null when it isn't loaded */
+	TSubclassOf<UHLODBuilder> GetHLODBuilderClass() const;
+
+	/* Called in the editor each time a spline actor creates its spline meshes */
+	static FOnSplineMeshLayoutApplied onLayoutApplied;
+
+	#endif
+
+	#pragma endregion
+
+	#pragma region Network
+
+	/*
+	 * Rebuild the spline at runtime
+	 * The clients receive its definition when the layout is replicated
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic spline mesh") void Rebuild();
+
+	/* Check if the spline was baked when cooked, it keeps its spline meshes and can't be rebuilt */
+	FORCEINLINE bool IsBaked() const
+	{
+		return isBaked;
+	}
+
+	/* Check if the layout is replicated instead of the spline meshes */
+	FORCEINLINE bool IsReplicatingLayout() const
+	{
+		return replicateLayout;
+	}
+
+	/* Get the definition of the last layout built by the server */
+	FORCEINLINE const FSplineNetDefinition& GetNetDefinition() const
+	{
+		return netDefinition;
+	}
+
+	/* Get the size in bits of the replicated definition, only known by the server */
+	FORCEINLINE int GetNetDefinitionBits() const
+	{
+		return netDefinitionBits;
+	}
+
+	/* Check if the layout generated by this client matches the one of the server */
+	FORCEINLINE bool DoesNetChecksumMatch() const
+	{
+		return netChecksumMatches;
+	}
+
+	/* Compute the checksum of the segments, compared between the server and the clients */
+	uint32 ComputeSegmentsChecksum() const;
+
+	/* Compute the hash of the inputs of the layout that are not sent in the definition, the compositions, the lanes and the decks */
+	uint32 ComputeNetInputsHash() const;
+
+	/*
+	 * Serialize a definition and read it back, as the clients receive it
+	 * Returns the size in bits of the serialized definition
+	 */
+	static int QuantizeNetDefinition(FSplineNetDefinition& _definition);
+
+	#pragma endregion
+
+	#pragma region Generate
+
+	/*
+	 * Rebuild the spline without a hitch
+	 * The segments are computed on a worker and the spline meshes are created over several frames
+	 * A running generation is cancelled first, the future is set on the game thread
+	 */
+	TFuture<FSplineMeshGenerateResult> GenerateAsync(const FSplineMeshGenerateSettings& _settings, const FOnSplineMeshGenerateProgress& _onProgress = FOnSplineMeshGenerateProgress());
+
+	/*
+	 * Cancel the running async generation
+	 * The previous layout is kept when its meshes are not replaced yet, the meshes and the segments are cleared otherwise
+	 * The next construction rebuilds the spline in both cases
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic spline mesh") void CancelGenerate();
+
+	/* Check if an async generation is running */
+	UFUNCTION(BlueprintPure, Category = "Dynamic spline mesh") FORCEINLINE bool IsGenerating() const
+	{
+		return generation.IsValid();
+	}
+
+	#pragma endregion
 	
 private:
 	#if WITH_EDITOR
 
 	virtual void OnConstruction(const FTransform& Transform) override;
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditMove(bool bFinished) override;
+	virtual void PostEditUndo() override;
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
 
 	#endif
 	
@@ -270,26 +805,191 @@ private:
 
 	#pragma endregion
 
+	#pragma region Preview
+
+	/* Check if the mouse is held in the editor, while a spline point or the actor is dragged */
+	bool IsDragging() const;
+
+	/*
+	 * Draw the bounds of the meshes along the spline, without ground checks nor spline meshes
+	 * Samples at most previewBoxCount boxes so its cost doesn't depend on the spline lenght
+	 * Only drawn by the update timer, the boxes last one preview rate
+	 */
+	void DrawPreview() const;
+
+	#pragma endregion
+
 	#pragma region Update
 
 	/* Flush and reset the spline meshes with the different methods */
 	UFUNCTION(CallInEditor, Category = "Spline => Editor") void UpdateSpline();
 
+	/*
+	 * Called by the update timer
+	 * Refreshes the preview and waits while the mouse is held, updates the spline otherwise
+	 */
+	void OnUpdateTimer();
+
 	/* Destroy all SplineMeshComponent */
 	void FlushSpline();
 
+	/* Create the spline meshes of the computed segments */
+	void ApplyLayout();
+
+	/* Create the spline meshes of a range of segments */
+	void AddSegmentMeshes(const int _firstSegment, const int _count);
+
+	/* Build the levels of detail, the collision, the props and the spatial index of the created spline meshes */
+	void FinishApplyLayout();
+
+	/* Register the current spline meshes in the spatial index of the world */
+	void UpdateSpatialIndex();
+
+	/*
+	 * Fit the collision shapes of the spline meshes and update the chunks whose shapes changed
+	 * Destroys the collision bodies when the collision is disabled
+	 */
+	void BuildCollision();
+
+	/*
+	 * Place the props of the scatter layers along the spline
+	 * Reuses the spline snapped on the ground and the bridges of the last rebuild, only the props aligned on the ground are traced
+	 */
+	void BuildScatter();
+
+	/*
+	 * Compute the transforms of the props of a layer, in the space of the spline
+	 * All the props are evaluated in one batch, only the layers aligned on the ground trace it
+	 */
+	void ComputeScatterTransforms(const FSplineScatterLayer& _layer, TArray<FTransform>& _transforms) const;
+
+	/* Check if a distance along the spline is on a bridge or within a margin around it */
+	FORCEINLINE bool IsOnBridge(const float _distance, const float _margin) const
+	{
+		for (const FVector2D& _bridgeRange : bridgeRanges)
+		{
+			if (_distance >= _bridgeRange.X - _margin && _distance <= _bridgeRange.Y + _margin) return true;
+		}
+
+		return false;
+	}
+
+	/*
+	 * Recreate the spline meshes from the saved segments
+	 * Skips the ground checks and the layout
+	 */
+	void RestoreLayout();
+
+	/* Compute the hash of every input of the layout */
+	uint64 ComputeLayoutHash() const;
+
+	/* Write the values of a mesh composition used by the layout */
+	void WriteMeshComposition(FArchive& _archive, const FMeshComposition& _meshComposition) const;
+
+	/* Write the values of an array of mesh compositions, preceded by their count */
+	void WriteMeshCompositions(FArchive& _archive, const TArray<FMeshComposition>& _meshesComposition) const;
+
+	/* Write the values of a lane used by the layout */
+	void WriteLane(FArchive& _archive, const FSplineMeshLane& _lane) const;
+
+	/* Write the rotation method and every mesh rotation */
+	void WriteMeshRotations(FArchive& _archive) const;
+
+	/*
+	 * Compute the key of the segments of some inputs in the shared layout cache
+	 * Hashes the local curve, not the transform of the actor, so the copies of a spline placed anywhere share their segments
+	 */
+	uint64 ComputeLayoutCacheKey(const FSplineMeshLayoutInputs& _inputs) const;
+
+	#pragma endregion
+
+	#pragma region Network
+
+	/* Check if this client receives the layout from the server instead of building it */
+	FORCEINLINE bool IsLayoutFromServer() const
+	{
+		return replicateLayout && GetNetMode() == NM_Client;
+	}
+
+	/* Check if this server sends the layout it builds to the clients */
+	FORCEINLINE bool ShouldSendLayout() const
+	{
+		return replicateLayout && HasAuthority() && GetWorld() && GetWorld()->IsGameWorld();
+	}
+
+	/* Make the definition of the current spline, once snapped on the ground and bridged */
+	FSplineNetDefinition MakeNetDefinition() const;
+
+	/* Set the spline, its tangents, rotations and scales, and the methods from a definition */
+	void ApplyNetDefinition(const FSplineNetDefinition& _definition);
+
+	/*
+	 * Regenerate the layout from the definition received from the server
+	 * Skips the ground checks and the bridges, already applied to the points
+	 */
+	UFUNCTION() void OnRep_NetDefinition();
+
+	/*
+	 * Quantize the current spline as the clients receive it and lay it out from the quantized values
+	 * Returns false when this server doesn't send its layout
+	 */
+	bool PrepareNetDefinition(FSplineNetDefinition& _definition);
+
+	/*
+	 * Send a definition to the clients with the checksum of the current segments
+	 * The segments are sent too when the compositions of the clients differ
+	 */
+	void SendNetDefinition(FSplineNetDefinition& _definition);
+
+	#pragma endregion
+
+	#pragma region Generate
+
+	/*
+	 * Create a slice of the spline meshes once the segments are computed
+	 * Finishes the layout and completes the generation after the last slice
+	 */
+	bool TickGenerate(float _deltaTime);
+
+	/* Set the result of the running generation and release it */
+	void CompleteGenerate(const bool _cancelled);
+
 	#pragma endregion
 
 	#pragma region Composition
 
-	/* Applies a duplication method to compose the spline */
-	void DuplicateMesh();
+	/* Copy the spline and every value read by the layout */
+	FSplineMeshLayoutInputs MakeLayoutInputs() const;
+
+	/* Flush the previous meshes and move the computed segments into the layout, on the game thread */
+	void TakeComputedLayout();
 
-	/* Applies a extend method to compose the spline */
-	void ExtendMesh();
+	/* Applies a duplication method to compute the segments */
+	static void DuplicateMesh(const FSplineMeshLayoutInputs& _inputs, FRandomStream& _randomStream, TArray<FSplineMeshSegment>& _segments);
 
-	/* Get a random mesh to compose the spline */
-	FMeshComposition GetRandomMeshComposition() const;
+	/* Applies a extend method to compute the segments */
+	static void ExtendMesh(const FSplineMeshLayoutInputs& _inputs, TArray<FSplineMeshSegment>& _segments);
+
+	/* Get the composition and the placement of the spline itself as a lane without offset */
+	FSplineMeshLane MakeMainLane() const;
+
+	/* Compute the meshes of a lane placed along a spline of this length, the random compositions draw from the stream */
+	static FSplineMeshPlan ComputePlan(const FSplineMeshLane& _lane, const float _splineLength, FRandomStream& _randomStream);
+
+	/*
+	 * Compute the segments of the lanes after the segments of the spline
+	 * The spline is sampled once in a frame table shared by every lane
+	 */
+	static void ComputeLanes(const FSplineMeshLayoutInputs& _inputs, FRandomStream& _randomStream, TArray<FSplineMeshSegment>& _segments);
+
+	/* Applies a duplication method to compute the segments of a lane */
+	static void DuplicateLane(const FSplineMeshLayoutInputs& _inputs, const FSplineMeshLane& _lane, const int _laneIndex, const SplineLayout::FrameTable& _frameTable, FRandomStream& _randomStream, TArray<FSplineMeshSegment>& _segments);
+
+	/* Applies a extend method to compute the segments of a lane, a mesh between each pair of spline points */
+	static void ExtendLane(const FSplineMeshLayoutInputs& _inputs, const FSplineMeshLane& _lane, const int _laneIndex, const SplineLayout::FrameTable& _frameTable, TArray<FSplineMeshSegment>& _segments);
+
+	/* Get the vertical offset of a mesh snapped on the ground, half of its height */
+	static FVector GetGroundOffset(const FSplineMeshLayoutInputs& _inputs, const FMeshComposition& _meshComposition);
 
 	/* Randomize the meshes of the spline */
 	UFUNCTION(CallInEditor, Category = "Spline => Editor", meta = (EditCondition = "composition == EComposition::RANDOM", EditConditionHides)) void RandomizeSpline();
@@ -298,30 +998,40 @@ private:
 
 	#pragma region Placement
 
-	/* Add a new mesh to the spline */
-	void AddSplineMesh(const FMeshComposition& _meshComposition, const FSplineMeshValues& _values, const int _index);
+	/* Create a registered spline mesh component attached to the spline */
+	USplineMeshComponent* CreateSplineMeshComponent(UStaticMesh* _mesh);
+
+	/*
+	 * Create a registered component attached to the spline, like the collision chunks and the scatter layers
+	 * Kept out of the undo buffer and alive when the construction script runs again
+	 */
+	template <typename ComponentType>
+	ComponentType* CreateAttachedComponent()
+	{
+		ComponentType* _component = NewObject<ComponentType>(this, ComponentType::StaticClass());
+		if (!_component) return nullptr;
+
+		_component->ClearFlags(RF_Transactional);
+		_component->CreationMethod = EComponentCreationMethod::Instance;
+		_component->SetMobility(EComponentMobility::Movable);
+		_component->SetupAttachment(spline);
+		_component->RegisterComponentWithWorld(GetWorld());
+		return _component;
+	}
+
+	/* Add a new mesh to the spline with the values of its rotated segment */
+	void AddSplineMesh(const FMeshComposition& _meshComposition, const FSplineMeshValues& _values);
 
-	/* Rotate a specific mesh on the spline */
-	void RotateSplineMesh(USplineMeshComponent* _splineMesh, const FSplineMeshValues& _values, const unsigned int _index) const;
+	/*
+	 * Get the values given to the mesh of a segment by the rotation method
+	 * Only reads the rotations, so the segments can be rotated in parallel
+	 */
+	FSplineMeshValues RotateSegment(const FSplineMeshValues& _values, const unsigned int _index) const;
 
 	/* Get mesh rotation vector */
 	FORCEINLINE FVector GetRotatedVector(const FMeshRotation& _meshRotation) const
 	{
-		const float _angle = FMath::DegreesToRadians(_meshRotation.angle);
-		switch (_meshRotation.axisRotation)
-		{
-		case ROTATE_X:
-			return FVector(0.0f, -FMath::Cos(_angle) , FMath::Sin(_angle));
-				
-		case ROTATE_Y:
-			return FVector(FMath::Cos(_angle), 0.0f, FMath::Sin(_angle));
-				
-		case ROTATE_Z:
-			return FVector(FMath::Cos(_angle), FMath::Sin(_angle), 0.0f);
-			
-		default:
-			return FVector(0.0f);
-		}
+		return SplineLayoutAdapter::ToEngine(SplineLayout::GetRotatedVector(SplineLayoutAdapter::ToLayout(_meshRotation.axisRotation), _meshRotation.angle));
 	}
 
 	/* Get mesh rotation at a specific index */
@@ -370,18 +1080,60 @@ private:
 	/* Snap the spline on the ground */
 	void SnapOnGround();
 
+	/* Get the world locations of the spline at sorted distances, evaluated in one batch */
+	TArray<FVector> GetWorldLocationsAtDistances(const TArray<double>& _distances) const;
+
 	/*
-	 * Ground ground at distance along spline
+	 * Ground ground under a location of the spline
 	 * Update '_splinePoints' consequently
 	 */
-	void CheckGround(TArray<FVector>& _splinePoints, float _distance, float _depth);
+	void CheckGround(TArray<FVector>& _splinePoints, const FVector& _splinePointLocation, float _depth);
+
+	/* Trace the ground under a world location and get its normal, ignoring the spline itself */
+	bool TraceGroundNormal(const FVector& _location, FVector& _normal) const;
+
 	void MakeBridge();
 
 #pragma endregion
 
 	#pragma region Bridge
 
+	/* Get the plank of the decks, the mesh of the spline when it is not set */
+	const FMeshComposition& GetDeckComposition() const;
+
+	/* Check if the bridges are decks laid along a sag profile rather than a bend of the spline */
+	bool HasBridgeDecks() const;
+
+	/*
+	 * Lay the planks of each bridge along its profile, the profiles are computed once per bridge
+	 * The segments of the spline from '_firstSegment' are kept in order along the spline
+	 */
+	static void AddBridgeDecks(const FSplineMeshLayoutInputs& _inputs, const int _firstSegment, TArray<FSplineMeshSegment>& _segments);
+
+	#pragma endregion
+
+	#pragma region LOD
+
+	/*
+	 * Split the spline meshes in chunks and set their cull distance
+	 * Called after the spline meshes are created
+	 */
+	void BuildLOD();
+
+	/*
+	 * Apply the level of detail of each chunk from the camera distance
+	 * Only the chunks whose level has changed are updated
+	 */
+	void UpdateLOD();
+
+	/* Get the level of detail used at a distance, 0 is the full detail */
+	int GetLODLevel(const float _distance) const;
+
+	/* Apply a level of detail to a chunk */
+	void ApplyLOD(FSplineMeshLODChunk& _chunk, const int _level);
 
+	/* Set the cull distance of a spline mesh from its bounds */
+	void SetAutoCullDistance(USplineMeshComponent* _splineMesh) const;
 
 	#pragma endregion
 };
\ No newline at end of file
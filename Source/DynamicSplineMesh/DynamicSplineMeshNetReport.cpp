@@ -0,0 +1,114 @@
+#include "DynamicSplineMeshNetReport.h"
+
+#include "DynamicSplineMesh.h"
+#include "DynamicSplineMeshActor.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CmdNetReport(
+	TEXT("dsm.Net.Report"),
+	TEXT("Print the size of the replicated definition of each spline against the replication of its components"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FDynamicSplineMeshNetReport::Run));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CmdNetSpawn(
+	TEXT("dsm.Net.Spawn"),
+	TEXT("Spawn replicated splines on the server. Args: Class=Path [Count=N] [Points=N] [Spacing=N] [Seed=N]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FDynamicSplineMeshNetReport::Spawn));
+
+void FDynamicSplineMeshNetReport::Run(const TArray<FString>& _args, UWorld* _world, FOutputDevice& _output)
+{
+	if (!_world) return;
+
+	_output.Logf(TEXT("%-40s %7s %7s %10s %12s %7s %9s"), TEXT("Actor"), TEXT("Points"), TEXT("Meshes"), TEXT("DefBytes"), TEXT("CompBytes"), TEXT("Ratio"), TEXT("Checksum"));
+
+	int _actorsCount = 0;
+	int64 _totalDefinitionBits = 0;
+	int64 _totalComponentBits = 0;
+	int _mismatchesCount = 0;
+	for (TActorIterator<ADynamicSplineMeshActor> _iterator(_world); _iterator; ++_iterator)
+	{
+		const ADynamicSplineMeshActor* _actor = *_iterator;
+		if (!_actor->IsReplicatingLayout()) continue;
+
+		// The clients don't know the size, serialize the received definition again
+		int _definitionBits = _actor->GetNetDefinitionBits();
+		if (_definitionBits == 0)
+		{
+			FSplineNetDefinition _definition = _actor->GetNetDefinition();
+			_definitionBits = ADynamicSplineMeshActor::QuantizeNetDefinition(_definition);
+		}
+
+		const int64 _componentBits = static_cast<int64>(_actor->GetSplineMeshCount()) * ComponentBits;
+		const bool _checksumMatches = _actor->DoesNetChecksumMatch();
+		_output.Logf(TEXT("%-40s %7d %7d %10d %12lld %7.1f %9s"),
+			*_actor->GetActorNameOrLabel().Left(40), _actor->GetSplinePointCount(), _actor->GetSplineMeshCount(),
+			FMath::DivideAndRoundUp(_definitionBits, 8), FMath::DivideAndRoundUp(_componentBits, static_cast<int64>(8)),
+			_definitionBits > 0 ? static_cast<double>(_componentBits) / _definitionBits : 0.0,
+			_actor->GetNetMode() != NM_Client ? TEXT("Server") : _checksumMatches ? TEXT("Match") : TEXT("Mismatch"));
+
+		_actorsCount++;
+		_totalDefinitionBits += _definitionBits;
+		_totalComponentBits += _componentBits;
+		if (!_checksumMatches) _mismatchesCount++;
+	}
+
+	_output.Logf(TEXT("%d replicated splines: %lld bytes of definitions against %lld bytes of components, %d checksum mismatches"),
+		_actorsCount, FMath::DivideAndRoundUp(_totalDefinitionBits, static_cast<int64>(8)), FMath::DivideAndRoundUp(_totalComponentBits, static_cast<int64>(8)), _mismatchesCount);
+}
+
+void FDynamicSplineMeshNetReport::Spawn(const TArray<FString>& _args, UWorld* _world, FOutputDevice& _output)
+{
+	if (!_world || _world->GetNetMode() == NM_Client)
+	{
+		_output.Log(TEXT("dsm.Net.Spawn must run on the server"));
+		return;
+	}
+
+	// Read the arguments
+	const FString& _params = FString::Join(_args, TEXT(" "));
+	FString _classPath = FString();
+	FParse::Value(*_params, TEXT("Class="), _classPath);
+	int _count = 10;
+	FParse::Value(*_params, TEXT("Count="), _count);
+	int _pointsCount = 16;
+	FParse::Value(*_params, TEXT("Points="), _pointsCount);
+	float _spacing = 500.0f;
+	FParse::Value(*_params, TEXT("Spacing="), _spacing);
+	int _seed = 0;
+	FParse::Value(*_params, TEXT("Seed="), _seed);
+
+	UClass* _class = _classPath.IsEmpty() ? nullptr : LoadClass<ADynamicSplineMeshActor>(nullptr, *_classPath);
+	if (!_class)
+	{
+		UE_LOG(LogDynamicSplineMesh, Error, TEXT("dsm.Net.Spawn: '%s' is not a spline actor class"), *_classPath);
+		return;
+	}
+
+	// Spawn the splines side by side, each one on a random walk
+	FRandomStream _random = FRandomStream(_seed);
+	for (int _actorIndex = 0; _actorIndex < _count; _actorIndex++)
+	{
+		const FVector& _location = FVector(0.0f, _actorIndex * _spacing * 2.0f, 0.0f);
+		ADynamicSplineMeshActor* _actor = _world->SpawnActor<ADynamicSplineMeshActor>(_class, _location, FRotator::ZeroRotator);
+		if (!_actor) continue;
+
+		if (!_actor->IsReplicatingLayout())
+		{
+			UE_LOG(LogDynamicSplineMesh, Warning, TEXT("dsm.Net.Spawn: %s doesn't replicate its layout"), *_classPath);
+		}
+
+		TArray<FVector> _points = TArray<FVector>();
+		_points.Reserve(_pointsCount);
+		FVector _point = FVector::ZeroVector;
+		for (int _pointIndex = 0; _pointIndex < _pointsCount; _pointIndex++)
+		{
+			_points.Add(_point);
+			_point += FVector(_spacing, _random.FRandRange(-0.5f, 0.5f) * _spacing, 0.0f);
+		}
+
+		_actor->SetSplinePoints(_points, ESplineCoordinateSpace::Local);
+		_actor->Rebuild();
+	}
+
+	_output.Logf(TEXT("Spawned %d replicated splines of %d points, run stat net on a client to read their traffic"), _count, _pointsCount);
+}
\ No newline at end of file
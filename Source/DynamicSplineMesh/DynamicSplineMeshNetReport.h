@@ -0,0 +1,25 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/*
+ * Measures the bandwidth of the replicated spline definitions
+ * Run with the console commands dsm.Net.Report and dsm.Net.Spawn Class=Path [Count=N] [Points=N] [Spacing=N] [Seed=N]
+ */
+class DYNAMICSPLINEMESH_API FDynamicSplineMeshNetReport
+{
+public:
+	/*
+	 * Estimated bits to replicate a spline mesh component instead of the definition
+	 * Four vectors and two scales at full precision, the mesh reference and the component header
+	 */
+	static constexpr int ComponentBits = (4 * 3 + 2 * 2) * 32 + 32 + 64;
+
+	/* Print the size of the definition of each replicated spline against the replication of its components */
+	static void Run(const TArray<FString>& _args, UWorld* _world, FOutputDevice& _output);
+
+	/*
+	 * Spawn replicated splines on the server, to measure their traffic with stat net
+	 * The class must be a spline actor whose meshes are set in its defaults, the clients don't receive them
+	 */
+	static void Spawn(const TArray<FString>& _args, UWorld* _world, FOutputDevice& _output);
+};
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include "DynamicSplineMeshReport.h"
+
+#include "DynamicSplineMesh.h"
+#include "DynamicSplineMeshActor.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "PrimitiveSceneProxy.h"
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CmdReport(
+	TEXT("dsm.Report"),
+	TEXT("Print the memory and primitives of every spline actor of the world. Args: [Sort=Memory|Components|Points|Draws|Bodies|Rebuild|Name] [Top=N] [Csv[=Path]]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FDynamicSplineMeshReport::Run));
+
+FSplineMeshActorReport FDynamicSplineMeshReport::MakeActorReport(const ADynamicSplineMeshActor* _actor)
+{
+	FSplineMeshActorReport _report = FSplineMeshActorReport();
+	if (!IsValid(_actor)) return _report;
+
+	_report.name = _actor->GetActorNameOrLabel();
+	_report.splinePoints = _actor->GetSplinePointCount();
+	_report.splineMeshes = _actor->GetSplineMeshCount();
+	_report.lastRebuildTime = _actor->GetBuildStats().GetTotalTime() * 1000.0;
+	_actor->GetCollisionCounts(_report.collisionBodies, _report.collisionShapes);
+
+	// Run through the generated components, the merged levels of detail included
+	TInlineComponentArray<USplineMeshComponent*> _components = TInlineComponentArray<USplineMeshComponent*>(_actor);
+	for (const USplineMeshComponent* _component : _components)
+	{
+		if (!IsValid(_component)) continue;
+		_report.components++;
+
+		// Memory of the component object and of the resources it owns
+		FResourceSizeEx _resourceSize = FResourceSizeEx(EResourceSizeMode::Exclusive);
+		const_cast<USplineMeshComponent*>(_component)->GetResourceSizeEx(_resourceSize);
+		_report.componentMemory += _component->GetClass()->GetStructureSize() + _resourceSize.GetTotalMemoryBytes();
+
+		// Memory of the render proxy, only when the component is registered in the scene
+		if (_component->SceneProxy) _report.renderMemory += _component->SceneProxy->GetMemoryFootprint();
+
+		const UStaticMesh* _mesh = _component->GetStaticMesh();
+		if (!_mesh) continue;
+		_report.meshes.Add(_mesh);
+
+		const int _materialsCount = _component->GetNumMaterials();
+		for (int _materialIndex = 0; _materialIndex < _materialsCount; _materialIndex++)
+		{
+			const UMaterialInterface* _material = _component->GetMaterial(_materialIndex);
+			if (_material) _report.materials.Add(_material);
+		}
+
+		// Each section of the first level of detail is a draw call
+		if (_component->IsVisible()) _report.drawCalls += _mesh->GetNumSections(0);
+	}
+
+	_report.uniqueMeshes = _report.meshes.Num();
+	_report.uniqueMaterials = _report.materials.Num();
+	return _report;
+}
+
+TArray<FSplineMeshActorReport> FDynamicSplineMeshReport::MakeWorldReport(UWorld* _world)
+{
+	TArray<FSplineMeshActorReport> _reports = TArray<FSplineMeshActorReport>();
+	if (!_world) return _reports;
+
+	for (TActorIterator<ADynamicSplineMeshActor> _iterator(_world); _iterator; ++_iterator)
+	{
+		_reports.Add(MakeActorReport(*_iterator));
+	}
+
+	return _reports;
+}
+
+void FDynamicSplineMeshReport::Run(const TArray<FString>& _args, UWorld* _world, FOutputDevice& _output)
+{
+	// Read the arguments
+	const FString& _params = FString::Join(_args, TEXT(" "));
+	FString _sort = TEXT("Memory");
+	FParse::Value(*_params, TEXT("Sort="), _sort);
+	int _top = 0;
+	FParse::Value(*_params, TEXT("Top="), _top);
+	FString _csvPath = FString();
+	const bool _writeCsv = FParse::Value(*_params, TEXT("Csv="), _csvPath) || _args.Contains(TEXT("Csv"));
+
+	TArray<FSplineMeshActorReport> _reports = MakeWorldReport(_world);
+	SortReports(_reports, _sort);
+
+	// Sum the reports, the meshes and materials shared between the actors are counted once
+	FSplineMeshActorReport _total = FSplineMeshActorReport();
+	_total.name = TEXT("Total");
+	for (const FSplineMeshActorReport& _report : _reports)
+	{
+		_total.splinePoints += _report.splinePoints;
+		_total.splineMeshes += _report.splineMeshes;
+		_total.components += _report.components;
+		_total.componentMemory += _report.componentMemory;
+		_total.renderMemory += _report.renderMemory;
+		_total.meshes.Append(_report.meshes);
+		_total.materials.Append(_report.materials);
+		_total.drawCalls += _report.drawCalls;
+		_total.collisionBodies += _report.collisionBodies;
+		_total.collisionShapes += _report.collisionShapes;
+		_total.lastRebuildTime += _report.lastRebuildTime;
+	}
+	_total.uniqueMeshes = _total.meshes.Num();
+	_total.uniqueMaterials = _total.materials.Num();
+
+	// Print the table
+	const auto _printRow = [&_output](const FSplineMeshActorReport& _report)
+	{
+		_output.Logf(TEXT("%-40s %7d %7d %7d %10.1f %10.1f %6d %6d %6d %6d %7d %9.2f"),
+			*_report.name.Left(40), _report.splinePoints, _report.splineMeshes, _report.components,
+			_report.componentMemory / 1024.0, _report.renderMemory / 1024.0,
+			_report.uniqueMeshes, _report.uniqueMaterials, _report.drawCalls,
+			_report.collisionBodies, _report.collisionShapes, _report.lastRebuildTime);
+	};
+
+	_output.Logf(TEXT("Dynamic spline mesh report: %d actors, sorted by %s"), _reports.Num(), *_sort);
+	_output.Logf(TEXT("%-40s %7s %7s %7s %10s %10s %6s %6s %6s %6s %7s %9s"),
+		TEXT("Actor"), TEXT("Points"), TEXT("Meshes"), TEXT("Comps"), TEXT("CompKB"), TEXT("ProxyKB"),
+		TEXT("UMesh"), TEXT("UMat"), TEXT("Draws"), TEXT("Bodies"), TEXT("Shapes"), TEXT("RebuildMs"));
+
+	const int _rowsCount = _top > 0 ? FMath::Min(_top, _reports.Num()) : _reports.Num();
+	for (int _reportIndex = 0; _reportIndex < _rowsCount; _reportIndex++)
+	{
+		_printRow(_reports[_reportIndex]);
+	}
+
+	_printRow(_total);
+
+	if (!_writeCsv) return;
+
+	// Write every actor in the CSV, the top only limits the printed rows
+	if (_csvPath.IsEmpty())
+	{
+		const FString& _fileName = FString::Printf(TEXT("Report-%s.csv"), *FDateTime::Now().ToString());
+		_csvPath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("DynamicSplineMesh"), _fileName);
+	}
+
+	if (WriteCsv(_reports, _total, _csvPath))
+	{
+		_output.Logf(TEXT("Report written to %s"), *_csvPath);
+	}
+
+	else
+	{
+		UE_LOG(LogDynamicSplineMesh, Error, TEXT("Failed to write the report to %s"), *_csvPath);
+	}
+}
+
+void FDynamicSplineMeshReport::SortReports(TArray<FSplineMeshActorReport>& _reports, const FString& _sort)
+{
+	if (_sort == TEXT("Name"))
+	{
+		_reports.Sort([](const FSplineMeshActorReport& _a, const FSplineMeshActorReport& _b) { return _a.name < _b.name; });
+	}
+
+	else if (_sort == TEXT("Components"))
+	{
+		_reports.Sort([](const FSplineMeshActorReport& _a, const FSplineMeshActorReport& _b) { return _a.components > _b.components; });
+	}
+
+	else if (_sort == TEXT("Points"))
+	{
+		_reports.Sort([](const FSplineMeshActorReport& _a, const FSplineMeshActorReport& _b) { return _a.splinePoints > _b.splinePoints; });
+	}
+
+	else if (_sort == TEXT("Draws"))
+	{
+		_reports.Sort([](const FSplineMeshActorReport& _a, const FSplineMeshActorReport& _b) { return _a.drawCalls > _b.drawCalls; });
+	}
+
+	else if (_sort == TEXT("Bodies"))
+	{
+		_reports.Sort([](const FSplineMeshActorReport& _a, const FSplineMeshActorReport& _b) { return _a.collisionBodies > _b.collisionBodies; });
+	}
+
+	else if (_sort == TEXT("Rebuild"))
+	{
+		_reports.Sort([](const FSplineMeshActorReport& _a, const FSplineMeshActorReport& _b) { return _a.lastRebuildTime > _b.lastRebuildTime; });
+	}
+
+	else
+	{
+		_reports.Sort([](const FSplineMeshActorReport& _a, const FSplineMeshActorReport& _b) { return _a.GetTotalMemory() > _b.GetTotalMemory(); });
+	}
+}
+
+bool FDynamicSplineMeshReport::WriteCsv(const TArray<FSplineMeshActorReport>& _reports, const FSplineMeshActorReport& _total, const FString& _path)
+{
+	FString _csv = TEXT("Actor,SplinePoints,SplineMeshes,Components,ComponentBytes,ProxyBytes,UniqueMeshes,UniqueMaterials,DrawCalls,CollisionBodies,CollisionShapes,RebuildMs\n");
+
+	const auto _addRow = [&_csv](const FSplineMeshActorReport& _report)
+	{
+		_csv += FString::Printf(TEXT("\"%s\",%d,%d,%d,%llu,%llu,%d,%d,%d,%d,%d,%.3f\n"),
+			*_report.name.Replace(TEXT("\""), TEXT("\"\"")), _report.splinePoints, _report.splineMeshes, _report.components,
+			static_cast<uint64>(_report.componentMemory), static_cast<uint64>(_report.renderMemory),
+			_report.uniqueMeshes, _report.uniqueMaterials, _report.drawCalls,
+			_report.collisionBodies, _report.collisionShapes, _report.lastRebuildTime);
+	};
+
+	for (const FSplineMeshActorReport& _report : _reports)
+	{
+		_addRow(_report);
+	}
+
+	_addRow(_total);
+	return FFileHelper::SaveStringToFile(_csv, *_path);
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class ADynamicSplineMeshActor;
+class UMaterialInterface;
+class UStaticMesh;
+
+/* Memory and primitive figures of a spline actor */
+struct FSplineMeshActorReport
+{
+	/* Label of the actor */
+	FString name = FString();
+
+	/* Number of points of the spline */
+	int splinePoints = 0;
+
+	/* Number of spline meshes of the layout */
+	int splineMeshes = 0;
+
+	/* Number of generated components, including the merged levels of detail */
+	int components = 0;
+
+	/* Estimated memory of the generated components, in bytes */
+	SIZE_T componentMemory = 0;
+
+	/* Estimated memory of the render proxies of the generated components, in bytes */
+	SIZE_T renderMemory = 0;
+
+	/* Number of distinct static meshes used by the components */
+	int uniqueMeshes = 0;
+
+	/* Number of distinct materials used by the components */
+	int uniqueMaterials = 0;
+
+	/* The distinct static meshes, merged across the actors for the total */
+	TSet<const UStaticMesh*> meshes = TSet<const UStaticMesh*>();
+
+	/* The distinct materials, merged across the actors for the total */
+	TSet<const UMaterialInterface*> materials = TSet<const UMaterialInterface*>();
+
+	/* Estimated draw calls of the visible components, one per mesh section */
+	int drawCalls = 0;
+
+	/* Number of collision bodies */
+	int collisionBodies = 0;
+
+	/* Number of collision shapes, the cost of a query grows with the shapes it overlaps */
+	int collisionShapes = 0;
+
+	/* Duration of the last rebuild, in milliseconds */
+	double lastRebuildTime = 0.0;
+
+	FORCEINLINE SIZE_T GetTotalMemory() const
+	{
+		return componentMemory + renderMemory;
+	}
+};
+
+/*
+ * Walks the spline actors of a world and reports their memory and primitives
+ * Run with the console command dsm.Report [Sort=Memory|Components|Points|Draws|Bodies|Rebuild|Name] [Top=N] [Csv[=Path]]
+ */
+class DYNAMICSPLINEMESH_API FDynamicSplineMeshReport
+{
+public:
+	/* Compute the report of a spline actor */
+	static FSplineMeshActorReport MakeActorReport(const ADynamicSplineMeshActor* _actor);
+
+	/* Compute the reports of all the spline actors of a world */
+	static TArray<FSplineMeshActorReport> MakeWorldReport(UWorld* _world);
+
+	/* Print the reports of a world and optionally write them as CSV */
+	static void Run(const TArray<FString>& _args, UWorld* _world, FOutputDevice& _output);
+
+private:
+	/* Sort the reports by a column, the biggest first */
+	static void SortReports(TArray<FSplineMeshActorReport>& _reports, const FString& _sort);
+
+	/* Write the reports and their total in a CSV file */
+	static bool WriteCsv(const TArray<FSplineMeshActorReport>& _reports, const FSplineMeshActorReport& _total, const FString& _path);
+};
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "DynamicSplineMeshStats.h"
+
+DEFINE_STAT(STAT_DSM_UpdateSpline);
+DEFINE_STAT(STAT_DSM_RestoreLayout);
+DEFINE_STAT(STAT_DSM_FlushSpline);
+DEFINE_STAT(STAT_DSM_SnapOnGround);
+DEFINE_STAT(STAT_DSM_CheckGround);
+DEFINE_STAT(STAT_DSM_MakeBridge);
+DEFINE_STAT(STAT_DSM_AddBridgeDecks);
+DEFINE_STAT(STAT_DSM_DuplicateMesh);
+DEFINE_STAT(STAT_DSM_ExtendMesh);
+DEFINE_STAT(STAT_DSM_ComputeLanes);
+DEFINE_STAT(STAT_DSM_AddSplineMesh);
+DEFINE_STAT(STAT_DSM_RotateSplineMesh);
+DEFINE_STAT(STAT_DSM_BuildCollision);
+DEFINE_STAT(STAT_DSM_BuildScatter);
+
+DEFINE_STAT(STAT_DSM_GroundTraces);
+DEFINE_STAT(STAT_DSM_ComponentsCreated);
+DEFINE_STAT(STAT_DSM_ComponentsDestroyed);
+DEFINE_STAT(STAT_DSM_ComponentsAlive);
+DEFINE_STAT(STAT_DSM_LayoutCacheHits);
+DEFINE_STAT(STAT_DSM_LayoutCacheMisses);
+DEFINE_STAT(STAT_DSM_CollisionChunksRebuilt);
+DEFINE_STAT(STAT_DSM_CollisionShapes);
+DEFINE_STAT(STAT_DSM_ScatteredProps);
+DEFINE_STAT(STAT_DSM_NetChecksumMismatches);
+
+CSV_DEFINE_CATEGORY_MODULE(DYNAMICSPLINEMESH_API, DynamicSplineMesh, true);
\ No newline at end of file
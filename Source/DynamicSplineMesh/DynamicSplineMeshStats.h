@@ -0,0 +1,109 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/ScopedTimers.h"
+
+DECLARE_STATS_GROUP(TEXT("DynamicSplineMesh"), STATGROUP_DynamicSplineMesh, STATCAT_Advanced);
+
+#pragma region Cycles
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateSpline"), STAT_DSM_UpdateSpline, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RestoreLayout"), STAT_DSM_RestoreLayout, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FlushSpline"), STAT_DSM_FlushSpline, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SnapOnGround"), STAT_DSM_SnapOnGround, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CheckGround"), STAT_DSM_CheckGround, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("MakeBridge"), STAT_DSM_MakeBridge, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AddBridgeDecks"), STAT_DSM_AddBridgeDecks, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("DuplicateMesh"), STAT_DSM_DuplicateMesh, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ExtendMesh"), STAT_DSM_ExtendMesh, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ComputeLanes"), STAT_DSM_ComputeLanes, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AddSplineMesh"), STAT_DSM_AddSplineMesh, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RotateSplineMesh"), STAT_DSM_RotateSplineMesh, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BuildCollision"), STAT_DSM_BuildCollision, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BuildScatter"), STAT_DSM_BuildScatter, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+
+#pragma endregion
+
+#pragma region Counters
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground traces"), STAT_DSM_GroundTraces, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Components created"), STAT_DSM_ComponentsCreated, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Components destroyed"), STAT_DSM_ComponentsDestroyed, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Components alive"), STAT_DSM_ComponentsAlive, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Layout cache hits"), STAT_DSM_LayoutCacheHits, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Layout cache misses"), STAT_DSM_LayoutCacheMisses, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Collision chunks rebuilt"), STAT_DSM_CollisionChunksRebuilt, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Collision shapes"), STAT_DSM_CollisionShapes, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scattered props"), STAT_DSM_ScatteredProps, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Net checksum mismatches"), STAT_DSM_NetChecksumMismatches, STATGROUP_DynamicSplineMesh, DYNAMICSPLINEMESH_API);
+
+#pragma endregion
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(DYNAMICSPLINEMESH_API, DynamicSplineMesh);
+
+/*
+ * Time the current scope in the DynamicSplineMesh stat group
+ * The same scope is emitted as an Unreal Insights event and as a CSV profiler stat
+ */
+#define DSM_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_DSM_##Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(DynamicSplineMesh_##Name); \
+	CSV_SCOPED_TIMING_STAT(DynamicSplineMesh, Name)
+
+/* Increment a counter of the DynamicSplineMesh stat group and its CSV profiler stat */
+#define DSM_INC_COUNTER(Name, Amount) \
+	INC_DWORD_STAT_BY(STAT_DSM_##Name, Amount); \
+	CSV_CUSTOM_STAT(DynamicSplineMesh, Name, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate)
+
+/* Timings, in seconds, and counters of the last rebuild of a spline */
+struct FSplineMeshBuildStats
+{
+	/* Time spent to destroy the previous spline meshes */
+	double flushTime = 0.0;
+
+	/* Time spent to snap the spline on the ground */
+	double snapTime = 0.0;
+
+	/* Time spent to make the bridges */
+	double bridgeTime = 0.0;
+
+	/* Time spent to compute the segments */
+	double layoutTime = 0.0;
+
+	/* Time spent to create the spline meshes */
+	double meshesTime = 0.0;
+
+	/* Time spent to rotate the segments, part of the meshes time */
+	double rotateTime = 0.0;
+
+	/* Time spent to fit and update the collision chunks */
+	double collisionTime = 0.0;
+
+	/* Time spent to scatter the props */
+	double scatterTime = 0.0;
+
+	/* Ground traces done to snap the spline on the ground */
+	int snapTraces = 0;
+
+	/* Ground traces done to make the bridges */
+	int bridgeTraces = 0;
+
+	/* Spline mesh components created */
+	int componentsCreated = 0;
+
+	/* Collision chunks whose shapes changed */
+	int collisionChunksRebuilt = 0;
+
+	/* Props scattered along the spline */
+	int scatteredProps = 0;
+
+	/* Platform time of the end of the rebuild */
+	double endTime = 0.0;
+
+	FORCEINLINE double GetTotalTime() const
+	{
+		return flushTime + snapTime + bridgeTime + layoutTime + meshesTime + collisionTime + scatterTime;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "DynamicSplineMeshSubsystem.h"
+
+#include "DynamicSplineMeshActor.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarSpatialIndexCellSize(
+	TEXT("dsm.SpatialIndex.CellSize"),
+	2000.0f,
+	TEXT("Size of a cell of the spatial index of the spline segments, read when a world is created"));
+
+/* Number of queries of a batch below which the batch runs on the calling thread */
+static constexpr int MinParallelQueries = 64;
+
+void UDynamicSplineMeshSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	spatialIndex = FSplineMeshSpatialIndex(CVarSpatialIndexCellSize.GetValueOnGameThread());
+}
+
+void UDynamicSplineMeshSubsystem::Deinitialize()
+{
+	spatialIndex.Empty();
+	actors.Empty();
+	Super::Deinitialize();
+}
+
+void UDynamicSplineMeshSubsystem::UpdateActor(ADynamicSplineMeshActor* _actor)
+{
+	if (!IsValid(_actor)) return;
+
+	TArray<FSplineMeshSpatialEntry> _entries = TArray<FSplineMeshSpatialEntry>();
+	_actor->GatherSpatialEntries(_entries);
+
+	const uint32 _actorId = _actor->GetUniqueID();
+	spatialIndex.SetEntries(_actorId, _entries);
+	actors.Add(_actorId, _actor);
+}
+
+void UDynamicSplineMeshSubsystem::RemoveActor(const ADynamicSplineMeshActor* _actor)
+{
+	if (!_actor) return;
+
+	const uint32 _actorId = _actor->GetUniqueID();
+	spatialIndex.RemoveOwner(_actorId);
+	actors.Remove(_actorId);
+}
+
+bool UDynamicSplineMeshSubsystem::FindNearestSegment(const FVector& _location, const float _maxDistance, FSplineMeshSegmentHit& _hit) const
+{
+	FSplineMeshSpatialHit _spatialHit = FSplineMeshSpatialHit();
+	const bool _found = spatialIndex.FindNearest(_location, _maxDistance, _spatialHit);
+	_hit = _found ? ToSegmentHit(_spatialHit) : FSplineMeshSegmentHit();
+	return _found && _hit.actor;
+}
+
+void UDynamicSplineMeshSubsystem::FindNearestSegments(const TArray<FVector>& _locations, const float _maxDistance, TArray<FSplineMeshSegmentHit>& _hits) const
+{
+	// Only query the index in the workers, the weak pointers of the actors are resolved on this thread
+	TArray<FSplineMeshSpatialHit> _spatialHits = TArray<FSplineMeshSpatialHit>();
+	_spatialHits.SetNum(_locations.Num());
+	ParallelFor(_locations.Num(), [&](const int32 _locationIndex)
+	{
+		FSplineMeshSpatialHit& _spatialHit = _spatialHits[_locationIndex];
+		if (!spatialIndex.FindNearest(_locations[_locationIndex], _maxDistance, _spatialHit)) _spatialHit = FSplineMeshSpatialHit();
+	}, _locations.Num() < MinParallelQueries);
+
+	ToSegmentHits(_spatialHits, _hits);
+}
+
+void UDynamicSplineMeshSubsystem::OverlapSegments(const FVector& _center, const float _radius, TArray<FSplineMeshSegmentHit>& _hits) const
+{
+	TArray<FSplineMeshSpatialHit> _spatialHits = TArray<FSplineMeshSpatialHit>();
+	spatialIndex.Overlap(_center, _radius, _spatialHits);
+
+	_hits.Reset(_spatialHits.Num());
+	for (const FSplineMeshSpatialHit& _spatialHit : _spatialHits)
+	{
+		const FSplineMeshSegmentHit& _hit = ToSegmentHit(_spatialHit);
+		if (_hit.actor) _hits.Add(_hit);
+	}
+}
+
+bool UDynamicSplineMeshSubsystem::RaycastSegment(const FVector& _start, const FVector& _end, FSplineMeshSegmentHit& _hit) const
+{
+	FSplineMeshSpatialHit _spatialHit = FSplineMeshSpatialHit();
+	const bool _found = spatialIndex.Raycast(_start, _end, _spatialHit);
+	_hit = _found ? ToSegmentHit(_spatialHit) : FSplineMeshSegmentHit();
+	return _found && _hit.actor;
+}
+
+void UDynamicSplineMeshSubsystem::RaycastSegments(const TArray<FVector>& _starts, const TArray<FVector>& _ends, TArray<FSplineMeshSegmentHit>& _hits) const
+{
+	const int _raysCount = FMath::Min(_starts.Num(), _ends.Num());
+	// Only query the index in the workers, the weak pointers of the actors are resolved on this thread
+	TArray<FSplineMeshSpatialHit> _spatialHits = TArray<FSplineMeshSpatialHit>();
+	_spatialHits.SetNum(_raysCount);
+	ParallelFor(_raysCount, [&](const int32 _rayIndex)
+	{
+		FSplineMeshSpatialHit& _spatialHit = _spatialHits[_rayIndex];
+		if (!spatialIndex.Raycast(_starts[_rayIndex], _ends[_rayIndex], _spatialHit)) _spatialHit = FSplineMeshSpatialHit();
+	}, _raysCount < MinParallelQueries);
+
+	ToSegmentHits(_spatialHits, _hits);
+}
+
+FSplineMeshSegmentHit UDynamicSplineMeshSubsystem::ToSegmentHit(const FSplineMeshSpatialHit& _hit) const
+{
+	FSplineMeshSegmentHit _segmentHit = FSplineMeshSegmentHit();
+	const TWeakObjectPtr<ADynamicSplineMeshActor>* _actor = actors.Find(_hit.ownerId);
+	_segmentHit.actor = _actor ? _actor->Get() : nullptr;
+	_segmentHit.segmentIndex = _hit.segmentIndex;
+	_segmentHit.location = _hit.location;
+	_segmentHit.distance = _hit.distance;
+	_segmentHit.distanceAlongSpline = _hit.distanceAlongSpline;
+	return _segmentHit;
+}
+void UDynamicSplineMeshSubsystem::ToSegmentHits(const TArray<FSplineMeshSpatialHit>& _spatialHits, TArray<FSplineMeshSegmentHit>& _hits) const
+{
+	// A query without segment keeps a hit without actor
+	const int _hitsCount = _spatialHits.Num();
+	_hits.SetNum(_hitsCount);
+	for (int _hitIndex = 0; _hitIndex < _hitsCount; _hitIndex++)
+	{
+		const FSplineMeshSpatialHit& _spatialHit = _spatialHits[_hitIndex];
+		_hits[_hitIndex] = _spatialHit.segmentIndex != INDEX_NONE ? ToSegmentHit(_spatialHit) : FSplineMeshSegmentHit();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SplineMeshSpatialIndex.h"
+#include "DynamicSplineMeshSubsystem.generated.h"
+
+class ADynamicSplineMeshActor;
+
+/* A segment found by a query of the spline mesh subsystem */
+USTRUCT(BlueprintType)
+struct FSplineMeshSegmentHit
+{
+	GENERATED_BODY()
+
+	/* The actor owning the segment, null when nothing was found */
+	UPROPERTY(BlueprintReadOnly, Category = "Segment hit")
+		ADynamicSplineMeshActor* actor = nullptr;
+
+	/* Index of the segment in the layout of the actor */
+	UPROPERTY(BlueprintReadOnly, Category = "Segment hit")
+		int32 segmentIndex = INDEX_NONE;
+
+	/* Closest point of the segment, or the entry point of a ray */
+	UPROPERTY(BlueprintReadOnly, Category = "Segment hit")
+		FVector location = FVector::ZeroVector;
+
+	/* Distance from the query to the location */
+	UPROPERTY(BlueprintReadOnly, Category = "Segment hit")
+		float distance = 0.0f;
+
+	/* Distance along the spline of the location */
+	UPROPERTY(BlueprintReadOnly, Category = "Segment hit")
+		float distanceAlongSpline = 0.0f;
+
+	FSplineMeshSegmentHit() {}
+};
+
+/*
+ * Spatial index of the generated segments of every spline actor of the world
+ * Each actor updates its segments when it rebuilds, the queries can be used from C++ and Blueprint
+ */
+UCLASS()
+class DYNAMICSPLINEMESH_API UDynamicSplineMeshSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/* The segments of all the actors */
+	FSplineMeshSpatialIndex spatialIndex = FSplineMeshSpatialIndex();
+
+	/* The indexed actors by unique id */
+	TMap<uint32, TWeakObjectPtr<ADynamicSplineMeshActor>> actors = TMap<uint32, TWeakObjectPtr<ADynamicSplineMeshActor>>();
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/* Replace the segments of an actor with its current layout */
+	void UpdateActor(ADynamicSplineMeshActor* _actor);
+
+	/* Remove the segments of an actor */
+	void RemoveActor(const ADynamicSplineMeshActor* _actor);
+
+	FORCEINLINE const FSplineMeshSpatialIndex& GetSpatialIndex() const
+	{
+		return spatialIndex;
+	}
+
+	#pragma region Queries
+
+	/* Find the segment closest to a location, within a max distance */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic spline mesh")
+		bool FindNearestSegment(const FVector& _location, const float _maxDistance, FSplineMeshSegmentHit& _hit) const;
+
+	/* Find the segment closest to each location, the hit of a location without segment has no actor */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic spline mesh")
+		void FindNearestSegments(const TArray<FVector>& _locations, const float _maxDistance, TArray<FSplineMeshSegmentHit>& _hits) const;
+
+	/* Find the segments overlapping a sphere, sorted by distance */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic spline mesh")
+		void OverlapSegments(const FVector& _center, const float _radius, TArray<FSplineMeshSegmentHit>& _hits) const;
+
+	/* Find the first segment crossed by a ray */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic spline mesh")
+		bool RaycastSegment(const FVector& _start, const FVector& _end, FSplineMeshSegmentHit& _hit) const;
+
+	/* Find the first segment crossed by each ray, the hit of a ray without segment has no actor */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic spline mesh")
+		void RaycastSegments(const TArray<FVector>& _starts, const TArray<FVector>& _ends, TArray<FSplineMeshSegmentHit>& _hits) const;
+
+	#pragma endregion
+
+private:
+	/* Convert a hit of the index to a hit with its actor */
+	FSplineMeshSegmentHit ToSegmentHit(const FSplineMeshSpatialHit& _hit) const;
+
+	/* Convert the hits of a batch of queries, on the calling thread, a hit of the index without segment gives a hit without actor */
+	void ToSegmentHits(const TArray<FSplineMeshSpatialHit>& _spatialHits, TArray<FSplineMeshSegmentHit>& _hits) const;
+};
\ No newline at end of file
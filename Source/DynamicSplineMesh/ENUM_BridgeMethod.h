@@ -0,0 +1,10 @@
+#pragma once
+
+/* */
+UENUM(BlueprintType)
+enum EBridgeMethod
+{
+	MIDDLE_POINT UMETA(DisplayName = "Middle point"),
+	CATENARY UMETA(DisplayName = "Catenary"),
+	PARABOLA UMETA(DisplayName = "Parabola")
+};
\ No newline at end of file
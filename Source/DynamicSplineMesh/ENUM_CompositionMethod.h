@@ -6,5 +6,6 @@ enum ECompositionMethod
 {
 	FILL UMETA(DisplayName = "Fill"),
 	USUAL UMETA(DisplayName = "Usual"),
-	RANDOM UMETA(DisplayName = "Random")
+	RANDOM UMETA(DisplayName = "Random"),
+	PATTERN UMETA(DisplayName = "Pattern")
 };
\ No newline at end of file
@@ -0,0 +1,10 @@
+#pragma once
+
+/* The simplified collision generated for the spline meshes */
+UENUM(BlueprintType)
+enum ESplineCollisionMode
+{
+	NO_COLLISION UMETA(DisplayName = "No collision"),
+	BOXES UMETA(DisplayName = "Boxes"),
+	CONVEX UMETA(DisplayName = "Convex")
+};
\ No newline at end of file
@@ -18,6 +18,13 @@ struct FMeshComposition
 	/* The scale of the mesh that makes up the spline */
 	UPROPERTY(EditAnywhere, Category = "Mesh composition", meta = (ClampMin = "0.0", ClampMax = "10000.0", EditCondition = "useScaleFactor", EditConditionHides))
 		float scaleFactor = 1.0f;
-	
+
+	/*
+	 * Cheaper mesh used by the distant levels of detail
+	 * The mesh is kept when it is not set
+	 */
+	UPROPERTY(EditAnywhere, Category = "Mesh composition")
+		UStaticMesh* lodMesh = nullptr;
+
 	FMeshComposition() {}
 };
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+#include "STRUCT_SplineMeshGenerateResult.generated.h"
+
+/* Result of an async generation of the spline meshes */
+USTRUCT(BlueprintType)
+struct FSplineMeshGenerateResult
+{
+	GENERATED_BODY()
+
+	/* The generation was cancelled before all the spline meshes were created */
+	UPROPERTY(BlueprintReadOnly, Category = "Generate result")
+		bool cancelled = false;
+
+	/* Number of segments of the generated layout */
+	UPROPERTY(BlueprintReadOnly, Category = "Generate result")
+		int segmentCount = 0;
+
+	/* Time spent on the game thread to flush the meshes, snap the spline and make the bridges, in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Generate result")
+		float prepareTime = 0.0f;
+
+	/* Time spent to compute the segments, in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Generate result")
+		float layoutTime = 0.0f;
+
+	/* Time spent on the game thread to create the spline meshes and their collision, in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Generate result")
+		float applyTime = 0.0f;
+
+	/* Time from the start of the generation to its end, frames included, in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Generate result")
+		float totalTime = 0.0f;
+
+	FSplineMeshGenerateResult() {}
+};
\ No newline at end of file
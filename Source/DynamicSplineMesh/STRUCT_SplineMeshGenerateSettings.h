@@ -0,0 +1,25 @@
+#pragma once
+#include "STRUCT_SplineMeshGenerateSettings.generated.h"
+
+/* Settings of an async generation of the spline meshes */
+USTRUCT(BlueprintType)
+struct FSplineMeshGenerateSettings
+{
+	GENERATED_BODY()
+
+	/*
+	 * Compute the segments on a worker thread
+	 * The ground checks and the spline meshes stay on the game thread
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generate settings")
+		bool computeOnWorker = true;
+
+	/*
+	 * Number of spline meshes created per frame
+	 * Lower values spread the creation over more frames
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generate settings", meta = (ClampMin = "1", ClampMax = "4096"))
+		int meshesPerFrame = 32;
+
+	FSplineMeshGenerateSettings() {}
+};
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+#include "STRUCT_SplineMeshLOD.generated.h"
+
+/* A level of detail applied to the spline meshes from a distance */
+USTRUCT(BlueprintType)
+struct FSplineMeshLOD
+{
+	GENERATED_BODY()
+
+	/* Distance to the camera from which this level of detail is used */
+	UPROPERTY(EditAnywhere, Category = "Spline | LOD", meta = (ClampMin = "0.0"))
+		float distance = 5000.0f;
+
+	/* Merge the meshes of a chunk into a single stretched mesh */
+	UPROPERTY(EditAnywhere, Category = "Spline | LOD")
+		bool mergeSegments = true;
+
+	/* Use the LOD mesh of the mesh composition when it is set */
+	UPROPERTY(EditAnywhere, Category = "Spline | LOD")
+		bool useLODMesh = true;
+	
+	FSplineMeshLOD() {}
+};
\ No newline at end of file
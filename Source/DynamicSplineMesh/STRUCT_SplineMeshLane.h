@@ -0,0 +1,77 @@
+#pragma once
+#include "ENUM_CompositionMethod.h"
+#include "ENUM_PlacementMethod.h"
+#include "STRUCT_MeshComposition.h"
+#include "STRUCT_SplineMeshLane.generated.h"
+
+/*
+ * Meshes placed along the spline at an offset, like the guardrails of a road
+ * Every lane reads the frames and the ground profile of the spline, nothing is traced again
+ */
+USTRUCT(BlueprintType)
+struct FSplineMeshLane
+{
+	GENERATED_BODY()
+
+	/* Offset of the lane to the right of the spline, negative on the left */
+	UPROPERTY(EditAnywhere, Category = "Spline | Lanes")
+		float lateralOffset = 0.0f;
+
+	/* Offset of the lane above the spline */
+	UPROPERTY(EditAnywhere, Category = "Spline | Lanes")
+		float verticalOffset = 0.0f;
+
+	/* The composition method of the lane */
+	UPROPERTY(EditAnywhere, Category = "Spline | Lanes")
+		TEnumAsByte<ECompositionMethod> compositionMethod = TEnumAsByte<ECompositionMethod>();
+
+	/*
+	 * The mesh composition used for the lane
+	 * Is active only when the composition method is set to "Fill"
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Lanes", meta = (EditCondition = "compositionMethod == ECompositionMethod::FILL", EditConditionHides))
+		FMeshComposition meshComposition = FMeshComposition();
+
+	/*
+	 * The array of meshes composition used for the lane
+	 * Is active only when the composition method is set to "USUAL", "RANDOM" or "PATTERN"
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Lanes", meta = (EditCondition = "compositionMethod != ECompositionMethod::FILL", EditConditionHides))
+		TArray<FMeshComposition> meshesComposition = TArray<FMeshComposition>();
+
+	/* The meshes placed once before the pattern of the lane */
+	UPROPERTY(EditAnywhere, Category = "Spline | Lanes", meta = (EditCondition = "compositionMethod == ECompositionMethod::PATTERN", EditConditionHides))
+		TArray<FMeshComposition> startCapComposition = TArray<FMeshComposition>();
+
+	/* The meshes placed once after the pattern of the lane */
+	UPROPERTY(EditAnywhere, Category = "Spline | Lanes", meta = (EditCondition = "compositionMethod == ECompositionMethod::PATTERN", EditConditionHides))
+		TArray<FMeshComposition> endCapComposition = TArray<FMeshComposition>();
+
+	/* The placement method of the lane */
+	UPROPERTY(EditAnywhere, Category = "Spline | Lanes")
+		TEnumAsByte<EPlacementMethod> placementMethod = TEnumAsByte<EPlacementMethod>();
+
+	/*
+	 * The gap between the meshes of the lane
+	 * Is active only if the placement method is set to "Duplicate"
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Lanes", meta = (EditCondition = "placementMethod == EPlacementMethod::DUPLICATE", EditConditionHides))
+		float gap = 0.0f;
+
+	FSplineMeshLane() {}
+
+	/*
+	 * Get the mesh composition of an entry of the plan of the lane
+	 * The indexes of the caps follow the ones of the meshes composition, the start cap first
+	 */
+	const FMeshComposition& GetPlanComposition(const int _compositionIndex) const
+	{
+		if (meshesComposition.IsValidIndex(_compositionIndex)) return meshesComposition[_compositionIndex];
+
+		const int _startCapIndex = _compositionIndex - meshesComposition.Num();
+		if (startCapComposition.IsValidIndex(_startCapIndex)) return startCapComposition[_startCapIndex];
+
+		const int _endCapIndex = _startCapIndex - startCapComposition.Num();
+		return endCapComposition.IsValidIndex(_endCapIndex) ? endCapComposition[_endCapIndex] : meshComposition;
+	}
+};
\ No newline at end of file
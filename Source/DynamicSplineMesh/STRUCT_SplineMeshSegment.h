@@ -0,0 +1,46 @@
+#pragma once
+#include "STRUCT_MeshComposition.h"
+#include "STRUCT_SplineMeshValues.h"
+#include "STRUCT_SplineMeshSegment.generated.h"
+
+/* A mesh placed on the spline */
+USTRUCT(BlueprintType)
+struct FSplineMeshSegment
+{
+	GENERATED_BODY()
+
+	/* The mesh composition used by the segment */
+	UPROPERTY()
+		FMeshComposition meshComposition = FMeshComposition();
+
+	/* The start and end values of the segment */
+	UPROPERTY()
+		FSplineMeshValues values = FSplineMeshValues();
+
+	/* The index of the segment on the spline */
+	UPROPERTY()
+		int index = 0;
+
+	/* The distance along the spline where the segment starts */
+	UPROPERTY()
+		float startDistance = 0.0f;
+
+	/* The distance along the spline where the segment ends */
+	UPROPERTY()
+		float endDistance = 0.0f;
+
+	/* The lane of the segment, 0 for the spline itself and N for the lane N - 1 */
+	UPROPERTY()
+		int lane = 0;
+	
+	FSplineMeshSegment() {}
+
+	FSplineMeshSegment(const FMeshComposition& _meshComposition, const FSplineMeshValues& _values, const int _index, const float _startDistance = 0.0f, const float _endDistance = 0.0f)
+	{
+		meshComposition = _meshComposition;
+		values = _values;
+		index = _index;
+		startDistance = _startDistance;
+		endDistance = _endDistance;
+	}
+};
\ No newline at end of file
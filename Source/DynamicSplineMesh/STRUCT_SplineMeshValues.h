@@ -24,6 +24,10 @@ struct FSplineMeshValues
 
 	UPROPERTY()
 		FVector2D endScale = FVector2D(0.0f);
+
+	/* The roll of the mesh around the spline, in radians */
+	UPROPERTY()
+		float roll = 0.0f;
 	
 	FSplineMeshValues() {}
 
@@ -0,0 +1,223 @@
+#pragma once
+#include "Engine/NetSerialization.h"
+#include "Components/SplineComponent.h"
+#include "STRUCT_MeshRotation.h"
+#include "STRUCT_SplineNetDefinition.generated.h"
+
+/*
+ * Compact definition of a spline built at runtime
+ * Replicated instead of its meshes, the clients regenerate the same layout from it
+ * The meshes are not part of it, the clients check them against the hash of the server inputs
+ */
+USTRUCT()
+struct FSplineNetDefinition
+{
+	GENERATED_BODY()
+
+	/* Max number of points accepted from the network */
+	static constexpr uint32 MaxPoints = 4096;
+
+	/* Max number of mesh rotations accepted from the network */
+	static constexpr uint32 MaxRotations = 65536;
+
+	/* Local positions of the spline points, quantized to a tenth of unit */
+	UPROPERTY()
+		TArray<FVector> points = TArray<FVector>();
+
+	/* Type of each spline point */
+	UPROPERTY()
+		TArray<uint8> pointTypes = TArray<uint8>();
+
+	/* Tangents of the spline points, only sent for the points with custom tangents, the others are computed from the positions */
+	UPROPERTY()
+		TArray<FVector> arriveTangents = TArray<FVector>();
+
+	UPROPERTY()
+		TArray<FVector> leaveTangents = TArray<FVector>();
+
+	/* Whether a spline point is rotated or scaled, the rotations and the scales are only sent then */
+	UPROPERTY()
+		bool hasPointTransforms = false;
+
+	UPROPERTY()
+		TArray<FRotator> rotations = TArray<FRotator>();
+
+	UPROPERTY()
+		TArray<FVector> scales = TArray<FVector>();
+
+	UPROPERTY()
+		bool closedLoop = false;
+
+	UPROPERTY()
+		uint8 compositionMethod = 0;
+
+	UPROPERTY()
+		uint8 placementMethod = 0;
+
+	UPROPERTY()
+		uint8 rotationMethod = 0;
+
+	UPROPERTY()
+		uint8 rotationAxis = 0;
+
+	/* Angle of the mesh rotation, quantized to 16 bits */
+	UPROPERTY()
+		float rotationAngle = 0.0f;
+
+	/* Rotation of each mesh, only sent when the rotation method reads it */
+	UPROPERTY()
+		TArray<FMeshRotation> meshesRotation = TArray<FMeshRotation>();
+
+	UPROPERTY()
+		float gap = 0.0f;
+
+	/* Distances along the spline of the bridges made by the server */
+	UPROPERTY()
+		TArray<FVector2D> bridgeRanges = TArray<FVector2D>();
+
+	/* Seed of the random composition */
+	UPROPERTY()
+		int32 seed = 0;
+
+	/* Hash of the inputs of the server that are not sent, the compositions, the lanes and the decks */
+	UPROPERTY()
+		uint32 inputsHash = 0;
+
+	/* Checksum of the segments generated by the server, compared by the clients after their own generation */
+	UPROPERTY()
+		uint32 checksum = 0;
+
+	FSplineNetDefinition() {}
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		bOutSuccess = true;
+
+		// Points
+		uint32 _pointsCount = points.Num();
+		Ar.SerializeIntPacked(_pointsCount);
+		if (Ar.IsLoading())
+		{
+			if (_pointsCount > MaxPoints)
+			{
+				Ar.SetError();
+				bOutSuccess = false;
+				return false;
+			}
+
+			points.SetNum(_pointsCount);
+			pointTypes.SetNum(_pointsCount);
+			arriveTangents.SetNum(_pointsCount);
+			leaveTangents.SetNum(_pointsCount);
+		}
+
+		for (uint32 _pointIndex = 0; _pointIndex < _pointsCount; _pointIndex++)
+		{
+			bOutSuccess &= SerializePackedVector<10, 24>(points[_pointIndex], Ar);
+			Ar.SerializeBits(&pointTypes[_pointIndex], 3);
+			if (pointTypes[_pointIndex] != ESplinePointType::CurveCustomTangent) continue;
+
+			bOutSuccess &= SerializePackedVector<10, 24>(arriveTangents[_pointIndex], Ar);
+			bOutSuccess &= SerializePackedVector<10, 24>(leaveTangents[_pointIndex], Ar);
+		}
+
+		// Rotations and scales of the points
+		uint8 _hasPointTransforms = hasPointTransforms ? 1 : 0;
+		Ar.SerializeBits(&_hasPointTransforms, 1);
+		hasPointTransforms = _hasPointTransforms != 0;
+		if (Ar.IsLoading())
+		{
+			rotations.SetNum(hasPointTransforms ? _pointsCount : 0);
+			scales.SetNum(hasPointTransforms ? _pointsCount : 0);
+		}
+
+		if (hasPointTransforms)
+		{
+			for (uint32 _pointIndex = 0; _pointIndex < _pointsCount; _pointIndex++)
+			{
+				rotations[_pointIndex].SerializeCompressedShort(Ar);
+				bOutSuccess &= SerializePackedVector<100, 20>(scales[_pointIndex], Ar);
+			}
+		}
+
+		// Methods, a few bits each
+		uint8 _closedLoop = closedLoop ? 1 : 0;
+		Ar.SerializeBits(&_closedLoop, 1);
+		closedLoop = _closedLoop != 0;
+		Ar.SerializeBits(&compositionMethod, 2);
+		Ar.SerializeBits(&placementMethod, 2);
+		Ar.SerializeBits(&rotationMethod, 3);
+		Ar.SerializeBits(&rotationAxis, 2);
+
+		uint16 _rotationAngle = FRotator::CompressAxisToShort(rotationAngle);
+		Ar << _rotationAngle;
+		rotationAngle = FRotator::DecompressAxisFromShort(_rotationAngle);
+
+		// Rotation of each mesh
+		uint32 _rotationsCount = meshesRotation.Num();
+		Ar.SerializeIntPacked(_rotationsCount);
+		if (Ar.IsLoading())
+		{
+			if (_rotationsCount > MaxRotations)
+			{
+				Ar.SetError();
+				bOutSuccess = false;
+				return false;
+			}
+
+			meshesRotation.SetNum(_rotationsCount);
+		}
+
+		for (FMeshRotation& _meshRotation : meshesRotation)
+		{
+			uint8 _axisRotation = static_cast<uint8>(_meshRotation.axisRotation.GetValue());
+			Ar.SerializeBits(&_axisRotation, 2);
+			_meshRotation.axisRotation = static_cast<EAxisRotation>(_axisRotation);
+
+			uint16 _angle = FRotator::CompressAxisToShort(_meshRotation.angle);
+			Ar << _angle;
+			_meshRotation.angle = FRotator::DecompressAxisFromShort(_angle);
+		}
+
+		Ar << gap;
+
+		// Bridges
+		uint32 _bridgesCount = bridgeRanges.Num();
+		Ar.SerializeIntPacked(_bridgesCount);
+		if (Ar.IsLoading())
+		{
+			if (_bridgesCount > MaxPoints)
+			{
+				Ar.SetError();
+				bOutSuccess = false;
+				return false;
+			}
+
+			bridgeRanges.SetNum(_bridgesCount);
+		}
+
+		for (FVector2D& _bridgeRange : bridgeRanges)
+		{
+			float _start = _bridgeRange.X;
+			float _end = _bridgeRange.Y;
+			Ar << _start << _end;
+			_bridgeRange = FVector2D(_start, _end);
+		}
+
+		uint32 _seed = static_cast<uint32>(seed);
+		Ar.SerializeIntPacked(_seed);
+		seed = static_cast<int32>(_seed);
+
+		Ar << inputsHash << checksum;
+		return bOutSuccess;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FSplineNetDefinition> : public TStructOpsTypeTraitsBase2<FSplineNetDefinition>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
\ No newline at end of file
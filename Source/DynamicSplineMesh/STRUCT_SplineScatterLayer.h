@@ -0,0 +1,70 @@
+#pragma once
+#include "STRUCT_SplineScatterLayer.generated.h"
+
+/* Props scattered along the spline as instances of a mesh */
+USTRUCT(BlueprintType)
+struct FSplineScatterLayer
+{
+	GENERATED_BODY()
+
+	/* The mesh of the props */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter")
+		UStaticMesh* mesh = nullptr;
+
+	/* Distance along the spline between two props */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter", meta = (ClampMin = "1.0"))
+		float spacing = 500.0f;
+
+	/* Distance along the spline of the first prop */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter", meta = (ClampMin = "0.0"))
+		float startOffset = 0.0f;
+
+	/* Random offset of each prop along the spline, in both directions */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter", meta = (ClampMin = "0.0"))
+		float jitter = 0.0f;
+
+	/* Offset of the props to the side of the spline */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter")
+		float lateralOffset = 0.0f;
+
+	/* Random offset of each prop to the side of the spline, in both directions */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter", meta = (ClampMin = "0.0"))
+		float lateralJitter = 0.0f;
+
+	/* Random yaw of each prop, in degrees in both directions */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter", meta = (ClampMin = "0.0", ClampMax = "180.0"))
+		float yawJitter = 0.0f;
+
+	/* Random uniform scale of each prop, between the min and the max */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter")
+		FVector2D scaleRange = FVector2D(1.0f, 1.0f);
+
+	/*
+	 * Follow the normal of the ground traced under each prop, on the ground layers of the spline
+	 * The props follow the slope of the spline where no ground is hit, and stay upright otherwise
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter")
+		bool alignToGround = false;
+
+	/* Skip the props placed on the bridges of the spline */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter")
+		bool excludeBridges = true;
+
+	/* Distance kept free of props around each end of a bridge */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter", meta = (ClampMin = "0.0", EditCondition = "excludeBridges", EditConditionHides))
+		float bridgeMargin = 100.0f;
+
+	/* Seed of the random values, the same seed places the same props */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter")
+		int seed = 0;
+
+	/* Enable the collision of the props */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter")
+		bool useCollision = false;
+
+	/* Distance from which the props are culled, 0 to never cull them */
+	UPROPERTY(EditAnywhere, Category = "Spline | Scatter", meta = (ClampMin = "0.0"))
+		float cullDistance = 0.0f;
+
+	FSplineScatterLayer() {}
+};
\ No newline at end of file
@@ -0,0 +1,300 @@
+#pragma once
+#include "SplineLayoutMath.h"
+#include "HermiteSpline.h"
+#include <algorithm>
+#include <vector>
+
+#if defined(SPLINE_LAYOUT_NO_SIMD)
+// The scalar fallback, used as the reference of the SIMD targets
+#elif defined(__AVX__)
+#include <immintrin.h>
+#define SPLINE_LAYOUT_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPLINE_LAYOUT_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SPLINE_LAYOUT_NEON 1
+#endif
+
+namespace SplineLayout
+{
+	/*
+	 * Four doubles computed together
+	 * One AVX register, two SSE2 or NEON registers, or a plain array on the other targets
+	 */
+	struct Double4
+	{
+#if defined(SPLINE_LAYOUT_AVX)
+		__m256d value;
+
+		Double4(const __m256d _value) : value(_value) { }
+		static Double4 Load(const double* _values) { return Double4(_mm256_loadu_pd(_values)); }
+		static Double4 Set(const double _a, const double _b, const double _c, const double _d) { return Double4(_mm256_setr_pd(_a, _b, _c, _d)); }
+		static Double4 Splat(const double _value) { return Double4(_mm256_set1_pd(_value)); }
+		void Store(double* _values) const { _mm256_storeu_pd(_values, value); }
+
+		Double4 operator+(const Double4& _other) const { return Double4(_mm256_add_pd(value, _other.value)); }
+		Double4 operator*(const Double4& _other) const { return Double4(_mm256_mul_pd(value, _other.value)); }
+#elif defined(SPLINE_LAYOUT_SSE2)
+		__m128d low;
+		__m128d high;
+
+		Double4(const __m128d _low, const __m128d _high) : low(_low), high(_high) { }
+		static Double4 Load(const double* _values) { return Double4(_mm_loadu_pd(_values), _mm_loadu_pd(_values + 2)); }
+		static Double4 Set(const double _a, const double _b, const double _c, const double _d) { return Double4(_mm_setr_pd(_a, _b), _mm_setr_pd(_c, _d)); }
+		static Double4 Splat(const double _value) { return Double4(_mm_set1_pd(_value), _mm_set1_pd(_value)); }
+		void Store(double* _values) const { _mm_storeu_pd(_values, low); _mm_storeu_pd(_values + 2, high); }
+
+		Double4 operator+(const Double4& _other) const { return Double4(_mm_add_pd(low, _other.low), _mm_add_pd(high, _other.high)); }
+		Double4 operator*(const Double4& _other) const { return Double4(_mm_mul_pd(low, _other.low), _mm_mul_pd(high, _other.high)); }
+#elif defined(SPLINE_LAYOUT_NEON)
+		float64x2_t low;
+		float64x2_t high;
+
+		Double4(const float64x2_t _low, const float64x2_t _high) : low(_low), high(_high) { }
+		static Double4 Load(const double* _values) { return Double4(vld1q_f64(_values), vld1q_f64(_values + 2)); }
+		static Double4 Set(const double _a, const double _b, const double _c, const double _d)
+		{
+			const double _values[4] = { _a, _b, _c, _d };
+			return Load(_values);
+		}
+		static Double4 Splat(const double _value) { return Double4(vdupq_n_f64(_value), vdupq_n_f64(_value)); }
+		void Store(double* _values) const { vst1q_f64(_values, low); vst1q_f64(_values + 2, high); }
+
+		Double4 operator+(const Double4& _other) const { return Double4(vaddq_f64(low, _other.low), vaddq_f64(high, _other.high)); }
+		Double4 operator*(const Double4& _other) const { return Double4(vmulq_f64(low, _other.low), vmulq_f64(high, _other.high)); }
+#else
+		double value[4];
+
+		static Double4 Load(const double* _values) { return Set(_values[0], _values[1], _values[2], _values[3]); }
+		static Double4 Set(const double _a, const double _b, const double _c, const double _d) { return Double4 { { _a, _b, _c, _d } }; }
+		static Double4 Splat(const double _value) { return Set(_value, _value, _value, _value); }
+		void Store(double* _values) const { std::copy(value, value + 4, _values); }
+
+		Double4 operator+(const Double4& _other) const { return Set(value[0] + _other.value[0], value[1] + _other.value[1], value[2] + _other.value[2], value[3] + _other.value[3]); }
+		Double4 operator*(const Double4& _other) const { return Set(value[0] * _other.value[0], value[1] * _other.value[1], value[2] * _other.value[2], value[3] * _other.value[3]); }
+#endif
+	};
+
+	/* Locations and tangents of a batch of queries, one array per component */
+	struct SplineSamples
+	{
+		std::vector<double> x = std::vector<double>();
+		std::vector<double> y = std::vector<double>();
+		std::vector<double> z = std::vector<double>();
+		std::vector<double> tangentX = std::vector<double>();
+		std::vector<double> tangentY = std::vector<double>();
+		std::vector<double> tangentZ = std::vector<double>();
+
+		void Resize(const size_t _count)
+		{
+			for (std::vector<double>* _component : { &x, &y, &z, &tangentX, &tangentY, &tangentZ })
+			{
+				_component->resize(_count);
+			}
+		}
+
+		size_t Num() const { return x.size(); }
+		Vector3 GetLocation(const size_t _index) const { return Vector3(x[_index], y[_index], z[_index]); }
+		Vector3 GetTangent(const size_t _index) const { return Vector3(tangentX[_index], tangentY[_index], tangentZ[_index]); }
+	};
+
+	/*
+	 * Evaluates the locations and tangents of a spline for a batch of distances or keys, four queries at a time
+	 * The segments are converted to cubic polynomials once so the three interpolation modes share the same code
+	 * The distances are walked in order, sorted queries find their sample without a search
+	 * The spline must outlive the evaluator
+	 */
+	class BatchEvaluator
+	{
+		/* The evaluated spline */
+		const HermiteSpline& spline;
+
+		/* Coefficients of the segments per axis, location(alpha) = ((a * alpha + b) * alpha + c) * alpha + d */
+		std::vector<double> a[3];
+		std::vector<double> b[3];
+		std::vector<double> c[3];
+		std::vector<double> d[3];
+
+		/* Segment and alpha in this segment of each query of the current batch */
+		std::vector<int> segmentIndexes = std::vector<int>();
+		std::vector<double> alphas = std::vector<double>();
+
+	public:
+		explicit BatchEvaluator(const HermiteSpline& _spline) : spline(_spline)
+		{
+			const int _segmentCount = spline.GetSegmentCount();
+			for (int _axis = 0; _axis < 3; _axis++)
+			{
+				a[_axis].resize(_segmentCount);
+				b[_axis].resize(_segmentCount);
+				c[_axis].resize(_segmentCount);
+				d[_axis].resize(_segmentCount);
+			}
+
+			for (int _segmentIndex = 0; _segmentIndex < _segmentCount; _segmentIndex++)
+			{
+				const SplinePoint& _start = spline.GetPoint(_segmentIndex);
+				const SplinePoint& _end = spline.GetPoint((_segmentIndex + 1) % spline.GetPointCount());
+
+				// Expand the Hermite basis, a linear segment only has a slope and a constant one only its start
+				Vector3 _a = Vector3();
+				Vector3 _b = Vector3();
+				Vector3 _c = Vector3();
+				if (_start.interpMode == InterpMode::Curve)
+				{
+					_a = _start.position * 2.0 + _start.leaveTangent + _end.arriveTangent - _end.position * 2.0;
+					_b = _end.position * 3.0 - _start.position * 3.0 - _start.leaveTangent * 2.0 - _end.arriveTangent;
+					_c = _start.leaveTangent;
+				}
+
+				else if (_start.interpMode == InterpMode::Linear)
+				{
+					_c = _end.position - _start.position;
+				}
+
+				SetCoefficients(_segmentIndex, 0, _a.x, _b.x, _c.x, _start.position.x);
+				SetCoefficients(_segmentIndex, 1, _a.y, _b.y, _c.y, _start.position.y);
+				SetCoefficients(_segmentIndex, 2, _a.z, _b.z, _c.z, _start.position.z);
+			}
+		}
+
+		/* Evaluate a batch of distances along the spline, sorted in increasing order for the best speed */
+		void EvaluateDistances(const double* _distances, const size_t _count, SplineSamples& _samples)
+		{
+			const std::vector<double>& _sampleDistances = spline.GetSampleDistances();
+			const double _length = spline.GetLength();
+			const int _segmentCount = spline.GetSegmentCount();
+			PrepareBatch(_count);
+
+			// Convert the distances to keys like HermiteSpline::GetKeyAtDistance, starting from the sample of the previous query
+			size_t _sampleIndex = 0;
+			for (size_t _index = 0; _index < _count; _index++)
+			{
+				const double _distance = _distances[_index];
+				if (_sampleDistances.size() < 2 || _distance <= 0.0)
+				{
+					SetKey(_index, 0.0);
+					continue;
+				}
+
+				if (_distance >= _length)
+				{
+					SetKey(_index, _segmentCount);
+					continue;
+				}
+
+				// A query before the previous one searches its sample again
+				if (_distance < _sampleDistances[_sampleIndex])
+				{
+					_sampleIndex = static_cast<size_t>(std::upper_bound(_sampleDistances.begin(), _sampleDistances.end(), _distance) - _sampleDistances.begin()) - 1;
+				}
+
+				while (_sampleDistances[_sampleIndex + 1] <= _distance) _sampleIndex++;
+				SetKey(_index, spline.KeyBetweenSamples(_sampleIndex, _distance));
+			}
+
+			Evaluate(_count, _samples);
+		}
+
+		/* Evaluate a batch of keys, in any order */
+		void EvaluateKeys(const double* _keys, const size_t _count, SplineSamples& _samples)
+		{
+			PrepareBatch(_count);
+			for (size_t _index = 0; _index < _count; _index++)
+			{
+				SetKey(_index, _keys[_index]);
+			}
+
+			Evaluate(_count, _samples);
+		}
+
+	private:
+		void SetCoefficients(const int _segmentIndex, const int _axis, const double _a, const double _b, const double _c, const double _d)
+		{
+			a[_axis][_segmentIndex] = _a;
+			b[_axis][_segmentIndex] = _b;
+			c[_axis][_segmentIndex] = _c;
+			d[_axis][_segmentIndex] = _d;
+		}
+
+		void PrepareBatch(const size_t _count)
+		{
+			segmentIndexes.resize(_count);
+			alphas.resize(_count);
+		}
+
+		/* Store the segment and the alpha of a key, clamped like HermiteSpline::GetSegment */
+		void SetKey(const size_t _index, const double _key)
+		{
+			const int _segmentCount = spline.GetSegmentCount();
+			const double _clampedKey = std::clamp(_key, 0.0, static_cast<double>(std::max(_segmentCount, 0)));
+			const int _segmentIndex = std::max(std::min(static_cast<int>(_clampedKey), _segmentCount - 1), 0);
+			segmentIndexes[_index] = _segmentIndex;
+			alphas[_index] = _clampedKey - _segmentIndex;
+		}
+
+		/* Evaluate the polynomials of the prepared queries */
+		void Evaluate(const size_t _count, SplineSamples& _samples) const
+		{
+			_samples.Resize(_count);
+			double* _locations[3] = { _samples.x.data(), _samples.y.data(), _samples.z.data() };
+			double* _tangents[3] = { _samples.tangentX.data(), _samples.tangentY.data(), _samples.tangentZ.data() };
+
+			// A spline without segment is its first point
+			if (spline.GetSegmentCount() == 0)
+			{
+				const bool _hasPoint = spline.GetPointCount() > 0;
+				const Vector3 _location = _hasPoint ? spline.GetPoint(0).position : Vector3();
+				const Vector3 _tangent = _hasPoint ? spline.GetPoint(0).leaveTangent : Vector3();
+				std::fill_n(_locations[0], _count, _location.x);
+				std::fill_n(_locations[1], _count, _location.y);
+				std::fill_n(_locations[2], _count, _location.z);
+				std::fill_n(_tangents[0], _count, _tangent.x);
+				std::fill_n(_tangents[1], _count, _tangent.y);
+				std::fill_n(_tangents[2], _count, _tangent.z);
+				return;
+			}
+
+			// Four queries at a time, the coefficients of their segments are gathered in the lanes
+			const Double4 _two = Double4::Splat(2.0);
+			const Double4 _three = Double4::Splat(3.0);
+			size_t _index = 0;
+			for (; _index + 4 <= _count; _index += 4)
+			{
+				const int* _segments = &segmentIndexes[_index];
+				const Double4 _alpha = Double4::Load(&alphas[_index]);
+				for (int _axis = 0; _axis < 3; _axis++)
+				{
+					const Double4 _a = Gather(a[_axis], _segments);
+					const Double4 _b = Gather(b[_axis], _segments);
+					const Double4 _c = Gather(c[_axis], _segments);
+					const Double4 _d = Gather(d[_axis], _segments);
+					(((_a * _alpha + _b) * _alpha + _c) * _alpha + _d).Store(_locations[_axis] + _index);
+					((_three * _a * _alpha + _two * _b) * _alpha + _c).Store(_tangents[_axis] + _index);
+				}
+			}
+
+			// The remaining queries
+			for (; _index < _count; _index++)
+			{
+				const int _segmentIndex = segmentIndexes[_index];
+				const double _alpha = alphas[_index];
+				for (int _axis = 0; _axis < 3; _axis++)
+				{
+					const double _a = a[_axis][_segmentIndex];
+					const double _b = b[_axis][_segmentIndex];
+					const double _c = c[_axis][_segmentIndex];
+					_locations[_axis][_index] = ((_a * _alpha + _b) * _alpha + _c) * _alpha + d[_axis][_segmentIndex];
+					_tangents[_axis][_index] = (3.0 * _a * _alpha + 2.0 * _b) * _alpha + _c;
+				}
+			}
+		}
+
+		static Double4 Gather(const std::vector<double>& _values, const int* _indexes)
+		{
+			return Double4::Set(_values[_indexes[0]], _values[_indexes[1]], _values[_indexes[2]], _values[_indexes[3]]);
+		}
+	};
+}
\ No newline at end of file
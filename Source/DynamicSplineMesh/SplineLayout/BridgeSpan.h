@@ -0,0 +1,178 @@
+#pragma once
+#include "SplineLayoutMath.h"
+#include <algorithm>
+#include <vector>
+
+namespace SplineLayout
+{
+	/* The curve of a bridge deck between two supports */
+	enum class SagProfile : uint8_t
+	{
+		Catenary,
+		Parabola
+	};
+
+	/*
+	 * Deck of a bridge hanging between its supports, tabulated by distance along the deck
+	 * The profile of each bay is analytic, it is sampled once when the span is built, then a plank is an interpolation between two samples
+	 */
+	class BridgeSpan
+	{
+		/* Location of the samples, the first at the start of the span and the last at its end */
+		std::vector<Vector3> locations = std::vector<Vector3>();
+
+		/* Unit direction of the deck at the samples */
+		std::vector<Vector3> directions = std::vector<Vector3>();
+
+		/* Distance along the deck of the samples */
+		std::vector<double> distances = std::vector<double>();
+
+		/* Number of bays between the supports */
+		int baysCount = 0;
+
+	public:
+		/*
+		 * Sample the deck between two points, split in bays no longer than the support spacing
+		 * Each bay sags by the depth at its middle along the opposite of the up vector, a negative depth makes an arch
+		 */
+		void Build(const Vector3& _start, const Vector3& _end, const Vector3& _up, const double _sag, const SagProfile _profile, const double _supportSpacing, const int _samplesPerBay = 32)
+		{
+			locations.clear();
+			directions.clear();
+			distances.clear();
+
+			const Vector3& _chord = _end - _start;
+			const double _chordLength = _chord.Length();
+			if (_chordLength <= 0.0) return;
+
+			baysCount = _supportSpacing > 0.0 ? std::max(1, static_cast<int>(std::ceil(_chordLength / _supportSpacing))) : 1;
+			const int _samplesCount = std::max(_samplesPerBay, 2);
+			const double _bayLength = _chordLength / baysCount;
+			const Vector3& _chordDirection = _chord / _chordLength;
+
+			// The bays share the same profile, solved once
+			const double _depth = std::abs(_sag);
+			const double _sign = _sag < 0.0 ? -1.0 : 1.0;
+			const double _catenary = _profile == SagProfile::Catenary ? SolveCatenary(_bayLength, _depth) : 0.0;
+
+			locations.reserve(baysCount * _samplesCount + 1);
+			directions.reserve(baysCount * _samplesCount + 1);
+			distances.reserve(baysCount * _samplesCount + 1);
+			for (int _bayIndex = 0; _bayIndex < baysCount; _bayIndex++)
+			{
+				// The last sample of a bay is the first one of the next bay
+				const int _lastSample = _bayIndex == baysCount - 1 ? _samplesCount : _samplesCount - 1;
+				for (int _sampleIndex = 0; _sampleIndex <= _lastSample; _sampleIndex++)
+				{
+					const double _x = _bayLength * _sampleIndex / _samplesCount;
+					double _height = 0.0;
+					double _slope = 0.0;
+					GetProfile(_profile, _bayLength, _depth, _catenary, _x, _height, _slope);
+
+					const Vector3& _location = _start + _chordDirection * (_bayLength * _bayIndex + _x) - _up * (_height * _sign);
+					distances.push_back(locations.empty() ? 0.0 : distances.back() + (_location - locations.back()).Length());
+					locations.push_back(_location);
+					directions.push_back((_chordDirection - _up * (_slope * _sign)).GetSafeNormal());
+				}
+			}
+		}
+
+		/* Get the length of the deck */
+		double GetLength() const
+		{
+			return distances.empty() ? 0.0 : distances.back();
+		}
+
+		/* Get the number of bays between the supports */
+		int GetBaysCount() const
+		{
+			return baysCount;
+		}
+
+		/* Get the location and the unit direction of the deck at a distance along it */
+		void GetAtDistance(const double _distance, Vector3& _location, Vector3& _direction) const
+		{
+			if (locations.empty())
+			{
+				_location = Vector3();
+				_direction = Vector3();
+				return;
+			}
+
+			// Find the samples around the distance
+			const size_t _nextIndex = std::min(static_cast<size_t>(std::upper_bound(distances.begin(), distances.end(), _distance) - distances.begin()), distances.size() - 1);
+			const size_t _index = _nextIndex > 0 ? _nextIndex - 1 : 0;
+			const double _interval = distances[_nextIndex] - distances[_index];
+			const double _alpha = _interval > 0.0 ? std::clamp((_distance - distances[_index]) / _interval, 0.0, 1.0) : 0.0;
+
+			_location = Lerp(locations[_index], locations[_nextIndex], _alpha);
+			_direction = Lerp(directions[_index], directions[_nextIndex], _alpha).GetSafeNormal();
+		}
+
+		/*
+		 * Get the parameter of the catenary of a bay sagging by a depth at its middle, a * (cosh(length / 2a) - 1) = depth
+		 * The depth decreases with the parameter, so it is found by bisection
+		 */
+		static double SolveCatenary(const double _length, const double _depth)
+		{
+			if (_length <= 0.0 || _depth <= 0.0) return 0.0;
+
+			// The deeper bays have the smaller parameters, cosh overflows below length / 1400
+			double _min = _length / 1400.0;
+			double _max = _length * _length / _depth;
+			for (int _iteration = 0; _iteration < 64; _iteration++)
+			{
+				const double _middle = std::sqrt(_min * _max);
+				const double _middleDepth = _middle * (std::cosh(_length / (2.0 * _middle)) - 1.0);
+				if (_middleDepth > _depth) _min = _middle;
+				else _max = _middle;
+			}
+
+			return std::sqrt(_min * _max);
+		}
+
+		/* Get the height under the chord of a bay and its slope at a distance along the chord */
+		static void GetProfile(const SagProfile _profile, const double _length, const double _depth, const double _catenary, const double _x, double& _height, double& _slope)
+		{
+			if (_length <= 0.0 || _depth <= 0.0)
+			{
+				_height = 0.0;
+				_slope = 0.0;
+				return;
+			}
+
+			// The height is 0 at both supports and the depth at the middle
+			if (_profile == SagProfile::Catenary && _catenary > 0.0)
+			{
+				const double _offset = (_x - _length / 2.0) / _catenary;
+				_height = _catenary * (std::cosh(_length / (2.0 * _catenary)) - std::cosh(_offset));
+				_slope = -std::sinh(_offset);
+				return;
+			}
+
+			_height = 4.0 * _depth * _x * (_length - _x) / (_length * _length);
+			_slope = 4.0 * _depth * (_length - 2.0 * _x) / (_length * _length);
+		}
+	};
+
+	/*
+	 * Lay planks along a deck, their count is rounded so that they cover the whole deck
+	 * Calls _addPlank(startDistance, endDistance) for each plank, in the order of the deck
+	 */
+	template <typename AddPlank>
+	void PlaceDeck(const BridgeSpan& _span, const double _plankLength, const double _gap, AddPlank&& _addPlank)
+	{
+		const double _length = _span.GetLength();
+		if (_length <= 0.0 || _plankLength <= 0.0) return;
+
+		const int _planksCount = std::max(1, static_cast<int>(std::lround(_length / (_plankLength + std::max(_gap, 0.0)))));
+		const double _step = _length / _planksCount;
+		const double _plankSize = _step - std::max(_gap, 0.0);
+		if (_plankSize <= 0.0) return;
+
+		for (int _plankIndex = 0; _plankIndex < _planksCount; _plankIndex++)
+		{
+			_addPlank(_plankIndex * _step, _plankIndex * _step + _plankSize);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+#include "SplineLayoutMath.h"
+#include "HermiteSpline.h"
+#include "BatchEvaluator.h"
+#include <algorithm>
+#include <vector>
+
+namespace SplineLayout
+{
+	/* Location and orientation of a spline at a distance */
+	struct SplineFrame
+	{
+		Vector3 location = Vector3();
+
+		/* Derivative of the spline, its length is the speed of the key along the spline */
+		Vector3 tangent = Vector3();
+
+		/* Unit vector on the right of the spline */
+		Vector3 right = Vector3();
+
+		/* Unit vector above the spline, orthogonal to the tangent */
+		Vector3 up = Vector3();
+
+		/* Get a location offset from the spline along the right and up vectors */
+		Vector3 GetOffsetLocation(const double _lateral, const double _vertical) const
+		{
+			return location + right * _lateral + up * _vertical;
+		}
+	};
+
+	/*
+	 * Frames of a spline sampled at a fixed spacing
+	 * The spline is evaluated once when the table is built, then a frame is an interpolation between two samples
+	 * Shared by the lanes of a spline so their cost doesn't grow with the spline evaluations
+	 */
+	class FrameTable
+	{
+		/* The sampled frames, the frame N is at the distance N * spacing and the last one at the end of the spline */
+		std::vector<SplineFrame> frames = std::vector<SplineFrame>();
+
+		/* Distance between two samples */
+		double spacing = 10.0;
+
+		/* Length of the sampled spline */
+		double length = 0.0;
+
+	public:
+		/* Sample a spline, the right vectors are orthogonal to the up reference */
+		void Build(const HermiteSpline& _spline, const double _spacing, const Vector3& _upReference)
+		{
+			length = _spline.GetLength();
+			spacing = std::max(_spacing, 1.0);
+
+			// Evaluate all the samples in one batch
+			const size_t _framesCount = static_cast<size_t>(std::ceil(length / spacing)) + 1;
+			std::vector<double> _distances = std::vector<double>(_framesCount);
+			for (size_t _frameIndex = 0; _frameIndex < _framesCount; _frameIndex++)
+			{
+				_distances[_frameIndex] = std::min(static_cast<double>(_frameIndex) * spacing, length);
+			}
+
+			SplineSamples _samples = SplineSamples();
+			BatchEvaluator(_spline).EvaluateDistances(_distances.data(), _framesCount, _samples);
+
+			frames.clear();
+			frames.reserve(_framesCount);
+			for (size_t _frameIndex = 0; _frameIndex < _framesCount; _frameIndex++)
+			{
+				frames.push_back(MakeFrame(_samples.GetLocation(_frameIndex), _samples.GetTangent(_frameIndex), _upReference));
+			}
+		}
+
+		size_t GetFrameCount() const { return frames.size(); }
+		double GetLength() const { return length; }
+
+		/* Get the frame at a distance along the spline */
+		SplineFrame GetFrameAtDistance(const double _distance) const
+		{
+			if (frames.empty()) return SplineFrame();
+			if (frames.size() == 1 || _distance <= 0.0) return frames.front();
+			if (_distance >= length) return frames.back();
+
+			// Find the samples around the distance, the last interval may be shorter than the spacing
+			const size_t _frameIndex = std::min(static_cast<size_t>(_distance / spacing), frames.size() - 2);
+			const double _startDistance = static_cast<double>(_frameIndex) * spacing;
+			const double _endDistance = std::min(_startDistance + spacing, length);
+			const double _alpha = _endDistance > _startDistance ? (_distance - _startDistance) / (_endDistance - _startDistance) : 0.0;
+
+			const SplineFrame& _start = frames[_frameIndex];
+			const SplineFrame& _end = frames[_frameIndex + 1];
+			SplineFrame _frame = SplineFrame();
+			_frame.location = Lerp(_start.location, _end.location, _alpha);
+			_frame.tangent = Lerp(_start.tangent, _end.tangent, _alpha);
+			_frame.right = Lerp(_start.right, _end.right, _alpha).GetSafeNormal();
+			_frame.up = Lerp(_start.up, _end.up, _alpha).GetSafeNormal();
+			return _frame;
+		}
+
+		/* Make the frame of a location and a tangent */
+		static SplineFrame MakeFrame(const Vector3& _location, const Vector3& _tangent, const Vector3& _upReference)
+		{
+			SplineFrame _frame = SplineFrame();
+			_frame.location = _location;
+			_frame.tangent = _tangent;
+
+			// A vertical tangent has no right vector from the up reference, fall back on the Y axis
+			const Vector3 _forward = _tangent.GetSafeNormal();
+			_frame.right = _upReference.Cross(_forward).GetSafeNormal();
+			if (_frame.right.Length() <= 0.0) _frame.right = Vector3(0.0, 1.0, 0.0);
+			_frame.up = _forward.Cross(_frame.right).GetSafeNormal();
+			return _frame;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,218 @@
+#pragma once
+#include "SplineLayoutMath.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace SplineLayout
+{
+	/* The interpolation between a spline point and the next one */
+	enum class InterpMode : uint8_t
+	{
+		Curve,
+		Linear,
+		Constant
+	};
+
+	/* A point of the spline, its key is its index */
+	struct SplinePoint
+	{
+		Vector3 position = Vector3();
+		Vector3 arriveTangent = Vector3();
+		Vector3 leaveTangent = Vector3();
+		InterpMode interpMode = InterpMode::Curve;
+	};
+
+	/*
+	 * Cubic Hermite spline evaluated by key or by distance
+	 * Follows the evaluation of the engine splines: the keys are the point indexes and the distances come from a table of samples per segment
+	 */
+	class HermiteSpline
+	{
+		/* The points of the spline */
+		std::vector<SplinePoint> points = std::vector<SplinePoint>();
+
+		/* The last point is linked to the first one */
+		bool closedLoop = false;
+
+		/* Number of distance samples per segment */
+		int stepsPerSegment = 10;
+
+		/* Distance along the spline of each sample, the key of the sample N is N / stepsPerSegment */
+		std::vector<double> sampleDistances = std::vector<double>();
+
+	public:
+		HermiteSpline() = default;
+		HermiteSpline(std::vector<SplinePoint> _points, const bool _closedLoop = false, const int _stepsPerSegment = 10)
+		{
+			SetPoints(std::move(_points), _closedLoop, _stepsPerSegment);
+		}
+
+		/* Set the points of the spline and compute its distance samples */
+		void SetPoints(std::vector<SplinePoint> _points, const bool _closedLoop = false, const int _stepsPerSegment = 10)
+		{
+			points = std::move(_points);
+			closedLoop = _closedLoop;
+			stepsPerSegment = std::max(1, _stepsPerSegment);
+
+			// Run through the segments and accumulate their length
+			const int _segmentCount = GetSegmentCount();
+			sampleDistances.assign(1, 0.0);
+			sampleDistances.reserve(static_cast<size_t>(_segmentCount) * stepsPerSegment + 1);
+			double _distance = 0.0;
+			for (int _segmentIndex = 0; _segmentIndex < _segmentCount; _segmentIndex++)
+			{
+				for (int _step = 1; _step <= stepsPerSegment; _step++)
+				{
+					sampleDistances.push_back(_distance + GetSegmentLength(_segmentIndex, static_cast<double>(_step) / stepsPerSegment));
+				}
+				_distance = sampleDistances.back();
+			}
+		}
+
+		int GetPointCount() const { return static_cast<int>(points.size()); }
+		int GetSegmentCount() const
+		{
+			const int _pointCount = GetPointCount();
+			return _pointCount < 2 ? 0 : closedLoop ? _pointCount : _pointCount - 1;
+		}
+		int GetStepsPerSegment() const { return stepsPerSegment; }
+		const SplinePoint& GetPoint(const int _index) const { return points[_index]; }
+		const std::vector<double>& GetSampleDistances() const { return sampleDistances; }
+
+		/* Get the length of the spline */
+		double GetLength() const
+		{
+			return sampleDistances.empty() ? 0.0 : sampleDistances.back();
+		}
+
+		/* Get the distance along the spline of a point */
+		double GetDistanceAtPoint(const int _index) const
+		{
+			const size_t _sampleIndex = static_cast<size_t>(std::clamp(_index, 0, GetSegmentCount())) * stepsPerSegment;
+			return _sampleIndex < sampleDistances.size() ? sampleDistances[_sampleIndex] : GetLength();
+		}
+
+		/* Get the key at a distance along the spline */
+		double GetKeyAtDistance(const double _distance) const
+		{
+			if (sampleDistances.size() < 2 || _distance <= 0.0) return 0.0;
+			if (_distance >= GetLength()) return GetSegmentCount();
+
+			// Find the samples around the distance and interpolate their keys
+			const auto _upper = std::upper_bound(sampleDistances.begin(), sampleDistances.end(), _distance);
+			const size_t _sampleIndex = static_cast<size_t>(_upper - sampleDistances.begin()) - 1;
+			return KeyBetweenSamples(_sampleIndex, _distance);
+		}
+
+		/* Get the location at a key */
+		Vector3 GetLocation(const double _key) const
+		{
+			int _segmentIndex = 0;
+			double _alpha = 0.0;
+			if (!GetSegment(_key, _segmentIndex, _alpha)) return points.empty() ? Vector3() : points[0].position;
+			return EvaluateSegment(_segmentIndex, _alpha);
+		}
+
+		/* Get the tangent at a key */
+		Vector3 GetTangent(const double _key) const
+		{
+			int _segmentIndex = 0;
+			double _alpha = 0.0;
+			if (!GetSegment(_key, _segmentIndex, _alpha)) return points.empty() ? Vector3() : points[0].leaveTangent;
+			return EvaluateSegmentDerivative(_segmentIndex, _alpha);
+		}
+
+		Vector3 GetLocationAtDistance(const double _distance) const { return GetLocation(GetKeyAtDistance(_distance)); }
+		Vector3 GetTangentAtDistance(const double _distance) const { return GetTangent(GetKeyAtDistance(_distance)); }
+
+		/* Get the key at a distance between a sample and the next one */
+		double KeyBetweenSamples(const size_t _sampleIndex, const double _distance) const
+		{
+			const double _startDistance = sampleDistances[_sampleIndex];
+			const double _sampleLength = sampleDistances[_sampleIndex + 1] - _startDistance;
+			const double _alpha = _sampleLength > 0.0 ? (_distance - _startDistance) / _sampleLength : 0.0;
+			return (static_cast<double>(_sampleIndex) + _alpha) / stepsPerSegment;
+		}
+
+		/* Get the segment and the alpha in this segment of a key */
+		bool GetSegment(const double _key, int& _segmentIndex, double& _alpha) const
+		{
+			const int _segmentCount = GetSegmentCount();
+			if (_segmentCount == 0) return false;
+
+			const double _clampedKey = std::clamp(_key, 0.0, static_cast<double>(_segmentCount));
+			_segmentIndex = std::min(static_cast<int>(_clampedKey), _segmentCount - 1);
+			_alpha = _clampedKey - _segmentIndex;
+			return true;
+		}
+
+		/* Evaluate the location of a segment */
+		Vector3 EvaluateSegment(const int _segmentIndex, const double _alpha) const
+		{
+			const SplinePoint& _start = points[_segmentIndex];
+			const SplinePoint& _end = points[(_segmentIndex + 1) % points.size()];
+
+			switch (_start.interpMode)
+			{
+			case InterpMode::Constant:
+				return _start.position;
+
+			case InterpMode::Linear:
+				return _start.position + (_end.position - _start.position) * _alpha;
+
+			default:
+			{
+				const double _alpha2 = _alpha * _alpha;
+				const double _alpha3 = _alpha2 * _alpha;
+				return _start.position * (2.0 * _alpha3 - 3.0 * _alpha2 + 1.0)
+					+ _start.leaveTangent * (_alpha3 - 2.0 * _alpha2 + _alpha)
+					+ _end.arriveTangent * (_alpha3 - _alpha2)
+					+ _end.position * (-2.0 * _alpha3 + 3.0 * _alpha2);
+			}
+			}
+		}
+
+		/* Evaluate the derivative of a segment */
+		Vector3 EvaluateSegmentDerivative(const int _segmentIndex, const double _alpha) const
+		{
+			const SplinePoint& _start = points[_segmentIndex];
+			const SplinePoint& _end = points[(_segmentIndex + 1) % points.size()];
+
+			switch (_start.interpMode)
+			{
+			case InterpMode::Constant:
+				return Vector3();
+
+			case InterpMode::Linear:
+				return _end.position - _start.position;
+
+			default:
+			{
+				const double _alpha2 = _alpha * _alpha;
+				return _start.position * (6.0 * _alpha2 - 6.0 * _alpha)
+					+ _start.leaveTangent * (3.0 * _alpha2 - 4.0 * _alpha + 1.0)
+					+ _end.arriveTangent * (3.0 * _alpha2 - 2.0 * _alpha)
+					+ _end.position * (-6.0 * _alpha2 + 6.0 * _alpha);
+			}
+			}
+		}
+
+		/* Get the length of a segment from its start to an alpha, with a 5 points Gauss-Legendre quadrature */
+		double GetSegmentLength(const int _segmentIndex, const double _alpha = 1.0) const
+		{
+			static constexpr double Abscissae[5] = { 0.0, -0.5384693101056831, 0.5384693101056831, -0.9061798459386640, 0.9061798459386640 };
+			static constexpr double Weights[5] = { 0.5688888888888889, 0.4786286704993665, 0.4786286704993665, 0.2369268850561891, 0.2369268850561891 };
+
+			const double _halfAlpha = _alpha * 0.5;
+			double _length = 0.0;
+			for (int _index = 0; _index < 5; _index++)
+			{
+				const double _sampleAlpha = _halfAlpha * (1.0 + Abscissae[_index]);
+				_length += EvaluateSegmentDerivative(_segmentIndex, _sampleAlpha).Length() * Weights[_index];
+			}
+
+			return _length * _halfAlpha;
+		}
+	};
+}
\ No newline at end of file
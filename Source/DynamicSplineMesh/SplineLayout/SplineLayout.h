@@ -0,0 +1,218 @@
+#pragma once
+#include "SplineLayoutMath.h"
+#include "HermiteSpline.h"
+#include "BatchEvaluator.h"
+#include "FrameTable.h"
+#include "BridgeSpan.h"
+#include <vector>
+
+namespace SplineLayout
+{
+	/*
+	 * Fill a spline with the same mesh as long as it fits
+	 * Calls _addEntry(startDistance, length) for each mesh, the gap is placed after each mesh
+	 */
+	template <typename AddEntry>
+	void FillPlan(const double _meshLength, const double _gap, const double _splineLength, AddEntry&& _addEntry)
+	{
+		if (_meshLength + _gap <= 0.0) return;
+
+		double _totalLength = 0.0;
+		while (_totalLength + _meshLength + _gap <= _splineLength)
+		{
+			_addEntry(_totalLength, _meshLength);
+			_totalLength += _meshLength + _gap;
+		}
+	}
+
+	/*
+	 * Place a sequence of meshes once, in order, until the spline is full
+	 * _getLength(index) returns the length of a mesh, a negative length skips the mesh
+	 * Calls _addEntry(index, startDistance, length) for each placed mesh
+	 */
+	template <typename GetLength, typename AddEntry>
+	void SequencePlan(const int _count, const double _gap, const double _splineLength, GetLength&& _getLength, AddEntry&& _addEntry)
+	{
+		double _totalLength = 0.0;
+		for (int _index = 0; _index < _count; _index++)
+		{
+			const double _meshLength = _getLength(_index);
+			if (_meshLength < 0.0) continue;
+			if (_totalLength + _meshLength + _gap > _splineLength) break;
+
+			_addEntry(_index, _totalLength, _meshLength);
+			_totalLength += _meshLength + _gap;
+		}
+	}
+
+	/*
+	 * Place random meshes among _count until the next one doesn't fit
+	 * _nextIndex() returns the index of the next mesh and _getLength(index) its length, a negative length draws another mesh
+	 * Nothing is placed when no mesh is valid, and the placement stops on a mesh that doesn't move forward
+	 * Calls _addEntry(index, startDistance, length) for each placed mesh
+	 */
+	template <typename NextIndex, typename GetLength, typename AddEntry>
+	void RandomPlan(const int _count, const double _gap, const double _splineLength, NextIndex&& _nextIndex, GetLength&& _getLength, AddEntry&& _addEntry)
+	{
+		// Without any valid mesh the draws would never end
+		bool _hasValidMesh = false;
+		for (int _index = 0; _index < _count && !_hasValidMesh; _index++)
+		{
+			_hasValidMesh = _getLength(_index) >= 0.0;
+		}
+		if (!_hasValidMesh) return;
+
+		double _totalLength = 0.0;
+		while (true)
+		{
+			const int _index = _nextIndex();
+			const double _meshLength = _getLength(_index);
+			if (_meshLength < 0.0) continue;
+			if (_meshLength + _gap <= 0.0) break;
+			if (_totalLength + _meshLength + _gap > _splineLength) break;
+
+			_addEntry(_index, _totalLength, _meshLength);
+			_totalLength += _meshLength + _gap;
+		}
+	}
+
+	/* The parts of a repeated pattern */
+	enum class PatternPart : uint8_t
+	{
+		StartCap,
+		Pattern,
+		EndCap
+	};
+
+	/*
+	 * Repeat a pattern of meshes between a start cap and an end cap, the caps are placed once
+	 * The lengths are given per part, a negative length skips the mesh, the gap is placed after each mesh
+	 * The start cap is cut where it stops fitting, the end cap is only placed whole, right after the pattern
+	 * The full periods are placed in closed form from the prefix sums of the pattern, only the last partial period is checked mesh by mesh
+	 * Calls _reserve(count) once, then _addEntry(part, index, startDistance, length) for each placed mesh in order
+	 */
+	template <typename Reserve, typename AddEntry>
+	void PatternPlan(const std::vector<double>& _startLengths, const std::vector<double>& _patternLengths, const std::vector<double>& _endLengths, const double _gap, const double _splineLength, Reserve&& _reserve, AddEntry&& _addEntry)
+	{
+		// Keep the placed meshes of a part and the distance from the start of the part to each of them
+		struct PartPrefix
+		{
+			std::vector<int> indexes = std::vector<int>();
+			std::vector<double> distances = std::vector<double>(1, 0.0);
+
+			PartPrefix(const std::vector<double>& _lengths, const double _gap)
+			{
+				const int _count = static_cast<int>(_lengths.size());
+				for (int _index = 0; _index < _count; _index++)
+				{
+					if (_lengths[_index] < 0.0) continue;
+					indexes.push_back(_index);
+					distances.push_back(distances.back() + _lengths[_index] + _gap);
+				}
+			}
+
+			int Num() const { return static_cast<int>(indexes.size()); }
+			double GetLength() const { return distances.back(); }
+
+			/* Get the number of leading meshes fitting in a length */
+			int CountFitting(const double _length) const
+			{
+				int _count = 0;
+				while (_count < Num() && distances[_count + 1] <= _length) _count++;
+				return _count;
+			}
+		};
+
+		const PartPrefix _start = PartPrefix(_startLengths, _gap);
+		const PartPrefix _pattern = PartPrefix(_patternLengths, _gap);
+		const PartPrefix _end = PartPrefix(_endLengths, _gap);
+
+		// The start cap comes first, the end cap is kept when it fits after it
+		const int _startCount = _start.CountFitting(_splineLength);
+		const double _patternStart = _start.distances[_startCount];
+		const bool _hasEndCap = _end.Num() > 0 && _patternStart + _end.GetLength() <= _splineLength;
+		const double _available = _splineLength - _patternStart - (_hasEndCap ? _end.GetLength() : 0.0);
+
+		// Number of full periods, then the meshes of the partial period
+		const double _period = _pattern.GetLength();
+		int _periodCount = _period > 0.0 && _available > 0.0 ? static_cast<int>(std::floor(_available / _period)) : 0;
+		if (_periodCount > 0 && _periodCount * _period > _available) _periodCount--;
+		const double _partialStart = _patternStart + _periodCount * _period;
+		const int _partialCount = _period > 0.0 ? _pattern.CountFitting(_available - _periodCount * _period) : 0;
+		const int _endCount = _hasEndCap ? _end.Num() : 0;
+		_reserve(_startCount + _periodCount * _pattern.Num() + _partialCount + _endCount);
+
+		const auto _addPart = [&_addEntry](const PatternPart _part, const PartPrefix& _prefix, const std::vector<double>& _lengths, const double _partStart, const int _count)
+		{
+			for (int _index = 0; _index < _count; _index++)
+			{
+				const int _meshIndex = _prefix.indexes[_index];
+				_addEntry(_part, _meshIndex, _partStart + _prefix.distances[_index], _lengths[_meshIndex]);
+			}
+		};
+
+		_addPart(PatternPart::StartCap, _start, _startLengths, 0.0, _startCount);
+		for (int _periodIndex = 0; _periodIndex < _periodCount; _periodIndex++)
+		{
+			_addPart(PatternPart::Pattern, _pattern, _patternLengths, _patternStart + _periodIndex * _period, _pattern.Num());
+		}
+		_addPart(PatternPart::Pattern, _pattern, _patternLengths, _partialStart, _partialCount);
+		_addPart(PatternPart::EndCap, _end, _endLengths, _partialStart + _pattern.distances[_partialCount], _endCount);
+	}
+
+	/* Get the scale stretching a mesh between two locations */
+	inline double GetExtendScale(const Vector3& _start, const Vector3& _end, const double _meshLength)
+	{
+		return _meshLength > 0.0 ? std::abs((_end - _start).Length() / _meshLength) : 0.0;
+	}
+
+	/* A gap in the ground crossed by a bridge */
+	struct Bridge
+	{
+		Vector3 start = Vector3();
+		Vector3 end = Vector3();
+
+		Vector3 ComputeMiddleLocation() const
+		{
+			return (start + end) * 0.5;
+		}
+	};
+
+	/*
+	 * Find the bridges along ground samples spaced by a gap
+	 * A bridge starts at the first height change and ends at the next one
+	 * Calls _addBridge(bridge) for each bridge
+	 */
+	template <typename AddBridge>
+	void DetectBridges(const Vector3* _groundPoints, const int _count, const double _gap, AddBridge&& _addBridge)
+	{
+		Vector3 _previousPoint = Vector3();
+		Vector3 _startLocation = Vector3();
+		bool _hasStarted = false;
+
+		for (int _index = 0; _index < _count; _index++)
+		{
+			const Vector3& _currentPoint = _groundPoints[_index];
+
+			if (_index >= 1 && _currentPoint.z != _previousPoint.z)
+			{
+				if (!_hasStarted)
+				{
+					_startLocation = Vector3(_currentPoint.x - _gap, _currentPoint.y, _previousPoint.z);
+					_hasStarted = true;
+				}
+
+				else
+				{
+					Bridge _bridge = Bridge();
+					_bridge.start = _startLocation;
+					_bridge.end = _currentPoint;
+					_addBridge(_bridge);
+					_hasStarted = false;
+				}
+			}
+
+			_previousPoint = _currentPoint;
+		}
+	}
+}
\ No newline at end of file
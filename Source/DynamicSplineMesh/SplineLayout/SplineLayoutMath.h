@@ -0,0 +1,108 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+/*
+ * Engine independent spline layout
+ * Only depends on the standard library so the layout can be built, tested and measured without the engine
+ */
+namespace SplineLayout
+{
+	/* A vector in the local space of the spline */
+	struct Vector3
+	{
+		double x = 0.0;
+		double y = 0.0;
+		double z = 0.0;
+
+		constexpr Vector3() = default;
+		constexpr Vector3(const double _x, const double _y, const double _z) : x(_x), y(_y), z(_z) { }
+
+		constexpr Vector3 operator+(const Vector3& _other) const { return Vector3(x + _other.x, y + _other.y, z + _other.z); }
+		constexpr Vector3 operator-(const Vector3& _other) const { return Vector3(x - _other.x, y - _other.y, z - _other.z); }
+		constexpr Vector3 operator*(const double _scale) const { return Vector3(x * _scale, y * _scale, z * _scale); }
+		constexpr Vector3 operator/(const double _scale) const { return Vector3(x / _scale, y / _scale, z / _scale); }
+		Vector3& operator+=(const Vector3& _other) { x += _other.x; y += _other.y; z += _other.z; return *this; }
+
+		constexpr double Dot(const Vector3& _other) const { return x * _other.x + y * _other.y + z * _other.z; }
+		constexpr Vector3 Cross(const Vector3& _other) const { return Vector3(y * _other.z - z * _other.y, z * _other.x - x * _other.z, x * _other.y - y * _other.x); }
+		double Length() const { return std::sqrt(Dot(*this)); }
+
+		/* Get a copy of the vector with a length of 1, or a null vector when it is too small */
+		Vector3 GetSafeNormal() const
+		{
+			const double _length = Length();
+			return _length > 1e-8 ? *this / _length : Vector3();
+		}
+
+		/* Get a copy of the vector with its length clamped between two values */
+		Vector3 GetClampedToSize(const double _min, const double _max) const
+		{
+			const double _length = Length();
+			if (_length <= 0.0) return Vector3();
+
+			const double _clampedLength = _length < _min ? _min : _length > _max ? _max : _length;
+			return *this * (_clampedLength / _length);
+		}
+	};
+
+	/* Interpolate linearly between two vectors */
+	constexpr Vector3 Lerp(const Vector3& _a, const Vector3& _b, const double _alpha)
+	{
+		return _a + (_b - _a) * _alpha;
+	}
+
+	/* The axes used to rotate a mesh, same order as EAxisRotation */
+	enum class RotationAxis : uint8_t
+	{
+		X,
+		Y,
+		Z
+	};
+
+	/* The end of a segment once rotated */
+	struct RotatedSegment
+	{
+		/* The new end location of the segment */
+		Vector3 end = Vector3();
+
+		/* The tangent used at both ends of the segment */
+		Vector3 tangent = Vector3();
+	};
+
+	/* Get the direction of a mesh rotated around an axis */
+	inline Vector3 GetRotatedVector(const RotationAxis _axis, const double _angleDegrees)
+	{
+		const double _angle = _angleDegrees * (3.14159265358979323846 / 180.0);
+		switch (_axis)
+		{
+		case RotationAxis::X:
+			return Vector3(0.0, -std::cos(_angle), std::sin(_angle));
+
+		case RotationAxis::Y:
+			return Vector3(std::cos(_angle), 0.0, std::sin(_angle));
+
+		case RotationAxis::Z:
+			return Vector3(std::cos(_angle), std::sin(_angle), 0.0);
+
+		default:
+			return Vector3();
+		}
+	}
+
+	/*
+	 * Rotate a segment around its start on the Y or Z axis
+	 * The X axis is a roll and doesn't move the end of the segment
+	 */
+	inline RotatedSegment RotateSegment(const Vector3& _start, const Vector3& _end, const RotationAxis _axis, const double _angleDegrees)
+	{
+		const double _size = (_end - _start).Length();
+		const Vector3 _newEnd = _start + GetRotatedVector(_axis, _angleDegrees) * _size;
+		const double _xTangent = _newEnd.x - _start.x;
+
+		RotatedSegment _segment = RotatedSegment();
+		_segment.end = _newEnd;
+		_segment.tangent = _axis == RotationAxis::Y ? Vector3(_xTangent, 0.0, _newEnd.z) : Vector3(_xTangent, _newEnd.y, 0.0);
+		return _segment;
+	}
+}
\ No newline at end of file
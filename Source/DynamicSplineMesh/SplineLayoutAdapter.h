@@ -0,0 +1,56 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Components/SplineComponent.h"
+#include "ENUM_AxisRotation.h"
+#include "SplineLayout/SplineLayout.h"
+
+/* Conversions between the engine types and the engine independent spline layout */
+namespace SplineLayoutAdapter
+{
+	FORCEINLINE SplineLayout::Vector3 ToLayout(const FVector& _vector)
+	{
+		return SplineLayout::Vector3(_vector.X, _vector.Y, _vector.Z);
+	}
+
+	FORCEINLINE FVector ToEngine(const SplineLayout::Vector3& _vector)
+	{
+		return FVector(_vector.x, _vector.y, _vector.z);
+	}
+
+	FORCEINLINE SplineLayout::RotationAxis ToLayout(const EAxisRotation _axisRotation)
+	{
+		switch (_axisRotation)
+		{
+		case ROTATE_Y:
+			return SplineLayout::RotationAxis::Y;
+
+		case ROTATE_Z:
+			return SplineLayout::RotationAxis::Z;
+
+		default:
+			return SplineLayout::RotationAxis::X;
+		}
+	}
+
+	/* Build the evaluator of a spline component, in its local space */
+	inline SplineLayout::HermiteSpline MakeHermiteSpline(const USplineComponent* _spline)
+	{
+		const TArray<FInterpCurvePoint<FVector>>& _curvePoints = _spline->SplineCurves.Position.Points;
+
+		std::vector<SplineLayout::SplinePoint> _points = std::vector<SplineLayout::SplinePoint>();
+		_points.reserve(_curvePoints.Num());
+		for (const FInterpCurvePoint<FVector>& _curvePoint : _curvePoints)
+		{
+			SplineLayout::SplinePoint _point = SplineLayout::SplinePoint();
+			_point.position = ToLayout(_curvePoint.OutVal);
+			_point.arriveTangent = ToLayout(_curvePoint.ArriveTangent);
+			_point.leaveTangent = ToLayout(_curvePoint.LeaveTangent);
+			_point.interpMode = _curvePoint.InterpMode == CIM_Linear ? SplineLayout::InterpMode::Linear
+							  : _curvePoint.InterpMode == CIM_Constant ? SplineLayout::InterpMode::Constant
+							  : SplineLayout::InterpMode::Curve;
+			_points.push_back(_point);
+		}
+
+		return SplineLayout::HermiteSpline(MoveTemp(_points), _spline->IsClosedLoop(), _spline->ReparamStepsPerSegment);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "SplineMeshCollisionComponent.h"
+
+#include "AI/NavigationSystemBase.h"
+#include "Components/SplineMeshComponent.h"
+#include "DynamicSplineMeshStats.h"
+#include "Hash/CityHash.h"
+#include "PhysicsEngine/BodySetup.h"
+
+/* Number of slices of the mesh used by a convex shape */
+static constexpr int ConvexSlicesCount = 3;
+
+USplineMeshCollisionComponent::USplineMeshCollisionComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetGenerateOverlapEvents(false);
+	bCanEverAffectNavigation = true;
+}
+
+bool USplineMeshCollisionComponent::SetGeometry(const FKAggregateGeom& _geometry)
+{
+	const uint64 _hash = ComputeGeometryHash(_geometry);
+	if (bodySetup && _hash == geometryHash) return false;
+
+	// Create the body the first time
+	if (!bodySetup)
+	{
+		bodySetup = NewObject<UBodySetup>(this, NAME_None, RF_NoFlags);
+		bodySetup->BodySetupGuid = FGuid::NewGuid();
+		bodySetup->CollisionTraceFlag = CTF_UseSimpleAsComplex;
+		bodySetup->bGenerateMirroredCollision = false;
+	}
+
+	// Replace the shapes and cook the convexes
+	DEC_DWORD_STAT_BY(STAT_DSM_CollisionShapes, GetShapeCount());
+	bodySetup->RemoveSimpleCollision();
+	bodySetup->AggGeom = _geometry;
+	bodySetup->InvalidatePhysicsData();
+	bodySetup->CreatePhysicsMeshes();
+	geometryHash = _hash;
+	INC_DWORD_STAT_BY(STAT_DSM_CollisionShapes, GetShapeCount());
+
+	// Only the area of this chunk is dirtied in the navigation
+	RecreatePhysicsState();
+	UpdateBounds();
+	MarkRenderTransformDirty();
+	FNavigationSystem::UpdateComponentData(*this);
+	return true;
+}
+
+int USplineMeshCollisionComponent::GetShapeCount() const
+{
+	return bodySetup ? bodySetup->AggGeom.GetElementCount() : 0;
+}
+
+void USplineMeshCollisionComponent::AddSplineMeshShape(const USplineMeshComponent* _splineMesh, const bool _useConvex, FKAggregateGeom& _geometry)
+{
+	const UStaticMesh* _mesh = _splineMesh ? _splineMesh->GetStaticMesh() : nullptr;
+	if (!_mesh) return;
+
+	// Get the corners of the mesh section at regular slices along the spline
+	const FBox& _meshBox = _mesh->GetBoundingBox();
+	const FTransform& _relativeTransform = _splineMesh->GetRelativeTransform();
+	const int _slicesCount = _useConvex ? ConvexSlicesCount : 2;
+	TArray<FVector> _corners = TArray<FVector>();
+	_corners.Reserve(_slicesCount * 4);
+	for (int _sliceIndex = 0; _sliceIndex < _slicesCount; _sliceIndex++)
+	{
+		const float _distance = FMath::Lerp(_meshBox.Min.X, _meshBox.Max.X, static_cast<float>(_sliceIndex) / (_slicesCount - 1));
+		const FTransform& _slice = _splineMesh->CalcSliceTransform(_distance) * _relativeTransform;
+		_corners.Add(_slice.TransformPosition(FVector(0.0f, _meshBox.Min.Y, _meshBox.Min.Z)));
+		_corners.Add(_slice.TransformPosition(FVector(0.0f, _meshBox.Max.Y, _meshBox.Min.Z)));
+		_corners.Add(_slice.TransformPosition(FVector(0.0f, _meshBox.Min.Y, _meshBox.Max.Z)));
+		_corners.Add(_slice.TransformPosition(FVector(0.0f, _meshBox.Max.Y, _meshBox.Max.Z)));
+	}
+
+	if (_useConvex)
+	{
+		FKConvexElem _convex = FKConvexElem();
+		_convex.VertexData = _corners;
+		_convex.UpdateElemBox();
+		_geometry.ConvexElems.Add(_convex);
+		return;
+	}
+
+	// Orient the box along the chord of the mesh, up as the middle of the mesh
+	const FVector& _startCenter = (_corners[0] + _corners[3]) * 0.5f;
+	const FVector& _endCenter = (_corners[4] + _corners[7]) * 0.5f;
+	const FVector& _upDirection = (_corners[2] + _corners[3] + _corners[6] + _corners[7]) - (_corners[0] + _corners[1] + _corners[4] + _corners[5]);
+	const FVector& _forward = (_endCenter - _startCenter).GetSafeNormal(UE_SMALL_NUMBER, FVector::ForwardVector);
+	const FQuat& _rotation = FRotationMatrix::MakeFromXZ(_forward, _upDirection).ToQuat();
+
+	// Fit the extents of the box around the corners
+	FBox _localBox = FBox(ForceInit);
+	for (const FVector& _corner : _corners)
+	{
+		_localBox += _rotation.UnrotateVector(_corner);
+	}
+
+	FKBoxElem _box = FKBoxElem();
+	_box.Center = _rotation.RotateVector(_localBox.GetCenter());
+	_box.Rotation = _rotation.Rotator();
+	_box.X = _localBox.GetSize().X;
+	_box.Y = _localBox.GetSize().Y;
+	_box.Z = _localBox.GetSize().Z;
+	_geometry.BoxElems.Add(_box);
+}
+
+UBodySetup* USplineMeshCollisionComponent::GetBodySetup()
+{
+	return bodySetup;
+}
+
+FBoxSphereBounds USplineMeshCollisionComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	if (!bodySetup || bodySetup->AggGeom.GetElementCount() == 0) return FBoxSphereBounds(LocalToWorld.GetLocation(), FVector::ZeroVector, 0.0f);
+	return FBoxSphereBounds(bodySetup->AggGeom.CalcAABB(LocalToWorld));
+}
+
+uint64 USplineMeshCollisionComponent::ComputeGeometryHash(const FKAggregateGeom& _geometry)
+{
+	// Gather the values defining the shapes
+	TArray<double> _values = TArray<double>();
+	for (const FKBoxElem& _box : _geometry.BoxElems)
+	{
+		_values.Append({ _box.Center.X, _box.Center.Y, _box.Center.Z, _box.Rotation.Pitch, _box.Rotation.Yaw, _box.Rotation.Roll, _box.X, _box.Y, _box.Z });
+	}
+
+	for (const FKConvexElem& _convex : _geometry.ConvexElems)
+	{
+		_values.Add(_convex.VertexData.Num());
+		for (const FVector& _vertex : _convex.VertexData)
+		{
+			_values.Append({ _vertex.X, _vertex.Y, _vertex.Z });
+		}
+	}
+
+	_values.Add(_geometry.BoxElems.Num());
+	return CityHash64(reinterpret_cast<const char*>(_values.GetData()), _values.Num() * sizeof(double));
+}
\ No newline at end of file
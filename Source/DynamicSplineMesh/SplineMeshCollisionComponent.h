@@ -0,0 +1,51 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "PhysicsEngine/AggregateGeom.h"
+#include "SplineMeshCollisionComponent.generated.h"
+
+class UBodySetup;
+class USplineMeshComponent;
+
+/*
+ * Simplified collision of a chunk of spline meshes
+ * A single body holds one box or convex per spline mesh, in the space of the spline
+ */
+UCLASS(ClassGroup = "DynamicSplineMesh")
+class DYNAMICSPLINEMESH_API USplineMeshCollisionComponent : public UPrimitiveComponent
+{
+	GENERATED_BODY()
+
+	/* The shapes of the chunk */
+	UPROPERTY()
+		UBodySetup* bodySetup = nullptr;
+
+	/* Hash of the shapes, the body is only rebuilt when it changes */
+	UPROPERTY()
+		uint64 geometryHash = 0;
+
+public:
+	USplineMeshCollisionComponent();
+
+	/*
+	 * Replace the shapes of the chunk
+	 * Returns false when they didn't change, the physics and the navigation are only updated otherwise
+	 */
+	bool SetGeometry(const FKAggregateGeom& _geometry);
+
+	/* Get the number of shapes of the chunk */
+	int GetShapeCount() const;
+
+	/*
+	 * Add the shape fitted around a spline mesh, in the space of its parent
+	 * A box follows the chord of the mesh, a convex follows its bend with a few slices
+	 */
+	static void AddSplineMeshShape(const USplineMeshComponent* _splineMesh, const bool _useConvex, FKAggregateGeom& _geometry);
+
+	virtual UBodySetup* GetBodySetup() override;
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+
+private:
+	/* Hash the shapes of a geometry */
+	static uint64 ComputeGeometryHash(const FKAggregateGeom& _geometry);
+};
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include "SplineMeshGenerateAction.h"
+
+#include "DynamicSplineMesh.h"
+#include "DynamicSplineMeshActor.h"
+
+USplineMeshGenerateAction* USplineMeshGenerateAction::GenerateSplineAsync(ADynamicSplineMeshActor* _actor, const FSplineMeshGenerateSettings& _settings)
+{
+	USplineMeshGenerateAction* _action = NewObject<USplineMeshGenerateAction>();
+	_action->actor = _actor;
+	_action->settings = _settings;
+	_action->RegisterWithGameInstance(_actor);
+	return _action;
+}
+
+void USplineMeshGenerateAction::Cancel()
+{
+	if (IsValid(actor)) actor->CancelGenerate();
+}
+
+void USplineMeshGenerateAction::Activate()
+{
+	if (!IsValid(actor))
+	{
+		UE_LOG(LogDynamicSplineMesh, Warning, TEXT("GenerateSplineAsync called without a spline actor"));
+		OnCancelled.Broadcast(FSplineMeshGenerateResult());
+		SetReadyToDestroy();
+		return;
+	}
+
+	// The future is set on the game thread, the delegates are broadcast from there
+	const TWeakObjectPtr<USplineMeshGenerateAction> _weakThis = this;
+	const FOnSplineMeshGenerateProgress& _onProgress = FOnSplineMeshGenerateProgress::CreateWeakLambda(this, [this](const float _progress)
+	{
+		OnProgress.Broadcast(_progress);
+	});
+
+	actor->GenerateAsync(settings, _onProgress).Next([_weakThis](const FSplineMeshGenerateResult& _result)
+	{
+		USplineMeshGenerateAction* _action = _weakThis.Get();
+		if (!_action) return;
+
+		if (_result.cancelled) _action->OnCancelled.Broadcast(_result);
+		else _action->OnCompleted.Broadcast(_result);
+		_action->SetReadyToDestroy();
+	});
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "STRUCT_SplineMeshGenerateSettings.h"
+#include "STRUCT_SplineMeshGenerateResult.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "SplineMeshGenerateAction.generated.h"
+
+class ADynamicSplineMeshActor;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSplineMeshGenerateActionProgress, float, _progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSplineMeshGenerateActionDone, const FSplineMeshGenerateResult&, _result);
+
+/*
+ * Latent node rebuilding a spline without a hitch
+ * Wraps ADynamicSplineMeshActor::GenerateAsync for the blueprints
+ */
+UCLASS()
+class DYNAMICSPLINEMESH_API USplineMeshGenerateAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+	/* Called each time a slice of spline meshes is created, with the fraction created */
+	UPROPERTY(BlueprintAssignable)
+		FOnSplineMeshGenerateActionProgress OnProgress;
+
+	/* Called once all the spline meshes are created */
+	UPROPERTY(BlueprintAssignable)
+		FOnSplineMeshGenerateActionDone OnCompleted;
+
+	/* Called when the generation is cancelled, by Cancel or by another rebuild of the spline */
+	UPROPERTY(BlueprintAssignable)
+		FOnSplineMeshGenerateActionDone OnCancelled;
+
+	/* The spline to generate */
+	UPROPERTY()
+		ADynamicSplineMeshActor* actor = nullptr;
+
+	UPROPERTY()
+		FSplineMeshGenerateSettings settings = FSplineMeshGenerateSettings();
+
+public:
+	/* Rebuild a spline, computing its segments on a worker and creating its meshes over several frames */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic spline mesh", meta = (BlueprintInternalUseOnly = "true"))
+		static USplineMeshGenerateAction* GenerateSplineAsync(ADynamicSplineMeshActor* _actor, const FSplineMeshGenerateSettings& _settings);
+
+	/* Cancel the generation, OnCancelled is called right away */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic spline mesh")
+		void Cancel();
+
+	virtual void Activate() override;
+};
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "SplineMeshLayoutCache.h"
+
+#include "DynamicSplineMesh.h"
+#include "DynamicSplineMeshStats.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarLayoutCacheMaxMemoryKB(
+	TEXT("dsm.LayoutCache.MaxMemoryKB"),
+	16 * 1024,
+	TEXT("Memory cap of the shared spline mesh layout cache, in KB, 0 disables the cache"));
+
+static TAutoConsoleVariable<int32> CVarLayoutCacheMaxLayouts(
+	TEXT("dsm.LayoutCache.MaxLayouts"),
+	4096,
+	TEXT("Maximum number of layouts kept by the shared spline mesh layout cache, read when the cache is emptied"));
+
+static FAutoConsoleCommand CmdLayoutCacheStats(
+	TEXT("dsm.LayoutCache.Stats"),
+	TEXT("Print the hit rate and memory of the shared spline mesh layout cache"),
+	FConsoleCommandDelegate::CreateLambda([]() { FSplineMeshLayoutCache::Get().LogStats(); }));
+
+static FAutoConsoleCommand CmdLayoutCacheClear(
+	TEXT("dsm.LayoutCache.Clear"),
+	TEXT("Empty the shared spline mesh layout cache"),
+	FConsoleCommandDelegate::CreateLambda([]() { FSplineMeshLayoutCache::Get().Empty(); }));
+
+FSplineMeshLayoutCache::FSplineMeshLayoutCache() : layouts(CVarLayoutCacheMaxLayouts.GetValueOnAnyThread())
+{
+}
+
+FSplineMeshLayoutCache& FSplineMeshLayoutCache::Get()
+{
+	static FSplineMeshLayoutCache _cache;
+	return _cache;
+}
+
+bool FSplineMeshLayoutCache::IsEnabled()
+{
+	return CVarLayoutCacheMaxMemoryKB.GetValueOnAnyThread() > 0;
+}
+
+bool FSplineMeshLayoutCache::Find(const uint64 _key, TArray<FSplineMeshSegment>& _segments)
+{
+	FScopeLock _lock(&lock);
+
+	// Get the layout and mark it as the most recently used
+	const TSharedPtr<FSplineMeshCachedLayout>* _layout = layouts.FindAndTouch(_key);
+	if (!_layout)
+	{
+		misses++;
+		DSM_INC_COUNTER(LayoutCacheMisses, 1);
+		return false;
+	}
+
+	hits++;
+	DSM_INC_COUNTER(LayoutCacheHits, 1);
+	_segments = (*_layout)->segments;
+	return true;
+}
+
+void FSplineMeshLayoutCache::Add(const uint64 _key, const TArray<FSplineMeshSegment>& _segments)
+{
+	FScopeLock _lock(&lock);
+
+	// The layout may have been added by another thread in the meantime
+	if (layouts.Contains(_key)) return;
+
+	// Don't cache a layout bigger than the whole cache
+	const TSharedPtr<FSplineMeshCachedLayout> _layout = MakeShared<FSplineMeshCachedLayout>();
+	_layout->segments = _segments;
+	const SIZE_T _maxMemory = static_cast<SIZE_T>(FMath::Max(CVarLayoutCacheMaxMemoryKB.GetValueOnAnyThread(), 0)) * 1024;
+	const SIZE_T _layoutMemory = _layout->GetAllocatedSize();
+	if (_layoutMemory > _maxMemory) return;
+
+	// Evict the least recently used layouts until the new one fits
+	while (layouts.Num() > 0 && (memory + _layoutMemory > _maxMemory || layouts.Num() >= layouts.Max()))
+	{
+		const TSharedPtr<FSplineMeshCachedLayout> _evictedLayout = layouts.RemoveLeastRecent();
+		memory -= _evictedLayout ? _evictedLayout->GetAllocatedSize() : 0;
+		evictions++;
+	}
+
+	layouts.Add(_key, _layout);
+	memory += _layoutMemory;
+}
+
+void FSplineMeshLayoutCache::Empty()
+{
+	FScopeLock _lock(&lock);
+
+	layouts.Empty(CVarLayoutCacheMaxLayouts.GetValueOnAnyThread());
+	memory = 0;
+	hits = 0;
+	misses = 0;
+	evictions = 0;
+}
+
+void FSplineMeshLayoutCache::LogStats() const
+{
+	FScopeLock _lock(&lock);
+
+	const int64 _lookups = hits + misses;
+	const double _hitRate = _lookups > 0 ? static_cast<double>(hits) / _lookups * 100.0 : 0.0;
+	UE_LOG(LogDynamicSplineMesh, Display, TEXT("Layout cache: %d layouts, %.1f KB, %lld hits, %lld misses (%.1f%% hit rate), %lld evictions"),
+		layouts.Num(), memory / 1024.0, hits, misses, _hitRate, evictions);
+}
+
+void FSplineMeshLayoutCache::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	FScopeLock _lock(&lock);
+
+	// Keep the meshes of the cached segments loaded, a hit hands them out again
+	for (TLruCache<uint64, TSharedPtr<FSplineMeshCachedLayout>>::TIterator _it(layouts); _it; ++_it)
+	{
+		const TSharedPtr<FSplineMeshCachedLayout>& _layout = _it.Value();
+		if (!_layout) continue;
+
+		for (FSplineMeshSegment& _segment : _layout->segments)
+		{
+			Collector.AddReferencedObject(_segment.meshComposition.mesh);
+			Collector.AddReferencedObject(_segment.meshComposition.lodMesh);
+		}
+	}
+}
+
+FString FSplineMeshLayoutCache::GetReferencerName() const
+{
+	return TEXT("FSplineMeshLayoutCache");
+}
\ No newline at end of file
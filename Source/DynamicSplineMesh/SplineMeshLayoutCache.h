@@ -0,0 +1,86 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "UObject/GCObject.h"
+#include "STRUCT_SplineMeshSegment.h"
+
+/* The evaluated segments of a layout, in the local space of the spline */
+struct FSplineMeshCachedLayout
+{
+	/* The segments in placement order, before their rotation */
+	TArray<FSplineMeshSegment> segments = TArray<FSplineMeshSegment>();
+
+	/* Memory used by the layout */
+	SIZE_T GetAllocatedSize() const
+	{
+		return sizeof(FSplineMeshCachedLayout) + segments.GetAllocatedSize();
+	}
+};
+
+/*
+ * Process wide cache of the evaluated layouts
+ * Keyed by the hash of the local curve and of every other input of the segments, so the copies of a spline placed anywhere share them
+ * Evicts the least recently used layouts over the memory cap, and keeps the meshes of the cached segments loaded
+ */
+class DYNAMICSPLINEMESH_API FSplineMeshLayoutCache : public FGCObject
+{
+	/* The cached layouts */
+	TLruCache<uint64, TSharedPtr<FSplineMeshCachedLayout>> layouts;
+
+	/* Memory used by the cached layouts */
+	SIZE_T memory = 0;
+
+	/* Number of lookups that found a layout */
+	int64 hits = 0;
+
+	/* Number of lookups that didn't find a layout */
+	int64 misses = 0;
+
+	/* Number of layouts evicted to respect the memory cap */
+	int64 evictions = 0;
+
+	/* Lock allowing the layouts to be computed from several threads */
+	mutable FCriticalSection lock;
+
+public:
+	FSplineMeshLayoutCache();
+
+	/* Get the cache shared by the whole process */
+	static FSplineMeshLayoutCache& Get();
+
+	/* Check if the cache is enabled, it is disabled by a memory cap of 0 */
+	static bool IsEnabled();
+
+	/* Copy the segments cached for a key, returns false if they aren't cached */
+	bool Find(const uint64 _key, TArray<FSplineMeshSegment>& _segments);
+
+	/* Add the segments computed for a key */
+	void Add(const uint64 _key, const TArray<FSplineMeshSegment>& _segments);
+
+	/* Remove all the cached layouts and reset the counters */
+	void Empty();
+
+	/* Print the counters of the cache in the log */
+	void LogStats() const;
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+
+	FORCEINLINE int64 GetHits() const
+	{
+		FScopeLock _lock(&lock);
+		return hits;
+	}
+
+	FORCEINLINE int64 GetMisses() const
+	{
+		FScopeLock _lock(&lock);
+		return misses;
+	}
+
+	FORCEINLINE SIZE_T GetMemory() const
+	{
+		FScopeLock _lock(&lock);
+		return memory;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "STRUCT_MeshComposition.h"
+#include "STRUCT_SplineMeshLane.h"
+#include "SplineLayout/SplineLayout.h"
+
+/*
+ * Copy of everything the layout reads, taken on the game thread once the spline is prepared
+ * The segments are computed from it alone, so the actor and its spline can change while they are computed
+ */
+struct FSplineMeshLayoutInputs
+{
+	/* The spline in its local space */
+	SplineLayout::HermiteSpline hermiteSpline = SplineLayout::HermiteSpline();
+
+	/* The composition and the placement of the spline itself */
+	FSplineMeshLane mainLane = FSplineMeshLane();
+
+	/* The lanes placed at an offset of the spline */
+	TArray<FSplineMeshLane> lanes = TArray<FSplineMeshLane>();
+
+	/* Distance between two frames of the table read by the lanes */
+	float laneFrameSpacing = 25.0f;
+
+	/* Seed of the random compositions */
+	int seed = 0;
+
+	/* Up vector of the meshes lifted above the ground, null when the spline isn't snapped on the ground */
+	FVector groundUp = FVector::ZeroVector;
+
+	/* Distances along the spline of the bridges */
+	TArray<FVector2D> bridgeRanges = TArray<FVector2D>();
+
+	/* Whether the bridges are decks laid along a sag profile, the values below are only read then */
+	bool hasBridgeDecks = false;
+
+	FMeshComposition deckComposition = FMeshComposition();
+
+	SplineLayout::SagProfile sagProfile = SplineLayout::SagProfile::Catenary;
+
+	/* Depth of the decks at the middle of each bay, positive downward */
+	double sag = 0.0;
+
+	float supportSpacing = 0.0f;
+
+	/* The world up in the space of the spline, the decks sag against it whatever the rotation of the actor */
+	FVector deckUp = FVector::UpVector;
+
+	/* Key of the segments in the shared layout cache, 0 when they aren't cached */
+	uint64 cacheKey = 0;
+};
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/* A mesh placed by a layout plan */
+struct FSplineMeshPlanEntry
+{
+	/* Index of the mesh composition in the meshes composition, INDEX_NONE for the fill mesh composition */
+	int compositionIndex = INDEX_NONE;
+
+	/* The distance along the spline where the mesh starts */
+	float startDistance = 0.0f;
+
+	/* The length of the mesh along the spline */
+	float length = 0.0f;
+
+	FSplineMeshPlanEntry() {}
+	FSplineMeshPlanEntry(const int _compositionIndex, const float _startDistance, const float _length)
+	{
+		compositionIndex = _compositionIndex;
+		startDistance = _startDistance;
+		length = _length;
+	}
+};
+
+/* The meshes placed along a spline, in the local distance space of the spline */
+struct FSplineMeshPlan
+{
+	/* The meshes of the plan in placement order */
+	TArray<FSplineMeshPlanEntry> entries = TArray<FSplineMeshPlanEntry>();
+};
\ No newline at end of file
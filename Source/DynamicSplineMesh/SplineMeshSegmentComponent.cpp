@@ -0,0 +1,27 @@
+#include "SplineMeshSegmentComponent.h"
+
+#include "DynamicSplineMeshActor.h"
+#include "DynamicSplineMeshStats.h"
+#include "WorldPartition/HLOD/HLODBuilder.h"
+
+void USplineMeshSegmentComponent::OnRegister()
+{
+	Super::OnRegister();
+	INC_DWORD_STAT(STAT_DSM_ComponentsAlive);
+}
+
+void USplineMeshSegmentComponent::OnUnregister()
+{
+	DEC_DWORD_STAT(STAT_DSM_ComponentsAlive);
+	Super::OnUnregister();
+}
+
+#if WITH_EDITOR
+
+TSubclassOf<UHLODBuilder> USplineMeshSegmentComponent::GetCustomHLODBuilderClass() const
+{
+	const ADynamicSplineMeshActor* _actor = Cast<ADynamicSplineMeshActor>(GetOwner());
+	return _actor ? _actor->GetHLODBuilderClass() : nullptr;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Components/SplineMeshComponent.h"
+#include "SplineMeshSegmentComponent.generated.h"
+
+/*
+ * Spline mesh generated for a segment of a spline actor
+ * Hands its owner's HLOD builder to the world partition, so the segments are merged in a proxy of the actor
+ */
+UCLASS(ClassGroup = "DynamicSplineMesh")
+class DYNAMICSPLINEMESH_API USplineMeshSegmentComponent : public USplineMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	/* The registered components are the alive ones, whether generated, loaded or restored */
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+
+	#if WITH_EDITOR
+
+	virtual TSubclassOf<UHLODBuilder> GetCustomHLODBuilderClass() const override;
+
+	#endif
+};
\ No newline at end of file
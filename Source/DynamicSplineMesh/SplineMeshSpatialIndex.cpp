@@ -0,0 +1,272 @@
+#include "SplineMeshSpatialIndex.h"
+
+/* Max number of cells overlapped by an entry stored in the grid */
+static constexpr int64 MaxCellsPerEntry = 512;
+
+FSplineMeshSpatialIndex::FSplineMeshSpatialIndex(const float _cellSize)
+{
+	cellSize = FMath::Max(_cellSize, 1.0f);
+}
+
+void FSplineMeshSpatialIndex::SetEntries(const uint32 _ownerId, const TArray<FSplineMeshSpatialEntry>& _entries)
+{
+	RemoveOwner(_ownerId);
+	if (_entries.IsEmpty()) return;
+
+	// Add the new entries of the owner
+	TArray<int32>& _ownerEntries = ownerEntries.Add(_ownerId);
+	_ownerEntries.Reserve(_entries.Num());
+	for (FSplineMeshSpatialEntry _entry : _entries)
+	{
+		_entry.ownerId = _ownerId;
+		AddEntry(_entry, _ownerEntries);
+	}
+}
+
+void FSplineMeshSpatialIndex::RemoveOwner(const uint32 _ownerId)
+{
+	TArray<int32> _ownerEntries = TArray<int32>();
+	if (!ownerEntries.RemoveAndCopyValue(_ownerId, _ownerEntries)) return;
+
+	for (const int32 _entryIndex : _ownerEntries)
+	{
+		RemoveEntry(_entryIndex);
+	}
+}
+
+void FSplineMeshSpatialIndex::Empty()
+{
+	entries.Empty();
+	cells.Empty();
+	oversizedEntries.Empty();
+	ownerEntries.Empty();
+}
+
+bool FSplineMeshSpatialIndex::FindNearest(const FVector& _location, const float _maxDistance, FSplineMeshSpatialHit& _hit) const
+{
+	if (entries.Num() == 0 || _maxDistance <= 0.0f) return false;
+
+	// Grow the search radius until a segment is found inside it
+	float _radius = FMath::Min(cellSize, _maxDistance);
+	while (true)
+	{
+		// A centerline inside the radius has its bounds inside the searched box
+		int32 _bestIndex = INDEX_NONE;
+		float _bestDistanceSquared = FMath::Square(_radius);
+		ForEachEntry(FBox::BuildAABB(_location, FVector(_radius)), [&](const int32 _entryIndex)
+		{
+			const FSplineMeshSpatialEntry& _entry = entries[_entryIndex];
+			if (_entry.bounds.ComputeSquaredDistanceToPoint(_location) > _bestDistanceSquared) return;
+
+			float _alpha = 0.0f;
+			const float _distanceSquared = FVector::DistSquared(_entry.GetClosestPoint(_location, _alpha), _location);
+			if (_distanceSquared > _bestDistanceSquared) return;
+
+			_bestDistanceSquared = _distanceSquared;
+			_bestIndex = _entryIndex;
+		});
+
+		if (_bestIndex != INDEX_NONE)
+		{
+			const FSplineMeshSpatialEntry& _entry = entries[_bestIndex];
+			float _alpha = 0.0f;
+			const FVector& _closestPoint = _entry.GetClosestPoint(_location, _alpha);
+			_hit = MakeHit(_entry, _closestPoint, _alpha, FMath::Sqrt(_bestDistanceSquared));
+			return true;
+		}
+
+		if (_radius >= _maxDistance) return false;
+		_radius = FMath::Min(_radius * 2.0f, _maxDistance);
+	}
+}
+
+void FSplineMeshSpatialIndex::Overlap(const FVector& _center, const float _radius, TArray<FSplineMeshSpatialHit>& _hits) const
+{
+	_hits.Reset();
+	if (entries.Num() == 0 || _radius < 0.0f) return;
+
+	// Gather the entries once, they can be stored in several cells
+	TArray<int32> _candidates = TArray<int32>();
+	const float _radiusSquared = FMath::Square(_radius);
+	ForEachEntry(FBox::BuildAABB(_center, FVector(_radius)), [&](const int32 _entryIndex)
+	{
+		if (FMath::SphereAABBIntersection(_center, _radiusSquared, entries[_entryIndex].bounds)) _candidates.Add(_entryIndex);
+	});
+
+	_candidates.Sort();
+	int32 _previousIndex = INDEX_NONE;
+	for (const int32 _entryIndex : _candidates)
+	{
+		if (_entryIndex == _previousIndex) continue;
+		_previousIndex = _entryIndex;
+
+		const FSplineMeshSpatialEntry& _entry = entries[_entryIndex];
+		float _alpha = 0.0f;
+		const FVector& _closestPoint = _entry.GetClosestPoint(_center, _alpha);
+		_hits.Add(MakeHit(_entry, _closestPoint, _alpha, FVector::Dist(_closestPoint, _center)));
+	}
+
+	_hits.Sort([](const FSplineMeshSpatialHit& _a, const FSplineMeshSpatialHit& _b) { return _a.distance < _b.distance; });
+}
+
+bool FSplineMeshSpatialIndex::Raycast(const FVector& _start, const FVector& _end, FSplineMeshSpatialHit& _hit) const
+{
+	if (entries.Num() == 0) return false;
+
+	const FVector& _direction = _end - _start;
+	const float _length = _direction.Size();
+	if (_length <= UE_KINDA_SMALL_NUMBER) return false;
+
+	// Keep the closest crossed bounds, as a time along the ray
+	int32 _bestIndex = INDEX_NONE;
+	float _bestTime = 1.0f;
+	FVector _bestLocation = FVector::ZeroVector;
+	const auto _testEntry = [&](const int32 _entryIndex)
+	{
+		const FSplineMeshSpatialEntry& _entry = entries[_entryIndex];
+		FVector _location = FVector::ZeroVector;
+		FVector _normal = FVector::ZeroVector;
+		float _time = 0.0f;
+		if (!FMath::LineExtentBoxIntersection(_entry.bounds, _start, _end, FVector::ZeroVector, _location, _normal, _time)) return;
+		if (_bestIndex != INDEX_NONE && _time >= _bestTime) return;
+
+		_bestIndex = _entryIndex;
+		_bestTime = _time;
+		_bestLocation = _location;
+	};
+
+	for (const int32 _entryIndex : oversizedEntries)
+	{
+		_testEntry(_entryIndex);
+	}
+
+	// Walk the cells crossed by the ray
+	FIntVector _cell = GetCell(_start);
+	const FIntVector& _endCell = GetCell(_end);
+	FIntVector _step = FIntVector::ZeroValue;
+	FVector _nextTime = FVector(TNumericLimits<float>::Max());
+	FVector _deltaTime = FVector(TNumericLimits<float>::Max());
+	for (int _axis = 0; _axis < 3; _axis++)
+	{
+		if (FMath::IsNearlyZero(_direction[_axis])) continue;
+
+		_step[_axis] = _direction[_axis] > 0.0 ? 1 : -1;
+		const double _boundary = (_cell[_axis] + (_step[_axis] > 0 ? 1 : 0)) * cellSize;
+		_nextTime[_axis] = (_boundary - _start[_axis]) / _direction[_axis];
+		_deltaTime[_axis] = cellSize / FMath::Abs(_direction[_axis]);
+	}
+
+	const int _maxSteps = FMath::Abs(_endCell.X - _cell.X) + FMath::Abs(_endCell.Y - _cell.Y) + FMath::Abs(_endCell.Z - _cell.Z) + 1;
+	for (int _stepIndex = 0; _stepIndex < _maxSteps; _stepIndex++)
+	{
+		if (const TArray<int32>* _entries = cells.Find(_cell))
+		{
+			for (const int32 _entryIndex : *_entries)
+			{
+				_testEntry(_entryIndex);
+			}
+		}
+
+		// The hit is closer than any bounds of the next cells
+		const float _exitTime = _nextTime.GetMin();
+		if ((_bestIndex != INDEX_NONE && _bestTime <= _exitTime) || _exitTime > 1.0f) break;
+
+		const int _axis = _nextTime.X <= _nextTime.Y && _nextTime.X <= _nextTime.Z ? 0 : _nextTime.Y <= _nextTime.Z ? 1 : 2;
+		_cell[_axis] += _step[_axis];
+		_nextTime[_axis] += _deltaTime[_axis];
+	}
+
+	if (_bestIndex == INDEX_NONE) return false;
+
+	const FSplineMeshSpatialEntry& _entry = entries[_bestIndex];
+	float _alpha = 0.0f;
+	_entry.GetClosestPoint(_bestLocation, _alpha);
+	_hit = MakeHit(_entry, _bestLocation, _alpha, _bestTime * _length);
+	return true;
+}
+
+SIZE_T FSplineMeshSpatialIndex::GetAllocatedSize() const
+{
+	SIZE_T _size = entries.GetAllocatedSize() + cells.GetAllocatedSize() + oversizedEntries.GetAllocatedSize() + ownerEntries.GetAllocatedSize();
+	for (const TPair<FIntVector, TArray<int32>>& _cell : cells)
+	{
+		_size += _cell.Value.GetAllocatedSize();
+	}
+
+	for (const TPair<uint32, TArray<int32>>& _owner : ownerEntries)
+	{
+		_size += _owner.Value.GetAllocatedSize();
+	}
+
+	return _size;
+}
+
+void FSplineMeshSpatialIndex::AddEntry(const FSplineMeshSpatialEntry& _entry, TArray<int32>& _ownerEntries)
+{
+	if (!_entry.bounds.IsValid) return;
+
+	const int32 _entryIndex = entries.Add(_entry);
+	_ownerEntries.Add(_entryIndex);
+
+	// Store the entry apart when it overlaps too many cells
+	const FIntVector& _min = GetCell(_entry.bounds.Min);
+	const FIntVector& _max = GetCell(_entry.bounds.Max);
+	const int64 _cellsCount = int64(_max.X - _min.X + 1) * (_max.Y - _min.Y + 1) * (_max.Z - _min.Z + 1);
+	if (_cellsCount > MaxCellsPerEntry)
+	{
+		oversizedEntries.Add(_entryIndex);
+		return;
+	}
+
+	for (int _x = _min.X; _x <= _max.X; _x++)
+	{
+		for (int _y = _min.Y; _y <= _max.Y; _y++)
+		{
+			for (int _z = _min.Z; _z <= _max.Z; _z++)
+			{
+				cells.FindOrAdd(FIntVector(_x, _y, _z)).Add(_entryIndex);
+			}
+		}
+	}
+}
+
+void FSplineMeshSpatialIndex::RemoveEntry(const int32 _entryIndex)
+{
+	if (!entries.IsValidIndex(_entryIndex)) return;
+
+	// Remove the entry from the cells it was added to
+	const FBox& _bounds = entries[_entryIndex].bounds;
+	if (oversizedEntries.RemoveSwap(_entryIndex) == 0)
+	{
+		const FIntVector& _min = GetCell(_bounds.Min);
+		const FIntVector& _max = GetCell(_bounds.Max);
+		for (int _x = _min.X; _x <= _max.X; _x++)
+		{
+			for (int _y = _min.Y; _y <= _max.Y; _y++)
+			{
+				for (int _z = _min.Z; _z <= _max.Z; _z++)
+				{
+					const FIntVector _cellKey = FIntVector(_x, _y, _z);
+					TArray<int32>* _cell = cells.Find(_cellKey);
+					if (!_cell) continue;
+
+					_cell->RemoveSwap(_entryIndex);
+					if (_cell->IsEmpty()) cells.Remove(_cellKey);
+				}
+			}
+		}
+	}
+
+	entries.RemoveAt(_entryIndex);
+}
+
+FSplineMeshSpatialHit FSplineMeshSpatialIndex::MakeHit(const FSplineMeshSpatialEntry& _entry, const FVector& _location, const float _alpha, const float _distance) const
+{
+	FSplineMeshSpatialHit _hit = FSplineMeshSpatialHit();
+	_hit.ownerId = _entry.ownerId;
+	_hit.segmentIndex = _entry.segmentIndex;
+	_hit.location = _location;
+	_hit.distance = _distance;
+	_hit.distanceAlongSpline = FMath::Lerp(_entry.startDistance, _entry.endDistance, FMath::Clamp(_alpha, 0.0f, 1.0f));
+	return _hit;
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/* A generated segment in world space */
+struct FSplineMeshSpatialEntry
+{
+	/* Unique id of the actor owning the segment */
+	uint32 ownerId = 0;
+
+	/* Index of the segment in the layout of its actor */
+	int segmentIndex = INDEX_NONE;
+
+	/* World bounds of the mesh of the segment */
+	FBox bounds = FBox(ForceInit);
+
+	/* World location of the start of the segment */
+	FVector start = FVector::ZeroVector;
+
+	/* World location of the end of the segment */
+	FVector end = FVector::ZeroVector;
+
+	/* Distance along the spline of the start of the segment */
+	float startDistance = 0.0f;
+
+	/* Distance along the spline of the end of the segment */
+	float endDistance = 0.0f;
+
+	/* Get the closest point of the segment to a location and its ratio along the segment */
+	FORCEINLINE FVector GetClosestPoint(const FVector& _location, float& _alpha) const
+	{
+		const FVector& _closestPoint = FMath::ClosestPointOnSegment(_location, start, end);
+		const double _sizeSquared = (end - start).SizeSquared();
+		_alpha = _sizeSquared > UE_SMALL_NUMBER ? FVector::DotProduct(_closestPoint - start, end - start) / _sizeSquared : 0.0f;
+		return _closestPoint;
+	}
+};
+
+/* The result of a query on the spatial index */
+struct FSplineMeshSpatialHit
+{
+	/* Unique id of the actor owning the segment */
+	uint32 ownerId = 0;
+
+	/* Index of the segment in the layout of its actor */
+	int segmentIndex = INDEX_NONE;
+
+	/* Closest point of the segment, or the entry point of a ray */
+	FVector location = FVector::ZeroVector;
+
+	/* Distance from the query to the location */
+	float distance = 0.0f;
+
+	/* Distance along the spline of the location */
+	float distanceAlongSpline = 0.0f;
+};
+
+/*
+ * Uniform grid over the bounds of the generated segments
+ * A segment is stored in every cell its bounds overlap, the segments overlapping too many cells are tested by every query
+ * Updated per actor, queries are read only and can run in parallel between two updates
+ */
+class DYNAMICSPLINEMESH_API FSplineMeshSpatialIndex
+{
+	/* Size of a cell of the grid */
+	float cellSize = 2000.0f;
+
+	/* The indexed segments */
+	TSparseArray<FSplineMeshSpatialEntry> entries = TSparseArray<FSplineMeshSpatialEntry>();
+
+	/* The entries of each non empty cell */
+	TMap<FIntVector, TArray<int32>> cells = TMap<FIntVector, TArray<int32>>();
+
+	/* The entries overlapping too many cells to be stored in the grid */
+	TArray<int32> oversizedEntries = TArray<int32>();
+
+	/* The entries of each owner */
+	TMap<uint32, TArray<int32>> ownerEntries = TMap<uint32, TArray<int32>>();
+
+public:
+	explicit FSplineMeshSpatialIndex(const float _cellSize = 2000.0f);
+
+	/* Replace the segments of an owner */
+	void SetEntries(const uint32 _ownerId, const TArray<FSplineMeshSpatialEntry>& _entries);
+
+	/* Remove the segments of an owner */
+	void RemoveOwner(const uint32 _ownerId);
+
+	/* Remove all the segments */
+	void Empty();
+
+	/* Find the segment whose centerline is the closest to a location, within a max distance */
+	bool FindNearest(const FVector& _location, const float _maxDistance, FSplineMeshSpatialHit& _hit) const;
+
+	/* Find the segments whose bounds overlap a sphere, sorted by distance */
+	void Overlap(const FVector& _center, const float _radius, TArray<FSplineMeshSpatialHit>& _hits) const;
+
+	/* Find the first segment whose bounds are crossed by a ray */
+	bool Raycast(const FVector& _start, const FVector& _end, FSplineMeshSpatialHit& _hit) const;
+
+	FORCEINLINE int Num() const
+	{
+		return entries.Num();
+	}
+
+	FORCEINLINE float GetCellSize() const
+	{
+		return cellSize;
+	}
+
+	/* Memory used by the index */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/* Get the cell containing a location */
+	FORCEINLINE FIntVector GetCell(const FVector& _location) const
+	{
+		return FIntVector(FMath::FloorToInt(_location.X / cellSize), FMath::FloorToInt(_location.Y / cellSize), FMath::FloorToInt(_location.Z / cellSize));
+	}
+
+	/* Add an entry in the cells overlapped by its bounds */
+	void AddEntry(const FSplineMeshSpatialEntry& _entry, TArray<int32>& _ownerEntries);
+
+	/* Remove an entry from its cells */
+	void RemoveEntry(const int32 _entryIndex);
+
+	/* Call _visit(entryIndex) for the entries of the cells overlapping a box and the oversized entries, an entry can be visited more than once */
+	template <typename Visit>
+	void ForEachEntry(const FBox& _box, Visit&& _visit) const
+	{
+		for (const int32 _entryIndex : oversizedEntries)
+		{
+			_visit(_entryIndex);
+		}
+
+		const FIntVector& _min = GetCell(_box.Min);
+		const FIntVector& _max = GetCell(_box.Max);
+		for (int _x = _min.X; _x <= _max.X; _x++)
+		{
+			for (int _y = _min.Y; _y <= _max.Y; _y++)
+			{
+				for (int _z = _min.Z; _z <= _max.Z; _z++)
+				{
+					const TArray<int32>* _cell = cells.Find(FIntVector(_x, _y, _z));
+					if (!_cell) continue;
+
+					for (const int32 _entryIndex : *_cell)
+					{
+						_visit(_entryIndex);
+					}
+				}
+			}
+		}
+	}
+
+	/* Make the hit of an entry at a location */
+	FSplineMeshSpatialHit MakeHit(const FSplineMeshSpatialEntry& _entry, const FVector& _location, const float _alpha, const float _distance) const;
+};
\ No newline at end of file
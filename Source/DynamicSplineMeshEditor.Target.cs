@@ -11,5 +11,6 @@ public class DynamicSplineMeshEditorTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V2;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_1;
 		ExtraModuleNames.Add("DynamicSplineMesh");
+		ExtraModuleNames.Add("DynamicSplineMeshEditor");
 	}
 }
@@ -0,0 +1,733 @@
+#include "DynamicSplineMeshBenchmarkCommandlet.h"
+
+#include "DynamicSplineMeshActor.h"
+#include "DynamicSplineMeshEditor.h"
+#include "Dom/JsonObject.h"
+#include "Engine/StaticMeshActor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "SplineLayoutAdapter.h"
+#include "SplineMeshLayoutCache.h"
+#include "SplineMeshSpatialIndex.h"
+
+namespace DynamicSplineMeshBenchmark
+{
+	/* Mesh used by all the scenarios */
+	static const TCHAR* MeshPath = TEXT("/Engine/BasicShapes/Cube.Cube");
+
+	/* Size of a heightfield tile */
+	static constexpr float TileSize = 1000.0f;
+
+	/* Distance between two spline points */
+	static constexpr float PointSpacing = 5000.0f;
+
+	/* Budget of a scatter layer, in milliseconds per 1000 props */
+	static constexpr double ScatterBudget = 1.0;
+
+	/* Height of the ground at a distance */
+	FORCEINLINE float GetGroundHeight(const float _x)
+	{
+		return FMath::Sin(_x * 0.0005f) * 200.0f;
+	}
+
+	/* Set a property of the actor from its text value */
+	bool SetActorProperty(ADynamicSplineMeshActor* _actor, const FName& _name, const FString& _value)
+	{
+		const FProperty* _property = FindFProperty<FProperty>(ADynamicSplineMeshActor::StaticClass(), _name);
+		return _property && _property->ImportText_InContainer(*_value, _actor, _actor, PPF_None);
+	}
+}
+
+UDynamicSplineMeshBenchmarkCommandlet::UDynamicSplineMeshBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UDynamicSplineMeshBenchmarkCommandlet::Main(const FString& Params)
+{
+	TArray<FString> _tokens = TArray<FString>();
+	TArray<FString> _switches = TArray<FString>();
+	TMap<FString, FString> _params = TMap<FString, FString>();
+	ParseCommandLine(*Params, _tokens, _switches, _params);
+
+	// Read the options
+	const FString _outputFile = _params.Contains(TEXT("Output")) ? _params[TEXT("Output")] : FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("DynamicSplineMesh.json");
+	const FString _baselineFile = _params.FindRef(TEXT("Baseline"));
+	const double _threshold = _params.Contains(TEXT("Threshold")) ? FCString::Atod(*_params[TEXT("Threshold")]) : 0.1;
+	const int _iterations = _params.Contains(TEXT("Iterations")) ? FMath::Max(1, FCString::Atoi(*_params[TEXT("Iterations")])) : 3;
+
+	// Benchmark the spatial index alone
+	if (_switches.Contains(TEXT("SpatialIndex")) || _params.Contains(TEXT("SpatialIndex")))
+	{
+		const int _segmentsCount = _params.Contains(TEXT("SpatialIndex")) ? FMath::Max(1, FCString::Atoi(*_params[TEXT("SpatialIndex")])) : 100000;
+		RunSpatialIndexBenchmark(_segmentsCount, _params.Contains(TEXT("Output")) ? _outputFile : FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("DynamicSplineMeshSpatialIndex.json"));
+		return 0;
+	}
+
+	// Benchmark the spline evaluation alone
+	if (_switches.Contains(TEXT("Evaluate")) || _params.Contains(TEXT("Evaluate")))
+	{
+		const int _queriesCount = _params.Contains(TEXT("Evaluate")) ? FMath::Max(1, FCString::Atoi(*_params[TEXT("Evaluate")])) : 1000000;
+		RunEvaluateBenchmark(_queriesCount, _iterations, _params.Contains(TEXT("Output")) ? _outputFile : FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("DynamicSplineMeshEvaluate.json"));
+		return 0;
+	}
+
+	// Benchmark the parallel layout alone
+	if (_switches.Contains(TEXT("ParallelLayout")) || _params.Contains(TEXT("ParallelLayout")))
+	{
+		const int _segmentsCount = _params.Contains(TEXT("ParallelLayout")) ? FMath::Max(1, FCString::Atoi(*_params[TEXT("ParallelLayout")])) : 10000;
+		const int _maxTasks = _params.Contains(TEXT("MaxTasks")) ? FMath::Max(1, FCString::Atoi(*_params[TEXT("MaxTasks")])) : 32;
+		RunParallelLayoutBenchmark(_segmentsCount, _maxTasks, _iterations, _params.Contains(TEXT("Output")) ? _outputFile : FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("DynamicSplineMeshParallelLayout.json"));
+		return 0;
+	}
+
+	// Benchmark the scatter layers alone
+	if (_switches.Contains(TEXT("Scatter")) || _params.Contains(TEXT("Scatter")))
+	{
+		const int _propsCount = _params.Contains(TEXT("Scatter")) ? FMath::Max(1, FCString::Atoi(*_params[TEXT("Scatter")])) : 10000;
+		const int _overBudgetCount = RunScatterBenchmark(_propsCount, _iterations, _params.Contains(TEXT("Output")) ? _outputFile : FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("DynamicSplineMeshScatter.json"));
+		return _overBudgetCount > 0 ? 1 : 0;
+	}
+
+	const TArray<FSplineMeshBenchmarkScenario>& _scenarios = BuildScenarios(_switches.Contains(TEXT("Quick")));
+
+	// Create the synthetic world
+	UWorld* _world = UWorld::CreateWorld(EWorldType::Game, false, TEXT("DynamicSplineMeshBenchmark"));
+	FWorldContext& _worldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	_worldContext.SetCurrentWorld(_world);
+
+	float _maxLength = 0.0f;
+	for (const FSplineMeshBenchmarkScenario& _scenario : _scenarios)
+	{
+		_maxLength = FMath::Max(_maxLength, _scenario.length);
+	}
+	SpawnHeightfield(_world, _maxLength);
+
+	// Run through the scenarios
+	TArray<FSplineMeshBenchmarkResult> _results = TArray<FSplineMeshBenchmarkResult>();
+	const int _scenarioCount = _scenarios.Num();
+	for (int _scenarioIndex = 0; _scenarioIndex < _scenarioCount; _scenarioIndex++)
+	{
+		const FSplineMeshBenchmarkResult& _result = RunScenario(_world, _scenarios[_scenarioIndex], _iterations);
+		UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("[%d/%d] %s: %d segments, %.3f ms"), _scenarioIndex + 1, _scenarioCount, *_result.name, _result.segments, _result.stats.GetTotalTime() * 1000.0);
+		_results.Add(_result);
+
+		// Release the destroyed actors from time to time
+		if (_scenarioIndex % 16 == 15) CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	// Write the results
+	FString _json = FString();
+	const TSharedRef<TJsonWriter<>> _writer = TJsonWriterFactory<>::Create(&_json);
+	FJsonSerializer::Serialize(ToJson(_results, _iterations), _writer);
+	FFileHelper::SaveStringToFile(_json, *_outputFile);
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("Results written to %s"), *_outputFile);
+
+	// Compare with the baseline
+	const int _regressionCount = _baselineFile.IsEmpty() ? 0 : CompareWithBaseline(_results, _baselineFile, _threshold);
+
+	// Release the world
+	GEngine->DestroyWorldContext(_world);
+	_world->DestroyWorld(false);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return _regressionCount > 0 ? 1 : 0;
+}
+
+TArray<FSplineMeshBenchmarkScenario> UDynamicSplineMeshBenchmarkCommandlet::BuildScenarios(const bool _quick) const
+{
+	using namespace DynamicSplineMeshBenchmark;
+
+	// From 1 m to 10 km
+	TArray<float> _lengths = { 100.0f, 1000.0f, 10000.0f, 100000.0f, 1000000.0f };
+	if (_quick) _lengths.Pop();
+
+	const TArray<FString> _compositionMethods = { TEXT("FILL"), TEXT("USUAL"), TEXT("RANDOM"), TEXT("PATTERN") };
+	const TArray<FString> _placementMethods = { TEXT("DUPLICATE"), TEXT("EXTEND") };
+	const TArray<FString> _rotationMethods = { TEXT("NONE"), TEXT("REGULAR"), TEXT("IRREGULAR"), TEXT("GROUP"), TEXT("ANGLE") };
+
+	// Compositions and rotations shared by all the scenarios
+	const FString& _meshComposition = FString::Printf(TEXT("(mesh=\"%s\",scaleFactor=1.0)"), MeshPath);
+	const FString& _capComposition = FString::Printf(TEXT("((mesh=\"%s\",scaleFactor=2.0))"), MeshPath);
+	FString _meshesComposition = FString();
+	FString _meshesRotation = FString();
+	for (int _index = 0; _index < 16; _index++)
+	{
+		_meshesComposition += FString::Printf(TEXT("%s(mesh=\"%s\",scaleFactor=%.1f)"), _index > 0 ? TEXT(",") : TEXT(""), MeshPath, 0.5f + (_index % 4) * 0.5f);
+		_meshesRotation += FString::Printf(TEXT("%s(axisRotation=%s,angle=%.1f)"), _index > 0 ? TEXT(",") : TEXT(""), _index % 2 ? TEXT("ROTATE_X") : TEXT("ROTATE_Z"), _index * 5.0f);
+	}
+
+	TArray<FSplineMeshBenchmarkScenario> _scenarios = TArray<FSplineMeshBenchmarkScenario>();
+	for (const float _length : _lengths)
+	for (const FString& _compositionMethod : _compositionMethods)
+	for (const FString& _placementMethod : _placementMethods)
+	for (const FString& _rotationMethod : _rotationMethods)
+	for (const bool _snapOnGround : { false, true })
+	{
+		FSplineMeshBenchmarkScenario _scenario = FSplineMeshBenchmarkScenario();
+		_scenario.name = FString::Printf(TEXT("%dcm_%s_%s_%s_%s"), FMath::RoundToInt(_length), *_compositionMethod, *_placementMethod, *_rotationMethod, _snapOnGround ? TEXT("Snap") : TEXT("NoSnap"));
+		_scenario.length = _length;
+
+		_scenario.properties.Add(TEXT("compositionMethod"), _compositionMethod);
+		_scenario.properties.Add(TEXT("meshComposition"), _meshComposition);
+		_scenario.properties.Add(TEXT("meshesComposition"), TEXT("(") + _meshesComposition + TEXT(")"));
+		_scenario.properties.Add(TEXT("startCapComposition"), _capComposition);
+		_scenario.properties.Add(TEXT("endCapComposition"), _capComposition);
+		_scenario.properties.Add(TEXT("placementMethod"), _placementMethod);
+		_scenario.properties.Add(TEXT("rotationMethod"), _rotationMethod);
+		_scenario.properties.Add(TEXT("meshRotation"), TEXT("(axisRotation=ROTATE_Z,angle=15.0)"));
+		_scenario.properties.Add(TEXT("meshesRotation"), TEXT("(") + _meshesRotation + TEXT(")"));
+		_scenario.properties.Add(TEXT("snapOnGround"), _snapOnGround ? TEXT("True") : TEXT("False"));
+		_scenario.properties.Add(TEXT("groundLayer"), TEXT("(ObjectTypeQuery1)"));
+		_scenario.properties.Add(TEXT("checkGroundMethod"), TEXT("SPACING"));
+		_scenario.properties.Add(TEXT("checkGroundSpacing"), TEXT("500.0"));
+		_scenario.properties.Add(TEXT("checkGroundDepth"), TEXT("1000.0"));
+		_scenarios.Add(_scenario);
+	}
+
+	return _scenarios;
+}
+
+void UDynamicSplineMeshBenchmarkCommandlet::SpawnHeightfield(UWorld* _world, const float _length) const
+{
+	using namespace DynamicSplineMeshBenchmark;
+
+	UStaticMesh* _mesh = LoadObject<UStaticMesh>(nullptr, MeshPath);
+	if (!_mesh) return;
+
+	// Spawn a tile every tile size along the splines, the top of the tile is the ground height
+	for (float _x = -TileSize; _x <= _length + TileSize; _x += TileSize)
+	{
+		const float _height = GetGroundHeight(_x);
+		AStaticMeshActor* _tile = _world->SpawnActor<AStaticMeshActor>(FVector(_x, 0.0f, _height - 50.0f), FRotator::ZeroRotator);
+		if (!_tile) continue;
+
+		_tile->SetMobility(EComponentMobility::Movable);
+		_tile->GetStaticMeshComponent()->SetStaticMesh(_mesh);
+		_tile->SetActorScale3D(FVector(TileSize / 100.0f, 40.0f, 1.0f));
+	}
+}
+
+FSplineMeshBenchmarkResult UDynamicSplineMeshBenchmarkCommandlet::RunScenario(UWorld* _world, const FSplineMeshBenchmarkScenario& _scenario, const int _iterations) const
+{
+	FSplineMeshBenchmarkResult _result = FSplineMeshBenchmarkResult();
+	_result.name = _scenario.name;
+	_result.length = _scenario.length;
+
+	ADynamicSplineMeshActor* _actor = _world->SpawnActor<ADynamicSplineMeshActor>(FVector(0.0f, 0.0f, 500.0f), FRotator::ZeroRotator);
+	if (!_actor) return _result;
+
+	// Apply the scenario
+	for (const TPair<FName, FString>& _property : _scenario.properties)
+	{
+		if (!DynamicSplineMeshBenchmark::SetActorProperty(_actor, _property.Key, _property.Value))
+		{
+			UE_LOG(LogDynamicSplineMeshEditor, Warning, TEXT("%s: can't set %s to %s"), *_scenario.name, *_property.Key.ToString(), *_property.Value);
+		}
+	}
+
+	// Keep the fastest iteration, each one starts from the same spline
+	double _bestTime = TNumericLimits<double>::Max();
+	for (int _iteration = 0; _iteration < _iterations; _iteration++)
+	{
+		SetSplinePoints(_actor, _scenario.length);
+		const int64 _usedMemory = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+
+		// Measure the layout itself, not a copy of the previous iteration from the shared cache
+		FSplineMeshLayoutCache::Get().Empty();
+
+		_actor->PrepareLayout();
+		_actor->ComputeLayout();
+		_actor->FinishLayout();
+
+		const FSplineMeshBuildStats& _stats = _actor->GetBuildStats();
+		if (_stats.GetTotalTime() >= _bestTime) continue;
+
+		_bestTime = _stats.GetTotalTime();
+		_result.stats = _stats;
+		_result.segments = _actor->GetSegmentCount();
+		_result.memoryDelta = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - _usedMemory;
+	}
+
+	_actor->Destroy();
+	return _result;
+}
+
+void UDynamicSplineMeshBenchmarkCommandlet::SetSplinePoints(ADynamicSplineMeshActor* _actor, const float _length) const
+{
+	using namespace DynamicSplineMeshBenchmark;
+
+	USplineComponent* _spline = _actor->FindComponentByClass<USplineComponent>();
+	if (!_spline) return;
+
+	// Wave along the length so that the spline is curved
+	TArray<FVector> _points = TArray<FVector>();
+	const int _pointCount = FMath::Max(2, FMath::CeilToInt(_length / PointSpacing) + 1);
+	for (int _pointIndex = 0; _pointIndex < _pointCount; _pointIndex++)
+	{
+		const float _x = _length * _pointIndex / (_pointCount - 1);
+		_points.Add(FVector(_x, FMath::Sin(_x * 0.0002f) * 300.0f, 0.0f));
+	}
+
+	_spline->SetSplinePoints(_points, ESplineCoordinateSpace::Local, true);
+}
+
+TSharedRef<FJsonObject> UDynamicSplineMeshBenchmarkCommandlet::ToJson(const TArray<FSplineMeshBenchmarkResult>& _results, const int _iterations) const
+{
+	TArray<TSharedPtr<FJsonValue>> _scenarios = TArray<TSharedPtr<FJsonValue>>();
+	for (const FSplineMeshBenchmarkResult& _result : _results)
+	{
+		const FSplineMeshBuildStats& _stats = _result.stats;
+
+		const TSharedRef<FJsonObject> _phases = MakeShared<FJsonObject>();
+		_phases->SetNumberField(TEXT("flushMs"), _stats.flushTime * 1000.0);
+		_phases->SetNumberField(TEXT("snapMs"), _stats.snapTime * 1000.0);
+		_phases->SetNumberField(TEXT("bridgeMs"), _stats.bridgeTime * 1000.0);
+		_phases->SetNumberField(TEXT("layoutMs"), _stats.layoutTime * 1000.0);
+		_phases->SetNumberField(TEXT("meshesMs"), _stats.meshesTime * 1000.0);
+		_phases->SetNumberField(TEXT("rotateMs"), _stats.rotateTime * 1000.0);
+		_phases->SetNumberField(TEXT("collisionMs"), _stats.collisionTime * 1000.0);
+		_phases->SetNumberField(TEXT("scatterMs"), _stats.scatterTime * 1000.0);
+
+		const TSharedRef<FJsonObject> _traces = MakeShared<FJsonObject>();
+		_traces->SetNumberField(TEXT("snap"), _stats.snapTraces);
+		_traces->SetNumberField(TEXT("bridge"), _stats.bridgeTraces);
+
+		const TSharedRef<FJsonObject> _scenario = MakeShared<FJsonObject>();
+		_scenario->SetStringField(TEXT("name"), _result.name);
+		_scenario->SetNumberField(TEXT("length"), _result.length);
+		_scenario->SetNumberField(TEXT("segments"), _result.segments);
+		_scenario->SetNumberField(TEXT("components"), _stats.componentsCreated);
+		_scenario->SetNumberField(TEXT("memoryDeltaBytes"), static_cast<double>(_result.memoryDelta));
+		_scenario->SetNumberField(TEXT("totalMs"), _stats.GetTotalTime() * 1000.0);
+		_scenario->SetObjectField(TEXT("phases"), _phases);
+		_scenario->SetObjectField(TEXT("traces"), _traces);
+		_scenarios.Add(MakeShared<FJsonValueObject>(_scenario));
+	}
+
+	const TSharedRef<FJsonObject> _root = MakeShared<FJsonObject>();
+	_root->SetNumberField(TEXT("iterations"), _iterations);
+	_root->SetArrayField(TEXT("scenarios"), _scenarios);
+	return _root;
+}
+
+void UDynamicSplineMeshBenchmarkCommandlet::RunSpatialIndexBenchmark(const int _segmentsCount, const FString& _outputFile) const
+{
+	// Lay the segments out as parallel splines of 100 segments
+	constexpr int _segmentsPerSpline = 100;
+	constexpr float _segmentLength = 500.0f;
+	constexpr float _splineSpacing = 1000.0f;
+	constexpr int _queriesCount = 10000;
+	const int _splinesCount = FMath::DivideAndRoundUp(_segmentsCount, _segmentsPerSpline);
+	const float _fieldLength = _segmentsPerSpline * _segmentLength;
+	const float _fieldWidth = _splinesCount * _splineSpacing;
+
+	TArray<TArray<FSplineMeshSpatialEntry>> _splines = TArray<TArray<FSplineMeshSpatialEntry>>();
+	_splines.SetNum(_splinesCount);
+	for (int _segmentIndex = 0; _segmentIndex < _segmentsCount; _segmentIndex++)
+	{
+		const int _splineIndex = _segmentIndex / _segmentsPerSpline;
+		const int _indexInSpline = _segmentIndex % _segmentsPerSpline;
+
+		FSplineMeshSpatialEntry _entry = FSplineMeshSpatialEntry();
+		_entry.segmentIndex = _indexInSpline;
+		_entry.start = FVector(_indexInSpline * _segmentLength, _splineIndex * _splineSpacing, DynamicSplineMeshBenchmark::GetGroundHeight(_indexInSpline * _segmentLength));
+		_entry.end = FVector((_indexInSpline + 1) * _segmentLength, _splineIndex * _splineSpacing, DynamicSplineMeshBenchmark::GetGroundHeight((_indexInSpline + 1) * _segmentLength));
+		_entry.bounds = FBox(_entry.start, _entry.end).ExpandBy(FVector(0.0f, 50.0f, 100.0f));
+		_entry.startDistance = _indexInSpline * _segmentLength;
+		_entry.endDistance = (_indexInSpline + 1) * _segmentLength;
+		_splines[_splineIndex].Add(_entry);
+	}
+
+	// Build the index one spline at a time, as the actors do
+	FSplineMeshSpatialIndex _index = FSplineMeshSpatialIndex();
+	double _startTime = FPlatformTime::Seconds();
+	for (int _splineIndex = 0; _splineIndex < _splinesCount; _splineIndex++)
+	{
+		_index.SetEntries(_splineIndex + 1, _splines[_splineIndex]);
+	}
+	const double _buildTime = FPlatformTime::Seconds() - _startTime;
+
+	// Update a tenth of the splines
+	_startTime = FPlatformTime::Seconds();
+	for (int _splineIndex = 0; _splineIndex < _splinesCount; _splineIndex += 10)
+	{
+		_index.SetEntries(_splineIndex + 1, _splines[_splineIndex]);
+	}
+	const double _updateTime = FPlatformTime::Seconds() - _startTime;
+
+	// Generate the queries over the field
+	FRandomStream _random = FRandomStream(42);
+	TArray<FVector> _locations = TArray<FVector>();
+	_locations.SetNum(_queriesCount);
+	for (FVector& _location : _locations)
+	{
+		_location = FVector(_random.FRandRange(0.0f, _fieldLength), _random.FRandRange(0.0f, _fieldWidth), _random.FRandRange(-500.0f, 500.0f));
+	}
+
+	int _nearestHits = 0;
+	_startTime = FPlatformTime::Seconds();
+	for (const FVector& _location : _locations)
+	{
+		FSplineMeshSpatialHit _hit = FSplineMeshSpatialHit();
+		if (_index.FindNearest(_location, 10000.0f, _hit)) _nearestHits++;
+	}
+	const double _nearestTime = FPlatformTime::Seconds() - _startTime;
+
+	int _overlapHits = 0;
+	TArray<FSplineMeshSpatialHit> _hits = TArray<FSplineMeshSpatialHit>();
+	_startTime = FPlatformTime::Seconds();
+	for (const FVector& _location : _locations)
+	{
+		_index.Overlap(_location, 1000.0f, _hits);
+		_overlapHits += _hits.Num();
+	}
+	const double _overlapTime = FPlatformTime::Seconds() - _startTime;
+
+	// Cast the rays down and across the splines
+	int _rayHits = 0;
+	_startTime = FPlatformTime::Seconds();
+	for (const FVector& _location : _locations)
+	{
+		FSplineMeshSpatialHit _hit = FSplineMeshSpatialHit();
+		if (_index.Raycast(_location + FVector(0.0f, -5000.0f, 1000.0f), _location + FVector(0.0f, 5000.0f, -1000.0f), _hit)) _rayHits++;
+	}
+	const double _rayTime = FPlatformTime::Seconds() - _startTime;
+
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("Spatial index: %d segments, %.1f KB, build %.3f ms, update of %d splines %.3f ms"),
+		_index.Num(), _index.GetAllocatedSize() / 1024.0, _buildTime * 1000.0, FMath::DivideAndRoundUp(_splinesCount, 10), _updateTime * 1000.0);
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("%d nearest queries: %.3f ms, %d hits"), _queriesCount, _nearestTime * 1000.0, _nearestHits);
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("%d overlap queries: %.3f ms, %d hits"), _queriesCount, _overlapTime * 1000.0, _overlapHits);
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("%d ray queries: %.3f ms, %d hits"), _queriesCount, _rayTime * 1000.0, _rayHits);
+
+	// Write the timings
+	const TSharedRef<FJsonObject> _root = MakeShared<FJsonObject>();
+	_root->SetNumberField(TEXT("segments"), _index.Num());
+	_root->SetNumberField(TEXT("queries"), _queriesCount);
+	_root->SetNumberField(TEXT("memoryBytes"), _index.GetAllocatedSize());
+	_root->SetNumberField(TEXT("buildMs"), _buildTime * 1000.0);
+	_root->SetNumberField(TEXT("updateMs"), _updateTime * 1000.0);
+	_root->SetNumberField(TEXT("nearestMs"), _nearestTime * 1000.0);
+	_root->SetNumberField(TEXT("overlapMs"), _overlapTime * 1000.0);
+	_root->SetNumberField(TEXT("rayMs"), _rayTime * 1000.0);
+
+	FString _json = FString();
+	const TSharedRef<TJsonWriter<>> _writer = TJsonWriterFactory<>::Create(&_json);
+	FJsonSerializer::Serialize(_root, _writer);
+	FFileHelper::SaveStringToFile(_json, *_outputFile);
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("Results written to %s"), *_outputFile);
+}
+
+void UDynamicSplineMeshBenchmarkCommandlet::RunEvaluateBenchmark(const int _queriesCount, const int _iterations, const FString& _outputFile) const
+{
+	// A curved spline of 10 km, as the long scenarios
+	constexpr float _length = 1000000.0f;
+	USplineComponent* _spline = NewObject<USplineComponent>(GetTransientPackage());
+	TArray<FVector> _points = TArray<FVector>();
+	const int _pointCount = FMath::CeilToInt(_length / DynamicSplineMeshBenchmark::PointSpacing) + 1;
+	for (int _pointIndex = 0; _pointIndex < _pointCount; _pointIndex++)
+	{
+		const float _x = _length * _pointIndex / (_pointCount - 1);
+		_points.Add(FVector(_x, FMath::Sin(_x * 0.0002f) * 300.0f, DynamicSplineMeshBenchmark::GetGroundHeight(_x)));
+	}
+	_spline->SetSplinePoints(_points, ESplineCoordinateSpace::Local, true);
+
+	// Sorted distances covering the spline, as the placement and the ground samples
+	TArray<double> _distances = TArray<double>();
+	_distances.SetNumUninitialized(_queriesCount);
+	for (int _index = 0; _index < _queriesCount; _index++)
+	{
+		_distances[_index] = static_cast<double>(_length) * _index / _queriesCount;
+	}
+
+	// Keep the fastest iteration of each method
+	TArray<FVector> _engineLocations = TArray<FVector>();
+	_engineLocations.SetNumUninitialized(_queriesCount);
+	FVector _checksum = FVector::ZeroVector;
+	SplineLayout::SplineSamples _samples = SplineLayout::SplineSamples();
+	double _engineTime = TNumericLimits<double>::Max();
+	double _scalarTime = TNumericLimits<double>::Max();
+	double _batchTime = TNumericLimits<double>::Max();
+	for (int _iteration = 0; _iteration < _iterations; _iteration++)
+	{
+		double _startTime = FPlatformTime::Seconds();
+		for (int _index = 0; _index < _queriesCount; _index++)
+		{
+			_engineLocations[_index] = _spline->GetLocationAtDistanceAlongSpline(_distances[_index], ESplineCoordinateSpace::Local);
+			_checksum += _spline->GetTangentAtDistanceAlongSpline(_distances[_index], ESplineCoordinateSpace::Local);
+		}
+		_engineTime = FMath::Min(_engineTime, FPlatformTime::Seconds() - _startTime);
+
+		const SplineLayout::HermiteSpline& _hermiteSpline = SplineLayoutAdapter::MakeHermiteSpline(_spline);
+		_startTime = FPlatformTime::Seconds();
+		for (int _index = 0; _index < _queriesCount; _index++)
+		{
+			const double _key = _hermiteSpline.GetKeyAtDistance(_distances[_index]);
+			_checksum += SplineLayoutAdapter::ToEngine(_hermiteSpline.GetLocation(_key) + _hermiteSpline.GetTangent(_key));
+		}
+		_scalarTime = FMath::Min(_scalarTime, FPlatformTime::Seconds() - _startTime);
+
+		// The construction of the evaluator is part of the measure
+		_startTime = FPlatformTime::Seconds();
+		SplineLayout::BatchEvaluator(_hermiteSpline).EvaluateDistances(_distances.GetData(), _queriesCount, _samples);
+		_batchTime = FMath::Min(_batchTime, FPlatformTime::Seconds() - _startTime);
+	}
+
+	// The largest gap between the engine and the batch locations
+	double _maxError = 0.0;
+	for (int _index = 0; _index < _queriesCount; _index++)
+	{
+		_maxError = FMath::Max(_maxError, FVector::Dist(_engineLocations[_index], SplineLayoutAdapter::ToEngine(_samples.GetLocation(_index))));
+	}
+
+	const double _engineRate = _queriesCount / FMath::Max(_engineTime, UE_DOUBLE_SMALL_NUMBER);
+	const double _scalarRate = _queriesCount / FMath::Max(_scalarTime, UE_DOUBLE_SMALL_NUMBER);
+	const double _batchRate = _queriesCount / FMath::Max(_batchTime, UE_DOUBLE_SMALL_NUMBER);
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("Evaluate: %d queries on %d points, checksum %s"), _queriesCount, _pointCount, *_checksum.ToCompactString());
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("USplineComponent per call: %.0f queries/s"), _engineRate);
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("HermiteSpline per call: %.0f queries/s"), _scalarRate);
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("BatchEvaluator: %.0f queries/s, %.1fx the engine, max error %.6f"), _batchRate, _batchRate / _engineRate, _maxError);
+
+	// Write the rates
+	const TSharedRef<FJsonObject> _root = MakeShared<FJsonObject>();
+	_root->SetNumberField(TEXT("queries"), _queriesCount);
+	_root->SetNumberField(TEXT("points"), _pointCount);
+	_root->SetNumberField(TEXT("engineQueriesPerSecond"), _engineRate);
+	_root->SetNumberField(TEXT("scalarQueriesPerSecond"), _scalarRate);
+	_root->SetNumberField(TEXT("batchQueriesPerSecond"), _batchRate);
+	_root->SetNumberField(TEXT("maxError"), _maxError);
+
+	FString _json = FString();
+	const TSharedRef<TJsonWriter<>> _writer = TJsonWriterFactory<>::Create(&_json);
+	FJsonSerializer::Serialize(_root, _writer);
+	FFileHelper::SaveStringToFile(_json, *_outputFile);
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("Results written to %s"), *_outputFile);
+}
+
+void UDynamicSplineMeshBenchmarkCommandlet::RunParallelLayoutBenchmark(const int _segmentsCount, const int _maxTasks, const int _iterations, const FString& _outputFile) const
+{
+	IConsoleVariable* _tasksVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("dsm.Layout.Tasks"));
+	if (!_tasksVariable) return;
+	const int _previousTasks = _tasksVariable->GetInt();
+
+	// Create the synthetic world
+	UWorld* _world = UWorld::CreateWorld(EWorldType::Game, false, TEXT("DynamicSplineMeshBenchmark"));
+	FWorldContext& _worldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	_worldContext.SetCurrentWorld(_world);
+
+	// A spline filled with a rotated cube of 1 m, a segment per meter
+	ADynamicSplineMeshActor* _actor = _world->SpawnActor<ADynamicSplineMeshActor>(FVector(0.0f, 0.0f, 500.0f), FRotator::ZeroRotator);
+	if (!_actor)
+	{
+		GEngine->DestroyWorldContext(_world);
+		_world->DestroyWorld(false);
+		return;
+	}
+
+	const float _length = _segmentsCount * 100.0f;
+	const TMap<FName, FString> _properties = {
+		{ TEXT("compositionMethod"), TEXT("FILL") },
+		{ TEXT("meshComposition"), FString::Printf(TEXT("(mesh=\"%s\",scaleFactor=1.0)"), DynamicSplineMeshBenchmark::MeshPath) },
+		{ TEXT("placementMethod"), TEXT("DUPLICATE") },
+		{ TEXT("rotationMethod"), TEXT("REGULAR") },
+		{ TEXT("meshRotation"), TEXT("(axisRotation=ROTATE_Z,angle=15.0)") }
+	};
+	for (const TPair<FName, FString>& _property : _properties)
+	{
+		DynamicSplineMeshBenchmark::SetActorProperty(_actor, _property.Key, _property.Value);
+	}
+
+	// Double the tasks up to the maximum, keeping the fastest iteration of each count
+	TArray<TSharedPtr<FJsonValue>> _runs = TArray<TSharedPtr<FJsonValue>>();
+	double _singleTaskTime = 0.0;
+	for (int _tasks = 1; _tasks <= _maxTasks; _tasks *= 2)
+	{
+		_tasksVariable->Set(_tasks, ECVF_SetByCode);
+
+		FSplineMeshBuildStats _bestStats = FSplineMeshBuildStats();
+		double _bestTime = TNumericLimits<double>::Max();
+		for (int _iteration = 0; _iteration < _iterations; _iteration++)
+		{
+			SetSplinePoints(_actor, _length);
+			FSplineMeshLayoutCache::Get().Empty();
+			_actor->PrepareLayout();
+			_actor->ComputeLayout();
+			_actor->FinishLayout();
+
+			// The component creation stays on the game thread, only the parallel parts are compared
+			const FSplineMeshBuildStats& _stats = _actor->GetBuildStats();
+			const double _time = _stats.layoutTime + _stats.rotateTime;
+			if (_time >= _bestTime) continue;
+
+			_bestTime = _time;
+			_bestStats = _stats;
+		}
+
+		if (_tasks == 1) _singleTaskTime = _bestTime;
+		const double _speedup = _singleTaskTime / FMath::Max(_bestTime, UE_DOUBLE_SMALL_NUMBER);
+		UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("%d tasks: layout %.3f ms, rotate %.3f ms, meshes %.3f ms, %.2fx"),
+			_tasks, _bestStats.layoutTime * 1000.0, _bestStats.rotateTime * 1000.0, _bestStats.meshesTime * 1000.0, _speedup);
+
+		const TSharedRef<FJsonObject> _run = MakeShared<FJsonObject>();
+		_run->SetNumberField(TEXT("tasks"), _tasks);
+		_run->SetNumberField(TEXT("layoutMs"), _bestStats.layoutTime * 1000.0);
+		_run->SetNumberField(TEXT("rotateMs"), _bestStats.rotateTime * 1000.0);
+		_run->SetNumberField(TEXT("meshesMs"), _bestStats.meshesTime * 1000.0);
+		_run->SetNumberField(TEXT("speedup"), _speedup);
+		_runs.Add(MakeShared<FJsonValueObject>(_run));
+	}
+
+	// Write the speedups
+	const TSharedRef<FJsonObject> _root = MakeShared<FJsonObject>();
+	_root->SetNumberField(TEXT("segments"), _actor->GetSegmentCount());
+	_root->SetNumberField(TEXT("workerThreads"), FTaskGraphInterface::Get().GetNumWorkerThreads());
+	_root->SetNumberField(TEXT("iterations"), _iterations);
+	_root->SetArrayField(TEXT("runs"), _runs);
+
+	FString _json = FString();
+	const TSharedRef<TJsonWriter<>> _writer = TJsonWriterFactory<>::Create(&_json);
+	FJsonSerializer::Serialize(_root, _writer);
+	FFileHelper::SaveStringToFile(_json, *_outputFile);
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("Results written to %s"), *_outputFile);
+
+	// Release the world
+	_tasksVariable->Set(_previousTasks, ECVF_SetByCode);
+	_actor->Destroy();
+	GEngine->DestroyWorldContext(_world);
+	_world->DestroyWorld(false);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+int UDynamicSplineMeshBenchmarkCommandlet::RunScatterBenchmark(const int _propsCount, const int _iterations, const FString& _outputFile) const
+{
+	using namespace DynamicSplineMeshBenchmark;
+
+	// Create the synthetic world, a prop every meter over the heightfield
+	const float _length = _propsCount * 100.0f;
+	UWorld* _world = UWorld::CreateWorld(EWorldType::Game, false, TEXT("DynamicSplineMeshBenchmark"));
+	FWorldContext& _worldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	_worldContext.SetCurrentWorld(_world);
+	SpawnHeightfield(_world, _length);
+
+	ADynamicSplineMeshActor* _actor = _world->SpawnActor<ADynamicSplineMeshActor>(FVector(0.0f, 0.0f, 500.0f), FRotator::ZeroRotator);
+	if (!_actor)
+	{
+		GEngine->DestroyWorldContext(_world);
+		_world->DestroyWorld(false);
+		return 0;
+	}
+
+	SetActorProperty(_actor, TEXT("meshComposition"), FString::Printf(TEXT("(mesh=\"%s\",scaleFactor=1.0)"), MeshPath));
+	SetActorProperty(_actor, TEXT("groundLayer"), TEXT("(ObjectTypeQuery1)"));
+	SetActorProperty(_actor, TEXT("checkGroundDepth"), TEXT("1000.0"));
+
+	// Keep the fastest iteration of the layer, upright then aligned on the ground
+	TArray<TSharedPtr<FJsonValue>> _runs = TArray<TSharedPtr<FJsonValue>>();
+	int _overBudgetCount = 0;
+	for (const bool _alignToGround : { false, true })
+	{
+		const FString& _layer = FString::Printf(TEXT("((mesh=\"%s\",spacing=100.0,jitter=30.0,lateralOffset=300.0,lateralJitter=50.0,yawJitter=45.0,scaleRange=(X=0.8,Y=1.2),alignToGround=%s))"),
+			MeshPath, _alignToGround ? TEXT("True") : TEXT("False"));
+		SetActorProperty(_actor, TEXT("scatterLayers"), _layer);
+
+		FSplineMeshBuildStats _bestStats = FSplineMeshBuildStats();
+		double _bestTime = TNumericLimits<double>::Max();
+		for (int _iteration = 0; _iteration < _iterations; _iteration++)
+		{
+			SetSplinePoints(_actor, _length);
+			FSplineMeshLayoutCache::Get().Empty();
+			_actor->PrepareLayout();
+			_actor->ComputeLayout();
+			_actor->FinishLayout();
+
+			const FSplineMeshBuildStats& _stats = _actor->GetBuildStats();
+			if (_stats.scatterTime >= _bestTime) continue;
+
+			_bestTime = _stats.scatterTime;
+			_bestStats = _stats;
+		}
+
+		const double _timePer1000Props = _bestStats.scatterTime * 1000.0 * 1000.0 / FMath::Max(_bestStats.scatteredProps, 1);
+		const bool _isOverBudget = _timePer1000Props > ScatterBudget;
+		if (_isOverBudget) _overBudgetCount++;
+
+		const TCHAR* _runName = _alignToGround ? TEXT("Aligned") : TEXT("Upright");
+		UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("%s: %d props, %.3f ms, %.3f ms per 1000 props"), _runName, _bestStats.scatteredProps, _bestStats.scatterTime * 1000.0, _timePer1000Props);
+		if (_isOverBudget) UE_LOG(LogDynamicSplineMeshEditor, Warning, TEXT("%s: over the budget of %.1f ms per 1000 props"), _runName, ScatterBudget);
+
+		const TSharedRef<FJsonObject> _run = MakeShared<FJsonObject>();
+		_run->SetBoolField(TEXT("alignToGround"), _alignToGround);
+		_run->SetNumberField(TEXT("props"), _bestStats.scatteredProps);
+		_run->SetNumberField(TEXT("scatterMs"), _bestStats.scatterTime * 1000.0);
+		_run->SetNumberField(TEXT("msPer1000Props"), _timePer1000Props);
+		_run->SetBoolField(TEXT("overBudget"), _isOverBudget);
+		_runs.Add(MakeShared<FJsonValueObject>(_run));
+	}
+
+	// Write the timings
+	const TSharedRef<FJsonObject> _root = MakeShared<FJsonObject>();
+	_root->SetNumberField(TEXT("budgetMsPer1000Props"), ScatterBudget);
+	_root->SetNumberField(TEXT("iterations"), _iterations);
+	_root->SetArrayField(TEXT("runs"), _runs);
+
+	FString _json = FString();
+	const TSharedRef<TJsonWriter<>> _writer = TJsonWriterFactory<>::Create(&_json);
+	FJsonSerializer::Serialize(_root, _writer);
+	FFileHelper::SaveStringToFile(_json, *_outputFile);
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("Results written to %s"), *_outputFile);
+
+	// Release the world
+	_actor->Destroy();
+	GEngine->DestroyWorldContext(_world);
+	_world->DestroyWorld(false);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return _overBudgetCount;
+}
+
+int UDynamicSplineMeshBenchmarkCommandlet::CompareWithBaseline(const TArray<FSplineMeshBenchmarkResult>& _results, const FString& _baselineFile, const double _threshold) const
+{
+	// Read the baseline
+	FString _json = FString();
+	TSharedPtr<FJsonObject> _baseline = nullptr;
+	if (!FFileHelper::LoadFileToString(_json, *_baselineFile) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(_json), _baseline) || !_baseline)
+	{
+		UE_LOG(LogDynamicSplineMeshEditor, Error, TEXT("Can't read the baseline %s"), *_baselineFile);
+		return 1;
+	}
+
+	// Get the total time of each baseline scenario
+	TMap<FString, double> _baselineTimes = TMap<FString, double>();
+	for (const TSharedPtr<FJsonValue>& _value : _baseline->GetArrayField(TEXT("scenarios")))
+	{
+		const TSharedPtr<FJsonObject>& _scenario = _value->AsObject();
+		_baselineTimes.Add(_scenario->GetStringField(TEXT("name")), _scenario->GetNumberField(TEXT("totalMs")));
+	}
+
+	// Ignore the differences too small to be measured
+	static constexpr double MinDeltaMs = 0.1;
+
+	int _regressionCount = 0;
+	for (const FSplineMeshBenchmarkResult& _result : _results)
+	{
+		const double* _baselineTime = _baselineTimes.Find(_result.name);
+		if (!_baselineTime) continue;
+
+		const double _time = _result.stats.GetTotalTime() * 1000.0;
+		if (_time <= *_baselineTime * (1.0 + _threshold) || _time - *_baselineTime < MinDeltaMs) continue;
+
+		UE_LOG(LogDynamicSplineMeshEditor, Error, TEXT("Regression %s: %.3f ms, baseline %.3f ms (+%.1f%%)"), *_result.name, _time, *_baselineTime, (_time / *_baselineTime - 1.0) * 100.0);
+		_regressionCount++;
+	}
+
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("%d regression(s) against %s"), _regressionCount, *_baselineFile);
+	return _regressionCount;
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DynamicSplineMeshStats.h"
+#include "DynamicSplineMeshBenchmarkCommandlet.generated.h"
+
+class ADynamicSplineMeshActor;
+class FJsonObject;
+
+/* A configuration of the benchmark matrix */
+struct FSplineMeshBenchmarkScenario
+{
+	/* Unique name used to compare the scenario with the baseline */
+	FString name = FString();
+
+	/* Length of the spline */
+	float length = 0.0f;
+
+	/* Values of the actor properties, in the text format of the property */
+	TMap<FName, FString> properties = TMap<FName, FString>();
+};
+
+/* The measures of a scenario, the fastest iteration is kept */
+struct FSplineMeshBenchmarkResult
+{
+	FString name = FString();
+	float length = 0.0f;
+	int segments = 0;
+	int64 memoryDelta = 0;
+	FSplineMeshBuildStats stats = FSplineMeshBuildStats();
+};
+
+/*
+ * Benchmark the spline generation over a matrix of scenarios in a synthetic world
+ * Covers the spline lengths, the composition, placement and rotation methods, with and without ground snapping over a generated heightfield
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=DynamicSplineMeshBenchmark [-Output=File.json] [-Baseline=File.json] [-Threshold=0.1] [-Iterations=3] [-Quick] -nullrhi -unattended
+ * Returns 1 when a scenario is slower than the baseline by more than the threshold
+ *
+ * With -SpatialIndex[=Segments], benchmarks the build and the queries of the segments spatial index instead, 100000 segments by default
+ * With -Evaluate[=Queries], compares the per call spline evaluation with the batch evaluator instead, 1000000 queries by default
+ * With -ParallelLayout[=Segments], measures the scaling of the segments layout from 1 to -MaxTasks=32 tasks instead, 10000 segments by default
+ * With -Scatter[=Props], measures a scatter layer with and without the ground alignment instead, 10000 props by default, and returns 1 above 1 ms per 1000 props
+ */
+UCLASS()
+class UDynamicSplineMeshBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDynamicSplineMeshBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/* Build the scenarios of the matrix */
+	TArray<FSplineMeshBenchmarkScenario> BuildScenarios(const bool _quick) const;
+
+	/* Spawn a stepped heightfield under the splines */
+	void SpawnHeightfield(UWorld* _world, const float _length) const;
+
+	/* Run a scenario and return its fastest iteration */
+	FSplineMeshBenchmarkResult RunScenario(UWorld* _world, const FSplineMeshBenchmarkScenario& _scenario, const int _iterations) const;
+
+	/* Set the spline points of an actor for a length */
+	void SetSplinePoints(ADynamicSplineMeshActor* _actor, const float _length) const;
+
+	/* Convert the results to json */
+	TSharedRef<FJsonObject> ToJson(const TArray<FSplineMeshBenchmarkResult>& _results, const int _iterations) const;
+
+	/* Benchmark the spatial index over synthetic segments and write the timings */
+	void RunSpatialIndexBenchmark(const int _segmentsCount, const FString& _outputFile) const;
+
+	/* Benchmark the spline location and tangent queries, per call against the batch evaluator, and write the queries per second */
+	void RunEvaluateBenchmark(const int _queriesCount, const int _iterations, const FString& _outputFile) const;
+
+	/* Benchmark the layout and the rotation of the segments of a spline for each number of tasks, and write the speedups */
+	void RunParallelLayoutBenchmark(const int _segmentsCount, const int _maxTasks, const int _iterations, const FString& _outputFile) const;
+
+	/* Benchmark a scatter layer laid over the heightfield, write the time per 1000 props and return the number of runs above the budget */
+	int RunScatterBenchmark(const int _propsCount, const int _iterations, const FString& _outputFile) const;
+
+	/* Compare the results with a baseline file and return the number of regressions */
+	int CompareWithBaseline(const TArray<FSplineMeshBenchmarkResult>& _results, const FString& _baselineFile, const double _threshold) const;
+};
\ No newline at end of file
@@ -0,0 +1,6 @@
+#include "DynamicSplineMeshEditor.h"
+#include "Modules/ModuleManager.h"
+
+DEFINE_LOG_CATEGORY(LogDynamicSplineMeshEditor);
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, DynamicSplineMeshEditor);
\ No newline at end of file
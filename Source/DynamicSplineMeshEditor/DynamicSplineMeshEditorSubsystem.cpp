@@ -0,0 +1,238 @@
+#include "DynamicSplineMeshEditorSubsystem.h"
+
+#include "DynamicSplineMeshActor.h"
+#include "DynamicSplineMeshEditor.h"
+#include "Editor.h"
+#include "Engine/StaticMesh.h"
+#include "HAL/IConsoleManager.h"
+#include "Subsystems/ImportSubsystem.h"
+
+static TAutoConsoleVariable<int32> CVarEditorMaxRebuilds(
+	TEXT("dsm.Editor.MaxRebuilds"),
+	4,
+	TEXT("Maximum number of spline actors rebuilt at the same time after a change of their meshes"));
+
+static TAutoConsoleVariable<int32> CVarEditorMeshesPerFrame(
+	TEXT("dsm.Editor.MeshesPerFrame"),
+	64,
+	TEXT("Number of spline meshes created per frame by each rebuild started after a change of the meshes"));
+
+void UDynamicSplineMeshEditorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	layoutAppliedHandle = ADynamicSplineMeshActor::onLayoutApplied.AddUObject(this, &UDynamicSplineMeshEditorSubsystem::OnLayoutApplied);
+	propertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &UDynamicSplineMeshEditorSubsystem::OnObjectPropertyChanged);
+
+	if (UImportSubsystem* _importSubsystem = Collection.InitializeDependency<UImportSubsystem>())
+	{
+		reimportHandle = _importSubsystem->OnAssetReimport.AddUObject(this, &UDynamicSplineMeshEditorSubsystem::OnAssetReimport);
+	}
+
+	if (GEngine)
+	{
+		actorDeletedHandle = GEngine->OnLevelActorDeleted().AddUObject(this, &UDynamicSplineMeshEditorSubsystem::OnActorDeleted);
+	}
+
+	tickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UDynamicSplineMeshEditorSubsystem::Tick));
+}
+
+void UDynamicSplineMeshEditorSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(tickerHandle);
+	ADynamicSplineMeshActor::onLayoutApplied.Remove(layoutAppliedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(propertyChangedHandle);
+
+	if (GEditor)
+	{
+		if (UImportSubsystem* _importSubsystem = GEditor->GetEditorSubsystem<UImportSubsystem>())
+		{
+			_importSubsystem->OnAssetReimport.Remove(reimportHandle);
+		}
+	}
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorDeleted().Remove(actorDeletedHandle);
+	}
+
+	meshActors.Empty();
+	actorMeshes.Empty();
+	pendingActors.Empty();
+	rebuildingActors.Empty();
+	Super::Deinitialize();
+}
+
+void UDynamicSplineMeshEditorSubsystem::GetActorsUsingMesh(const UStaticMesh* _mesh, TArray<ADynamicSplineMeshActor*>& _actors) const
+{
+	_actors.Reset();
+	const TSet<TWeakObjectPtr<ADynamicSplineMeshActor>>* _meshActors = meshActors.Find(_mesh);
+	if (!_meshActors) return;
+
+	for (const TWeakObjectPtr<ADynamicSplineMeshActor>& _actor : *_meshActors)
+	{
+		if (_actor.IsValid()) _actors.Add(_actor.Get());
+	}
+}
+
+void UDynamicSplineMeshEditorSubsystem::QueueRebuildForMesh(const UStaticMesh* _mesh)
+{
+	TSet<TWeakObjectPtr<ADynamicSplineMeshActor>>* _meshActors = meshActors.Find(_mesh);
+	if (!_meshActors) return;
+
+	// The layout is only compared when the rebuild is due, the mesh may still be building
+	for (auto _iterator = _meshActors->CreateIterator(); _iterator; ++_iterator)
+	{
+		// Forget the actors of the unloaded levels
+		if (!_iterator->IsValid())
+		{
+			actorMeshes.Remove(*_iterator);
+			_iterator.RemoveCurrent();
+			continue;
+		}
+
+		pendingActors.AddUnique(*_iterator);
+	}
+
+	UE_LOG(LogDynamicSplineMeshEditor, Verbose, TEXT("%s changed: %d spline actors to check, %d waiting"), *_mesh->GetName(), _meshActors->Num(), pendingActors.Num());
+}
+
+void UDynamicSplineMeshEditorSubsystem::GetCounts(int& _meshes, int& _actors, int& _pending) const
+{
+	_meshes = meshActors.Num();
+	_actors = actorMeshes.Num();
+	_pending = pendingActors.Num() + rebuildingActors.Num();
+}
+
+void UDynamicSplineMeshEditorSubsystem::OnLayoutApplied(ADynamicSplineMeshActor* _actor)
+{
+	// The actors of the game worlds are copies of the editor ones
+	const UWorld* _world = _actor ? _actor->GetWorld() : nullptr;
+	if (!_world || _world->WorldType != EWorldType::Editor) return;
+
+	TSet<UStaticMesh*> _meshes = TSet<UStaticMesh*>();
+	_actor->GetUsedMeshes(_meshes);
+
+	// Keep the index when the meshes didn't change, the usual case of a rebuild
+	const TWeakObjectPtr<ADynamicSplineMeshActor> _weakActor = _actor;
+	TArray<TObjectKey<UStaticMesh>>* _previousMeshes = actorMeshes.Find(_weakActor);
+	if (_previousMeshes && _previousMeshes->Num() == _meshes.Num())
+	{
+		bool _isSame = true;
+		for (const TObjectKey<UStaticMesh>& _mesh : *_previousMeshes)
+		{
+			_isSame &= _meshes.Contains(_mesh.ResolveObjectPtr());
+		}
+		if (_isSame) return;
+	}
+
+	RemoveActor(_actor);
+
+	// Add the actor to the actors of each of its meshes
+	TArray<TObjectKey<UStaticMesh>>& _actorMeshes = actorMeshes.Add(_weakActor);
+	_actorMeshes.Reserve(_meshes.Num());
+	for (UStaticMesh* _mesh : _meshes)
+	{
+		_actorMeshes.Add(_mesh);
+		meshActors.FindOrAdd(_mesh).Add(_weakActor);
+	}
+}
+
+void UDynamicSplineMeshEditorSubsystem::RemoveActor(const ADynamicSplineMeshActor* _actor)
+{
+	const TWeakObjectPtr<ADynamicSplineMeshActor> _weakActor = const_cast<ADynamicSplineMeshActor*>(_actor);
+	pendingActors.Remove(_weakActor);
+
+	TArray<TObjectKey<UStaticMesh>> _meshes = TArray<TObjectKey<UStaticMesh>>();
+	if (!actorMeshes.RemoveAndCopyValue(_weakActor, _meshes)) return;
+
+	// Remove the actor from its meshes, and the meshes no longer used
+	for (const TObjectKey<UStaticMesh>& _mesh : _meshes)
+	{
+		TSet<TWeakObjectPtr<ADynamicSplineMeshActor>>* _meshActors = meshActors.Find(_mesh);
+		if (!_meshActors) continue;
+
+		_meshActors->Remove(_weakActor);
+		if (_meshActors->IsEmpty()) meshActors.Remove(_mesh);
+	}
+}
+
+void UDynamicSplineMeshEditorSubsystem::OnAssetReimport(UObject* _asset)
+{
+	if (const UStaticMesh* _mesh = Cast<UStaticMesh>(_asset)) QueueRebuildForMesh(_mesh);
+}
+
+void UDynamicSplineMeshEditorSubsystem::OnObjectPropertyChanged(UObject* _object, FPropertyChangedEvent& _event)
+{
+	// The bounds extensions and the build settings of a mesh change its bounds
+	if (const UStaticMesh* _mesh = Cast<UStaticMesh>(_object)) QueueRebuildForMesh(_mesh);
+}
+
+void UDynamicSplineMeshEditorSubsystem::OnActorDeleted(AActor* _actor)
+{
+	if (const ADynamicSplineMeshActor* _splineActor = Cast<ADynamicSplineMeshActor>(_actor)) RemoveActor(_splineActor);
+}
+
+bool UDynamicSplineMeshEditorSubsystem::Tick(float _deltaTime)
+{
+	// Release the finished rebuilds
+	rebuildingActors.RemoveAll([](const TWeakObjectPtr<ADynamicSplineMeshActor>& _actor) { return !_actor.IsValid() || !_actor->IsGenerating(); });
+
+	FSplineMeshGenerateSettings _settings = FSplineMeshGenerateSettings();
+	_settings.meshesPerFrame = FMath::Max(1, CVarEditorMeshesPerFrame.GetValueOnGameThread());
+	const int _maxRebuilds = FMath::Max(1, CVarEditorMaxRebuilds.GetValueOnGameThread());
+
+	// Start the queued rebuilds, the spline meshes of each one are spread over several frames
+	int _skippedCount = 0;
+	while (!pendingActors.IsEmpty() && rebuildingActors.Num() < _maxRebuilds)
+	{
+		const TWeakObjectPtr<ADynamicSplineMeshActor> _actor = pendingActors[0];
+		pendingActors.RemoveAt(0, 1, false);
+		if (!_actor.IsValid()) continue;
+
+		// A mesh change that doesn't touch the layout, like a material, keeps the spline meshes
+		if (!_actor->IsLayoutOutdated())
+		{
+			_skippedCount++;
+			continue;
+		}
+
+		_actor->GenerateAsync(_settings);
+		rebuildingActors.Add(_actor);
+		UE_LOG(LogDynamicSplineMeshEditor, Log, TEXT("Rebuilding %s after a change of its meshes, %d waiting"), *_actor->GetActorNameOrLabel(), pendingActors.Num());
+	}
+
+	if (_skippedCount > 0) UE_LOG(LogDynamicSplineMeshEditor, Verbose, TEXT("%d spline actors were already up to date"), _skippedCount);
+	return true;
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CmdEditorDependencies(
+	TEXT("dsm.Editor.Dependencies"),
+	TEXT("Print the number of meshes and spline actors of the reverse index, and the actors of a mesh. Args: [Mesh=Path]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& _args, UWorld*, FOutputDevice& _output)
+	{
+		const UDynamicSplineMeshEditorSubsystem* _subsystem = GEditor ? GEditor->GetEditorSubsystem<UDynamicSplineMeshEditorSubsystem>() : nullptr;
+		if (!_subsystem) return;
+
+		int _meshes = 0, _actors = 0, _pending = 0;
+		_subsystem->GetCounts(_meshes, _actors, _pending);
+		_output.Logf(TEXT("Spline mesh dependencies: %d meshes, %d actors, %d rebuilds waiting"), _meshes, _actors, _pending);
+
+		// List the actors of a mesh
+		FString _meshPath = FString();
+		if (!FParse::Value(*FString::Join(_args, TEXT(" ")), TEXT("Mesh="), _meshPath)) return;
+		const UStaticMesh* _mesh = LoadObject<UStaticMesh>(nullptr, *_meshPath);
+		if (!_mesh)
+		{
+			_output.Logf(TEXT("No static mesh at %s"), *_meshPath);
+			return;
+		}
+
+		TArray<ADynamicSplineMeshActor*> _meshActors = TArray<ADynamicSplineMeshActor*>();
+		_subsystem->GetActorsUsingMesh(_mesh, _meshActors);
+		_output.Logf(TEXT("%s is used by %d spline actors"), *_mesh->GetName(), _meshActors.Num());
+		for (const ADynamicSplineMeshActor* _actor : _meshActors)
+		{
+			_output.Logf(TEXT("  %s%s"), *_actor->GetActorNameOrLabel(), _actor->IsLayoutOutdated() ? TEXT(" (outdated)") : TEXT(""));
+		}
+	}));
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
+#include "DynamicSplineMeshEditorSubsystem.generated.h"
+
+class ADynamicSplineMeshActor;
+class UStaticMesh;
+
+/*
+ * Reverse index from the static meshes to the spline actors of the editor worlds using them
+ * When a mesh is reimported or edited, only the actors using it are rebuilt, a few per frame
+ */
+UCLASS()
+class UDynamicSplineMeshEditorSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+	/* The actors using each mesh */
+	TMap<TObjectKey<UStaticMesh>, TSet<TWeakObjectPtr<ADynamicSplineMeshActor>>> meshActors = TMap<TObjectKey<UStaticMesh>, TSet<TWeakObjectPtr<ADynamicSplineMeshActor>>>();
+
+	/* The meshes used by each actor at its last layout, to remove it from the index */
+	TMap<TWeakObjectPtr<ADynamicSplineMeshActor>, TArray<TObjectKey<UStaticMesh>>> actorMeshes = TMap<TWeakObjectPtr<ADynamicSplineMeshActor>, TArray<TObjectKey<UStaticMesh>>>();
+
+	/* The actors waiting for their rebuild, in the order of the changes */
+	TArray<TWeakObjectPtr<ADynamicSplineMeshActor>> pendingActors = TArray<TWeakObjectPtr<ADynamicSplineMeshActor>>();
+
+	/* The actors being rebuilt over several frames */
+	TArray<TWeakObjectPtr<ADynamicSplineMeshActor>> rebuildingActors = TArray<TWeakObjectPtr<ADynamicSplineMeshActor>>();
+
+	FDelegateHandle layoutAppliedHandle = FDelegateHandle();
+	FDelegateHandle reimportHandle = FDelegateHandle();
+	FDelegateHandle propertyChangedHandle = FDelegateHandle();
+	FDelegateHandle actorDeletedHandle = FDelegateHandle();
+	FTSTicker::FDelegateHandle tickerHandle = FTSTicker::FDelegateHandle();
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/* Get the actors of the editor worlds using a mesh, in a composition of the spline or of a lane */
+	void GetActorsUsingMesh(const UStaticMesh* _mesh, TArray<ADynamicSplineMeshActor*>& _actors) const;
+
+	/* Queue the rebuild of the actors using a mesh, the actors whose layout is still up to date are skipped */
+	void QueueRebuildForMesh(const UStaticMesh* _mesh);
+
+	/* Get the number of indexed meshes and actors, and of the actors waiting for their rebuild */
+	void GetCounts(int& _meshes, int& _actors, int& _pending) const;
+
+private:
+	/* Replace the meshes of an actor in the index with the ones of its new layout */
+	void OnLayoutApplied(ADynamicSplineMeshActor* _actor);
+
+	/* Remove an actor from the index and from the queue */
+	void RemoveActor(const ADynamicSplineMeshActor* _actor);
+
+	void OnAssetReimport(UObject* _asset);
+	void OnObjectPropertyChanged(UObject* _object, FPropertyChangedEvent& _event);
+	void OnActorDeleted(AActor* _actor);
+
+	/* Start the queued rebuilds within the budget of the frame */
+	bool Tick(float _deltaTime);
+};
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "DynamicSplineMeshHLODBuilder.h"
+
+#include "DynamicSplineMeshActor.h"
+#include "DynamicSplineMeshEditor.h"
+#include "Engine/MeshMerging.h"
+#include "IMeshMergeUtilities.h"
+#include "MeshMergeModule.h"
+#include "StaticMeshCompiler.h"
+
+uint32 UDynamicSplineMeshHLODBuilderSettings::GetCRC() const
+{
+	uint32 _crc = Super::GetCRC();
+	_crc = HashCombine(_crc, GetTypeHash(chunkSize));
+	_crc = HashCombine(_crc, GetTypeHash(useLODMeshes));
+	_crc = HashCombine(_crc, GetTypeHash(useLowestSourceLOD));
+	_crc = HashCombine(_crc, GetTypeHash(percentTriangles));
+	return _crc;
+}
+
+TSubclassOf<UHLODBuilderSettings> UDynamicSplineMeshHLODBuilder::GetSettingsClass() const
+{
+	return UDynamicSplineMeshHLODBuilderSettings::StaticClass();
+}
+
+uint32 UDynamicSplineMeshHLODBuilder::ComputeHLODHash(const UActorComponent* InSourceComponent) const
+{
+	const USplineMeshComponent* _splineMesh = Cast<USplineMeshComponent>(InSourceComponent);
+	const ADynamicSplineMeshActor* _actor = _splineMesh ? Cast<ADynamicSplineMeshActor>(_splineMesh->GetOwner()) : nullptr;
+	if (!_actor) return Super::ComputeHLODHash(InSourceComponent);
+
+	// The merged levels of detail are left out of the proxies
+	const FSplineMeshSegment* _segment = _actor->FindSegment(_splineMesh);
+	if (!_segment) return 0;
+
+	// The components are regenerated with the actor, only its layout and its placement change the proxy
+	const FTransform& _transform = _actor->GetActorTransform();
+	const FVector _placement[3] = { _transform.GetLocation(), _transform.GetRotation().Euler(), _transform.GetScale3D() };
+	uint32 _hash = GetTypeHash(_actor->GetLayoutHash());
+	_hash = FCrc::MemCrc32(_placement, sizeof(_placement), _hash);
+	_hash = HashCombine(_hash, GetTypeHash(_segment->index));
+	_hash = HashCombine(_hash, GetTypeHash(_segment->lane));
+	return _hash;
+}
+
+TArray<UActorComponent*> UDynamicSplineMeshHLODBuilder::Build(const FHLODBuildContext& InHLODBuildContext, const TArray<UActorComponent*>& InSourceComponents) const
+{
+	const UDynamicSplineMeshHLODBuilderSettings* _settings = CastChecked<UDynamicSplineMeshHLODBuilderSettings>(HLODBuilderSettings);
+
+	// Group the spline meshes by actor and spatial chunk, the merged levels of detail are left out
+	TMap<TPair<const AActor*, FIntVector>, TArray<UPrimitiveComponent*>> _chunks = TMap<TPair<const AActor*, FIntVector>, TArray<UPrimitiveComponent*>>();
+	int _sourceTriangles = 0;
+	int _sourceDrawCalls = 0;
+	for (UActorComponent* _component : InSourceComponents)
+	{
+		USplineMeshComponent* _splineMesh = Cast<USplineMeshComponent>(_component);
+		const ADynamicSplineMeshActor* _actor = _splineMesh ? Cast<ADynamicSplineMeshActor>(_splineMesh->GetOwner()) : nullptr;
+		if (!_actor || !_actor->FindSegment(_splineMesh) || !_splineMesh->GetStaticMesh()) continue;
+
+		const FVector& _center = _splineMesh->Bounds.Origin;
+		const FIntVector& _cell = _settings->chunkSize > 0.0f ? FIntVector(FMath::FloorToInt(_center.X / _settings->chunkSize), FMath::FloorToInt(_center.Y / _settings->chunkSize), FMath::FloorToInt(_center.Z / _settings->chunkSize)) : FIntVector::ZeroValue;
+		_chunks.FindOrAdd(TPair<const AActor*, FIntVector>(_actor, _cell)).Add(_splineMesh);
+
+		// The far view without proxy draws the first level of detail of each spline mesh
+		int _triangles = 0;
+		int _sections = 0;
+		GetMeshCounts(_splineMesh->GetStaticMesh(), 0, _triangles, _sections);
+		_sourceTriangles += _triangles;
+		_sourceDrawCalls += _sections;
+	}
+
+	FMeshMergingSettings _mergeSettings = FMeshMergingSettings();
+	_mergeSettings.LODSelectionType = _settings->useLowestSourceLOD ? EMeshLODSelectionType::LowestDetailLOD : EMeshLODSelectionType::SpecificLOD;
+	_mergeSettings.SpecificLOD = 0;
+	_mergeSettings.bMergeMaterials = false;
+	_mergeSettings.bMergePhysicsData = false;
+	_mergeSettings.bGenerateLightMapUV = false;
+	_mergeSettings.bComputedLightMapResolution = false;
+	_mergeSettings.bAllowDistanceField = false;
+
+	// The merge utilities bend the geometry of the spline meshes along their segment
+	const IMeshMergeUtilities& _meshMergeUtilities = FModuleManager::Get().LoadModuleChecked<IMeshMergeModule>("MeshMergeUtilities").GetUtilities();
+	TArray<UActorComponent*> _components = TArray<UActorComponent*>();
+	int _proxyTriangles = 0;
+	int _proxyDrawCalls = 0;
+	int _chunkIndex = 0;
+	for (TPair<TPair<const AActor*, FIntVector>, TArray<UPrimitiveComponent*>>& _chunk : _chunks)
+	{
+		const ADynamicSplineMeshActor* _actor = CastChecked<ADynamicSplineMeshActor>(_chunk.Key.Key);
+
+		// Swap to the LOD meshes of the compositions for the merge
+		TArray<TPair<USplineMeshComponent*, UStaticMesh*>> _swappedMeshes = TArray<TPair<USplineMeshComponent*, UStaticMesh*>>();
+		if (_settings->useLODMeshes)
+		{
+			for (UPrimitiveComponent* _component : _chunk.Value)
+			{
+				USplineMeshComponent* _splineMesh = CastChecked<USplineMeshComponent>(_component);
+				UStaticMesh* _lodMesh = _actor->FindSegment(_splineMesh)->meshComposition.lodMesh;
+				if (!IsValid(_lodMesh) || _lodMesh == _splineMesh->GetStaticMesh()) continue;
+
+				_swappedMeshes.Add(TPair<USplineMeshComponent*, UStaticMesh*>(_splineMesh, _splineMesh->GetStaticMesh()));
+				_splineMesh->SetStaticMesh(_lodMesh);
+			}
+		}
+
+		TArray<UObject*> _assets = TArray<UObject*>();
+		FVector _mergedLocation = FVector::ZeroVector;
+		const FString& _baseName = FString::Printf(TEXT("%s_%s_%d"), *InHLODBuildContext.AssetsBaseName, *_actor->GetName(), _chunkIndex++);
+		_meshMergeUtilities.MergeComponentsToStaticMesh(_chunk.Value, InHLODBuildContext.World, _mergeSettings, nullptr, InHLODBuildContext.AssetsOuter->GetPackage(), _baseName, _assets, _mergedLocation, 0.25f, true);
+
+		for (const TPair<USplineMeshComponent*, UStaticMesh*>& _swappedMesh : _swappedMeshes)
+		{
+			_swappedMesh.Key->SetStaticMesh(_swappedMesh.Value);
+		}
+
+		for (UObject* _asset : _assets)
+		{
+			UStaticMesh* _mesh = Cast<UStaticMesh>(_asset);
+			if (!_mesh) continue;
+			FStaticMeshCompilingManager::Get().FinishCompilation({ _mesh });
+
+			// Simplify the merged mesh, the proxy is only seen from far away
+			if (_settings->percentTriangles < 1.0f && _mesh->GetNumSourceModels() > 0)
+			{
+				_mesh->GetSourceModel(0).ReductionSettings.PercentTriangles = _settings->percentTriangles;
+				_mesh->Build(true);
+				FStaticMeshCompilingManager::Get().FinishCompilation({ _mesh });
+			}
+
+			int _triangles = 0;
+			int _sections = 0;
+			GetMeshCounts(_mesh, 0, _triangles, _sections);
+			_proxyTriangles += _triangles;
+			_proxyDrawCalls += _sections;
+
+			UStaticMeshComponent* _proxy = NewObject<UStaticMeshComponent>();
+			_proxy->SetStaticMesh(_mesh);
+			_proxy->SetWorldLocation(_mergedLocation);
+			_components.Add(_proxy);
+		}
+	}
+
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("HLOD %s: %d spline meshes, %d draw calls, %d triangles -> %d proxies, %d draw calls, %d triangles"),
+		*InHLODBuildContext.AssetsBaseName, InSourceComponents.Num(), _sourceDrawCalls, _sourceTriangles, _components.Num(), _proxyDrawCalls, _proxyTriangles);
+
+	return _components;
+}
+
+void UDynamicSplineMeshHLODBuilder::GetMeshCounts(const UStaticMesh* _mesh, const int _lodIndex, int& _triangles, int& _sections)
+{
+	const FStaticMeshRenderData* _renderData = _mesh ? _mesh->GetRenderData() : nullptr;
+	if (!_renderData || !_renderData->LODResources.IsValidIndex(_lodIndex)) return;
+
+	const FStaticMeshLODResources& _lodResources = _renderData->LODResources[_lodIndex];
+	_triangles = _lodResources.GetNumTriangles();
+	_sections = _lodResources.Sections.Num();
+}
\ No newline at end of file
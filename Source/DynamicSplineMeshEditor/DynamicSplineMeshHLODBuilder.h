@@ -0,0 +1,54 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "WorldPartition/HLOD/HLODBuilder.h"
+#include "DynamicSplineMeshHLODBuilder.generated.h"
+
+/* Settings of the HLOD proxies of the spline actors, set on the HLOD layer */
+UCLASS()
+class UDynamicSplineMeshHLODBuilderSettings : public UHLODBuilderSettings
+{
+	GENERATED_BODY()
+
+public:
+	/*
+	 * Size of the spatial chunks merged in a proxy, in centimeters
+	 * Each actor has a single proxy when it is 0
+	 */
+	UPROPERTY(EditAnywhere, Category = "Dynamic spline mesh", meta = (ClampMin = "0.0"))
+		float chunkSize = 0.0f;
+
+	/* Merge the LOD meshes of the compositions instead of their meshes when they are set */
+	UPROPERTY(EditAnywhere, Category = "Dynamic spline mesh")
+		bool useLODMeshes = true;
+
+	/* Merge the lowest level of detail of the source meshes instead of the first one */
+	UPROPERTY(EditAnywhere, Category = "Dynamic spline mesh")
+		bool useLowestSourceLOD = true;
+
+	/* Fraction of the merged triangles kept by the simplification of the proxy, 1 keeps them all */
+	UPROPERTY(EditAnywhere, Category = "Dynamic spline mesh", meta = (ClampMin = "0.01", ClampMax = "1.0"))
+		float percentTriangles = 0.25f;
+
+	virtual uint32 GetCRC() const override;
+};
+
+/*
+ * Merge the deformed spline meshes of the spline actors in simplified proxies, one per actor or spatial chunk
+ * The proxies only depend on the layout hash and the placement of the actors, not on their transient regenerated components
+ */
+UCLASS()
+class UDynamicSplineMeshHLODBuilder : public UHLODBuilder
+{
+	GENERATED_BODY()
+
+public:
+	virtual TSubclassOf<UHLODBuilderSettings> GetSettingsClass() const override;
+	virtual uint32 ComputeHLODHash(const UActorComponent* InSourceComponent) const override;
+
+protected:
+	virtual TArray<UActorComponent*> Build(const FHLODBuildContext& InHLODBuildContext, const TArray<UActorComponent*>& InSourceComponents) const override;
+
+private:
+	/* Get the number of triangles and of sections, the draw calls, of a static mesh level of detail */
+	static void GetMeshCounts(const UStaticMesh* _mesh, const int _lodIndex, int& _triangles, int& _sections);
+};
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include "DynamicSplineMeshImportCommandlet.h"
+
+#include "DynamicSplineMeshActor.h"
+#include "DynamicSplineMeshEditor.h"
+#include "DynamicSplineMeshPolylineReader.h"
+#include "DynamicSplineMeshRegenerateCommandlet.h"
+#include "HAL/PlatformMemory.h"
+
+UDynamicSplineMeshImportCommandlet::UDynamicSplineMeshImportCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UDynamicSplineMeshImportCommandlet::Main(const FString& Params)
+{
+	TArray<FString> _tokens = TArray<FString>();
+	TArray<FString> _switches = TArray<FString>();
+	TMap<FString, FString> _params = TMap<FString, FString>();
+	ParseCommandLine(*Params, _tokens, _switches, _params);
+
+	// Get the file and the map
+	const FString* _fileParam = _params.Find(TEXT("File"));
+	const FString* _mapParam = _params.Find(TEXT("Map"));
+	if (!_fileParam || !_mapParam)
+	{
+		UE_LOG(LogDynamicSplineMeshEditor, Error, TEXT("Usage: -run=DynamicSplineMeshImport -File=Roads.csv -Map=/Game/Levels/A [-Format=Csv|GeoJson|Bin] [-Class=Path] [-MaxLength=50000] [-MaxPoints=1000] [-Batch=64] [-Origin=X,Y,Z] [-Scale=100] [-NoGenerate] [-NoSave]"));
+		return 1;
+	}
+
+	// Read the settings
+	settings = FSplineImportSettings();
+	FParse::Value(*Params, TEXT("MaxLength="), settings.maxLength);
+	FParse::Value(*Params, TEXT("MaxPoints="), settings.maxPoints);
+	FParse::Value(*Params, TEXT("Batch="), settings.batchSize);
+	FParse::Value(*Params, TEXT("Scale="), settings.scale);
+	settings.maxPoints = FMath::Max(settings.maxPoints, 2);
+	settings.batchSize = FMath::Max(settings.batchSize, 1);
+	settings.generate = !_switches.Contains(TEXT("NoGenerate"));
+	if (const FString* _originParam = _params.Find(TEXT("Origin")))
+	{
+		TArray<FString> _values = TArray<FString>();
+		_originParam->ParseIntoArray(_values, TEXT(","), true);
+		for (int _axis = 0; _axis < FMath::Min(_values.Num(), 3); _axis++)
+		{
+			settings.origin[_axis] = FCString::Atod(*_values[_axis]);
+		}
+	}
+
+	const FString* _classParam = _params.Find(TEXT("Class"));
+	settings.actorClass = _classParam ? LoadClass<ADynamicSplineMeshActor>(nullptr, **_classParam) : ADynamicSplineMeshActor::StaticClass();
+	if (!settings.actorClass)
+	{
+		UE_LOG(LogDynamicSplineMeshEditor, Error, TEXT("'%s' is not a spline actor class"), **_classParam);
+		return 1;
+	}
+
+	const FString* _formatParam = _params.Find(TEXT("Format"));
+	const TUniquePtr<FPolylineReader> _reader = FPolylineReader::Create(*_fileParam, _formatParam ? _formatParam->ToLower() : FString());
+	if (!_reader) return 1;
+
+	world = UDynamicSplineMeshRegenerateCommandlet::LoadWorld(*_mapParam);
+	if (!world) return 1;
+
+	// Stream the file, the actors are spawned and generated as the polylines are read
+	const double _startTime = FPlatformTime::Seconds();
+	points.Reset();
+	length = 0.0;
+	const bool _isRead = _reader->Read([this](const FVector& _point) { AddPoint(_point); }, [this]()
+	{
+		polylinesCount++;
+		SpawnActor(false);
+	});
+	GeneratePendingActors();
+	const double _importTime = FPlatformTime::Seconds() - _startTime;
+
+	// Report the throughput
+	const FPlatformMemoryStats& _memoryStats = FPlatformMemory::GetStats();
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("Imported %s: %d points, %d polylines, %.1f MB"), **_fileParam, pointsCount, polylinesCount, _reader->GetBytesRead() / (1024.0 * 1024.0));
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("%d actors, %d segments in %.2f s (generation %.2f s): %.0f points/s, peak memory %.1f MB"),
+		actorsCount, segmentsCount, _importTime, generateTime, _importTime > 0.0 ? pointsCount / _importTime : 0.0, _memoryStats.PeakUsedPhysical / (1024.0 * 1024.0));
+
+	// Save the map
+	const bool _isSaved = _switches.Contains(TEXT("NoSave")) || actorsCount == 0 || UDynamicSplineMeshRegenerateCommandlet::SaveWorld(world);
+	UDynamicSplineMeshRegenerateCommandlet::ReleaseWorld(world);
+	world = nullptr;
+
+	return _isRead && _isSaved ? 0 : 1;
+}
+
+void UDynamicSplineMeshImportCommandlet::AddPoint(const FVector& _filePoint)
+{
+	pointsCount++;
+	const FVector _point = (_filePoint - settings.origin) * settings.scale;
+
+	// Skip the duplicated points, they make null spline segments
+	if (!points.IsEmpty())
+	{
+		const double _distance = FVector::Dist(points.Last(), _point);
+		if (_distance <= KINDA_SMALL_NUMBER) return;
+		length += _distance;
+	}
+
+	points.Add(_point);
+
+	// Spawn the actor once it is full
+	if (length >= settings.maxLength || points.Num() >= settings.maxPoints) SpawnActor(true);
+}
+
+void UDynamicSplineMeshImportCommandlet::SpawnActor(const bool _continuePolyline)
+{
+	const FVector _lastPoint = points.IsEmpty() ? FVector::ZeroVector : points.Last();
+
+	// A spline needs two points
+	if (points.Num() >= 2)
+	{
+		// Place the actor on the first point and assign the points in a single update
+		FActorSpawnParameters _spawnParameters = FActorSpawnParameters();
+		_spawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		ADynamicSplineMeshActor* _actor = world->SpawnActor<ADynamicSplineMeshActor>(settings.actorClass, points[0], FRotator::ZeroRotator, _spawnParameters);
+		if (_actor)
+		{
+			_actor->SetSplinePoints(points, ESplineCoordinateSpace::World);
+			pendingActors.Add(_actor);
+			actorsCount++;
+		}
+
+		if (pendingActors.Num() >= settings.batchSize) GeneratePendingActors();
+	}
+
+	// The next actor starts where this one ends
+	points.Reset();
+	length = 0.0;
+	if (_continuePolyline) points.Add(_lastPoint);
+}
+
+void UDynamicSplineMeshImportCommandlet::GeneratePendingActors()
+{
+	if (pendingActors.IsEmpty()) return;
+
+	if (settings.generate)
+	{
+		const double _startTime = FPlatformTime::Seconds();
+		segmentsCount += UDynamicSplineMeshRegenerateCommandlet::RegenerateActors(pendingActors, false);
+		generateTime += FPlatformTime::Seconds() - _startTime;
+	}
+
+	pendingActors.Reset();
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DynamicSplineMeshImportCommandlet.generated.h"
+
+class ADynamicSplineMeshActor;
+
+/* Options of an import */
+struct FSplineImportSettings
+{
+	/* The spline actor class spawned for each piece of polyline */
+	UClass* actorClass = nullptr;
+
+	/* Maximum length of the spline of an actor */
+	double maxLength = 50000.0;
+
+	/* Maximum number of points of the spline of an actor */
+	int maxPoints = 1000;
+
+	/* Number of actors generated together, their layouts are computed in parallel */
+	int batchSize = 64;
+
+	/* Origin of the file coordinates, subtracted before the scale */
+	FVector origin = FVector::ZeroVector;
+
+	/* Scale from the file coordinates to the world, 100 for meters */
+	double scale = 1.0;
+
+	/* Generate the spline meshes of the imported actors */
+	bool generate = true;
+};
+
+/*
+ * Import large polyline files into spline actors
+ * The file is streamed, the polylines are split in actors of bounded length and the actors are generated by batches
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=DynamicSplineMeshImport -File=Roads.csv -Map=/Game/Levels/A [-Format=Csv|GeoJson|Bin] [-Class=/Game/BP_Road.BP_Road_C]
+ *        [-MaxLength=50000] [-MaxPoints=1000] [-Batch=64] [-Origin=X,Y,Z] [-Scale=100] [-NoGenerate] [-NoSave] -nullrhi -unattended
+ */
+UCLASS()
+class UDynamicSplineMeshImportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+	/* Settings of the running import */
+	FSplineImportSettings settings = FSplineImportSettings();
+
+	/* The world receiving the actors */
+	UPROPERTY()
+		UWorld* world = nullptr;
+
+	/* Points of the actor being filled, in world space */
+	TArray<FVector> points = TArray<FVector>();
+
+	/* Length of the polyline of the actor being filled */
+	double length = 0.0;
+
+	/* Actors spawned and waiting for their generation */
+	UPROPERTY()
+		TArray<ADynamicSplineMeshActor*> pendingActors = TArray<ADynamicSplineMeshActor*>();
+
+	int pointsCount = 0;
+	int polylinesCount = 0;
+	int actorsCount = 0;
+	int segmentsCount = 0;
+
+	/* Time spent to generate the actors */
+	double generateTime = 0.0;
+
+public:
+	UDynamicSplineMeshImportCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/* Add a point of the file to the actor being filled, the actor is spawned once it is full */
+	void AddPoint(const FVector& _filePoint);
+
+	/* Spawn the actor being filled, the next one starts from its last point when the polyline continues */
+	void SpawnActor(const bool _continuePolyline);
+
+	/* Generate the pending actors */
+	void GeneratePendingActors();
+};
\ No newline at end of file
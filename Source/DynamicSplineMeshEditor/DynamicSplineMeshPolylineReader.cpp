@@ -0,0 +1,281 @@
+#include "DynamicSplineMeshPolylineReader.h"
+
+#include "DynamicSplineMeshEditor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+
+TUniquePtr<FPolylineReader> FPolylineReader::Create(const FString& _path, const FString& _format)
+{
+	const FString& _type = _format.IsEmpty() ? FPaths::GetExtension(_path) : _format;
+	if (_type == TEXT("csv") || _type == TEXT("txt")) return MakeUnique<FCsvPolylineReader>(_path);
+	if (_type == TEXT("geojson") || _type == TEXT("json")) return MakeUnique<FGeoJsonPolylineReader>(_path);
+	if (_type == TEXT("bin") || _type == TEXT("dsmp")) return MakeUnique<FBinaryPolylineReader>(_path);
+
+	UE_LOG(LogDynamicSplineMeshEditor, Error, TEXT("Unknown polyline format '%s' for %s"), *_type, *_path);
+	return nullptr;
+}
+
+bool FPolylineReader::ReadBlocks(TFunctionRef<void(const ANSICHAR*, const int64)> _onBlock)
+{
+	const TUniquePtr<IFileHandle> _file = TUniquePtr<IFileHandle>(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*path));
+	if (!_file)
+	{
+		UE_LOG(LogDynamicSplineMeshEditor, Error, TEXT("Can't open %s"), *path);
+		return false;
+	}
+
+	// Read the file by blocks, a single block is allocated
+	TArray<ANSICHAR> _block = TArray<ANSICHAR>();
+	_block.SetNumUninitialized(BlockSize);
+	const int64 _size = _file->Size();
+	while (bytesRead < _size)
+	{
+		const int64 _blockSize = FMath::Min(BlockSize, _size - bytesRead);
+		if (!_file->Read(reinterpret_cast<uint8*>(_block.GetData()), _blockSize))
+		{
+			UE_LOG(LogDynamicSplineMeshEditor, Error, TEXT("Can't read %s at %lld"), *path, bytesRead);
+			return false;
+		}
+
+		bytesRead += _blockSize;
+		_onBlock(_block.GetData(), _blockSize);
+	}
+
+	return true;
+}
+
+bool FCsvPolylineReader::Read(FOnPoint _onPoint, FOnPolylineEnd _onPolylineEnd)
+{
+	// The line cut by the end of a block is kept for the next one
+	TArray<ANSICHAR> _line = TArray<ANSICHAR>();
+	TArray<ANSICHAR> _polylineId = TArray<ANSICHAR>();
+	bool _hasPolyline = false;
+
+	// Check if a field starts with a number, to skip the header
+	const auto _isNumber = [](const ANSICHAR* _field)
+	{
+		while (*_field == ' ' || *_field == '\t') _field++;
+		return FCharAnsi::IsDigit(*_field) || *_field == '-' || *_field == '+' || *_field == '.';
+	};
+
+	// Parse a complete line in place
+	const auto _parseLine = [&]()
+	{
+		_line.Add('\0');
+
+		// Split the line on the commas
+		TArray<const ANSICHAR*, TInlineAllocator<4>> _fields = TArray<const ANSICHAR*, TInlineAllocator<4>>();
+		_fields.Add(_line.GetData());
+		for (ANSICHAR& _char : _line)
+		{
+			if (_char != ',') continue;
+			_char = '\0';
+			_fields.Add(&_char + 1);
+		}
+
+		// Skip the header and the malformed lines
+		if (_fields.Num() < 3 || !_isNumber(_fields[1]) || !_isNumber(_fields[2]))
+		{
+			_line.Reset();
+			return;
+		}
+
+		// A new id starts a new polyline
+		const int _idLength = FCStringAnsi::Strlen(_fields[0]) + 1;
+		if (_hasPolyline && (_polylineId.Num() != _idLength || FCStringAnsi::Strcmp(_polylineId.GetData(), _fields[0]) != 0)) _onPolylineEnd();
+		_polylineId = TArray<ANSICHAR>(_fields[0], _idLength);
+		_hasPolyline = true;
+
+		const double _z = _fields.Num() > 3 ? FCStringAnsi::Atod(_fields[3]) : 0.0;
+		_onPoint(FVector(FCStringAnsi::Atod(_fields[1]), FCStringAnsi::Atod(_fields[2]), _z));
+		_line.Reset();
+	};
+
+	const bool _isRead = ReadBlocks([&](const ANSICHAR* _data, const int64 _size)
+	{
+		for (int64 _index = 0; _index < _size; _index++)
+		{
+			const ANSICHAR _char = _data[_index];
+			if (_char == '\n') _parseLine();
+			else if (_char != '\r') _line.Add(_char);
+		}
+	});
+
+	// The last line may not end with a line break
+	if (!_line.IsEmpty()) _parseLine();
+	if (_hasPolyline) _onPolylineEnd();
+	return _isRead;
+}
+
+bool FGeoJsonPolylineReader::Read(FOnPoint _onPoint, FOnPolylineEnd _onPolylineEnd)
+{
+	static constexpr int MaxDepth = 8;
+	static const ANSICHAR* Key = "\"coordinates\"";
+	const int _keyLength = FCStringAnsi::Strlen(Key);
+
+	// State of the parser, kept between the blocks
+	int _keyMatched = 0;
+	int _depth = 0;
+	bool _inCoordinates = false;
+	bool _hasNumbers[MaxDepth] = {};
+	bool _hasPoints[MaxDepth] = {};
+	TArray<ANSICHAR> _number = TArray<ANSICHAR>();
+	TArray<double, TInlineAllocator<3>> _coordinates = TArray<double, TInlineAllocator<3>>();
+	int _skippedPoints = 0;
+	bool _isMalformed = false;
+
+	// Add the number being parsed to the current point
+	const auto _flushNumber = [&]()
+	{
+		if (_number.IsEmpty()) return;
+		_number.Add('\0');
+		_coordinates.Add(FCStringAnsi::Atod(_number.GetData()));
+		_number.Reset();
+		_hasNumbers[_depth - 1] = true;
+	};
+
+	const bool _isRead = ReadBlocks([&](const ANSICHAR* _data, const int64 _size)
+	{
+		for (int64 _index = 0; _index < _size && !_isMalformed; _index++)
+		{
+			const ANSICHAR _char = _data[_index];
+
+			// Look for the next coordinates key
+			if (!_inCoordinates)
+			{
+				if (_keyMatched == _keyLength)
+				{
+					// Wait for the first bracket of the coordinates
+					if (_char == '[')
+					{
+						_inCoordinates = true;
+						_depth = 1;
+						_hasNumbers[0] = false;
+						_hasPoints[0] = false;
+						_keyMatched = 0;
+					}
+					else if (_char != ':' && !FCharAnsi::IsWhitespace(_char)) _keyMatched = 0;
+					continue;
+				}
+
+				_keyMatched = _char == Key[_keyMatched] ? _keyMatched + 1 : _char == Key[0] ? 1 : 0;
+				continue;
+			}
+
+			// Parse the nested arrays of the coordinates
+			if (_char == '[')
+			{
+				_flushNumber();
+				if (_depth >= MaxDepth)
+				{
+					_isMalformed = true;
+					continue;
+				}
+
+				_hasNumbers[_depth] = false;
+				_hasPoints[_depth] = false;
+				_depth++;
+			}
+
+			else if (_char == ']')
+			{
+				_flushNumber();
+				const int _level = _depth - 1;
+
+				// The coordinates of a Point geometry are a lone position, it can't make a spline and must not join the next polyline
+				if (_level == 0 && _hasNumbers[_level])
+				{
+					_skippedPoints++;
+				}
+
+				// An array of numbers is a point, an array of points is a polyline
+				else if (_hasNumbers[_level] && _coordinates.Num() >= 2)
+				{
+					_onPoint(FVector(_coordinates[0], _coordinates[1], _coordinates.Num() > 2 ? _coordinates[2] : 0.0));
+					_hasPoints[_level - 1] = true;
+				}
+
+				else if (_hasPoints[_level])
+				{
+					_onPolylineEnd();
+				}
+
+				_coordinates.Reset();
+				_depth--;
+				if (_depth == 0) _inCoordinates = false;
+			}
+
+			else if (_char == ',' || FCharAnsi::IsWhitespace(_char))
+			{
+				_flushNumber();
+			}
+
+			else
+			{
+				_number.Add(_char);
+			}
+		}
+	});
+
+	if (_isMalformed)
+	{
+		UE_LOG(LogDynamicSplineMeshEditor, Error, TEXT("%s: coordinates nested deeper than %d arrays"), *path, MaxDepth);
+		return false;
+	}
+
+	if (_skippedPoints > 0)
+	{
+		UE_LOG(LogDynamicSplineMeshEditor, Warning, TEXT("%s: skipped %d Point geometries, a spline needs a line"), *path, _skippedPoints);
+	}
+
+	return _isRead;
+}
+
+bool FBinaryPolylineReader::Read(FOnPoint _onPoint, FOnPolylineEnd _onPolylineEnd)
+{
+	// The file reader is buffered, the points are read as they come
+	const TUniquePtr<FArchive> _reader = TUniquePtr<FArchive>(IFileManager::Get().CreateFileReader(*path));
+	if (!_reader)
+	{
+		UE_LOG(LogDynamicSplineMeshEditor, Error, TEXT("Can't open %s"), *path);
+		return false;
+	}
+
+	uint32 _magic = 0;
+	uint32 _version = 0;
+	*_reader << _magic << _version;
+	if (_magic != Magic || _version != 1)
+	{
+		UE_LOG(LogDynamicSplineMeshEditor, Error, TEXT("%s is not a version 1 binary polyline file"), *path);
+		return false;
+	}
+
+	const int64 _size = _reader->TotalSize();
+	while (_reader->Tell() < _size && !_reader->IsError())
+	{
+		uint32 _pointsCount = 0;
+		*_reader << _pointsCount;
+
+		// Each point is 3 doubles, a count beyond the end of the file is malformed
+		if (_reader->Tell() + static_cast<int64>(_pointsCount) * 3 * sizeof(double) > _size)
+		{
+			UE_LOG(LogDynamicSplineMeshEditor, Error, TEXT("%s: polyline of %u points cut at %lld"), *path, _pointsCount, _reader->Tell());
+			return false;
+		}
+
+		for (uint32 _pointIndex = 0; _pointIndex < _pointsCount; _pointIndex++)
+		{
+			double _x = 0.0;
+			double _y = 0.0;
+			double _z = 0.0;
+			*_reader << _x << _y << _z;
+			_onPoint(FVector(_x, _y, _z));
+		}
+
+		_onPolylineEnd();
+		bytesRead = _reader->Tell();
+	}
+
+	return !_reader->IsError();
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class IFileHandle;
+
+/*
+ * Streaming reader of polyline files
+ * The file is read by blocks and the points are passed one by one, so the memory doesn't depend on the file size
+ */
+class FPolylineReader
+{
+public:
+	/* Called for each point of a polyline, in the coordinates of the file */
+	using FOnPoint = TFunctionRef<void(const FVector&)>;
+
+	/* Called at the end of each polyline */
+	using FOnPolylineEnd = TFunctionRef<void()>;
+
+	virtual ~FPolylineReader() {}
+
+	/* Read the whole file, returns false if it can't be read or is malformed */
+	virtual bool Read(FOnPoint _onPoint, FOnPolylineEnd _onPolylineEnd) = 0;
+
+	/* Number of bytes read so far */
+	FORCEINLINE int64 GetBytesRead() const
+	{
+		return bytesRead;
+	}
+
+	/*
+	 * Create the reader of a file from its format, or from its extension when the format is empty
+	 * Csv: id,x,y[,z] per line, a new id starts a new polyline
+	 * GeoJson: the coordinates of the LineString, MultiLineString and Polygon geometries, the Point geometries are skipped
+	 * Bin: "DSMP", uint32 version, then per polyline a uint32 count followed by count * 3 doubles
+	 */
+	static TUniquePtr<FPolylineReader> Create(const FString& _path, const FString& _format);
+
+protected:
+	/* Size of the blocks read from the file */
+	static constexpr int64 BlockSize = 1024 * 1024;
+
+	FString path = FString();
+	int64 bytesRead = 0;
+
+	/* Read the file by blocks and pass each block to a callback */
+	bool ReadBlocks(TFunctionRef<void(const ANSICHAR*, const int64)> _onBlock);
+};
+
+/* Reader of the CSV polylines */
+class FCsvPolylineReader : public FPolylineReader
+{
+public:
+	FCsvPolylineReader(const FString& _path) { path = _path; }
+	virtual bool Read(FOnPoint _onPoint, FOnPolylineEnd _onPolylineEnd) override;
+};
+
+/* Reader of the GeoJSON polylines, only the coordinates arrays are parsed */
+class FGeoJsonPolylineReader : public FPolylineReader
+{
+public:
+	FGeoJsonPolylineReader(const FString& _path) { path = _path; }
+	virtual bool Read(FOnPoint _onPoint, FOnPolylineEnd _onPolylineEnd) override;
+};
+
+/* Reader of the binary polylines */
+class FBinaryPolylineReader : public FPolylineReader
+{
+public:
+	/* Magic number of the binary files */
+	static constexpr uint32 Magic = 'D' | ('S' << 8) | ('M' << 16) | ('P' << 24);
+
+	FBinaryPolylineReader(const FString& _path) { path = _path; }
+	virtual bool Read(FOnPoint _onPoint, FOnPolylineEnd _onPolylineEnd) override;
+};
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "DynamicSplineMeshRegenerateCommandlet.h"
+
+#include "DynamicSplineMeshActor.h"
+#include "DynamicSplineMeshEditor.h"
+#include "EngineUtils.h"
+#include "Async/ParallelFor.h"
+#include "Misc/PackageName.h"
+#include "UObject/SavePackage.h"
+
+UDynamicSplineMeshRegenerateCommandlet::UDynamicSplineMeshRegenerateCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UDynamicSplineMeshRegenerateCommandlet::Main(const FString& Params)
+{
+	TArray<FString> _tokens = TArray<FString>();
+	TArray<FString> _switches = TArray<FString>();
+	TMap<FString, FString> _params = TMap<FString, FString>();
+	ParseCommandLine(*Params, _tokens, _switches, _params);
+
+	// Get the maps to regenerate
+	const FString* _mapsParam = _params.Find(TEXT("Maps"));
+	if (!_mapsParam)
+	{
+		UE_LOG(LogDynamicSplineMeshEditor, Error, TEXT("Usage: -run=DynamicSplineMeshRegenerate -Maps=/Game/Levels/A+/Game/Levels/B [-NoSave]"));
+		return 1;
+	}
+
+	TArray<FString> _maps = TArray<FString>();
+	_mapsParam->ParseIntoArray(_maps, TEXT("+"), true);
+	const bool _save = !_switches.Contains(TEXT("NoSave"));
+
+	// Run through the maps
+	const double _startTime = FPlatformTime::Seconds();
+	int _failedMapCount = 0;
+	for (const FString& _map : _maps)
+	{
+		if (!RegenerateMap(_map, _save)) _failedMapCount++;
+	}
+
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("Regenerated %d map(s) in %.2f s, %d failed"), _maps.Num() - _failedMapCount, FPlatformTime::Seconds() - _startTime, _failedMapCount);
+	return _failedMapCount > 0 ? 1 : 0;
+}
+
+int UDynamicSplineMeshRegenerateCommandlet::RegenerateActors(const TArray<ADynamicSplineMeshActor*>& _actors, const bool _logActors)
+{
+	const int _actorCount = _actors.Num();
+	TArray<double> _prepareTimes = TArray<double>();
+	TArray<double> _computeTimes = TArray<double>();
+	TArray<double> _finishTimes = TArray<double>();
+	_prepareTimes.SetNumZeroed(_actorCount);
+	_computeTimes.SetNumZeroed(_actorCount);
+	_finishTimes.SetNumZeroed(_actorCount);
+
+	// The ground checks modify the splines, so they run on the game thread
+	const double _startTime = FPlatformTime::Seconds();
+	for (int _actorIndex = 0; _actorIndex < _actorCount; _actorIndex++)
+	{
+		const double _actorStartTime = FPlatformTime::Seconds();
+		_actors[_actorIndex]->PrepareLayout();
+		_prepareTimes[_actorIndex] = FPlatformTime::Seconds() - _actorStartTime;
+	}
+
+	// Compute the layouts in parallel
+	const double _prepareEndTime = FPlatformTime::Seconds();
+	ParallelFor(_actorCount, [&_actors, &_computeTimes](const int32 _actorIndex)
+	{
+		const double _actorStartTime = FPlatformTime::Seconds();
+		_actors[_actorIndex]->ComputeLayout();
+		_computeTimes[_actorIndex] = FPlatformTime::Seconds() - _actorStartTime;
+	});
+
+	// Create the meshes on the game thread
+	const double _computeEndTime = FPlatformTime::Seconds();
+	int _segmentCount = 0;
+	for (int _actorIndex = 0; _actorIndex < _actorCount; _actorIndex++)
+	{
+		const double _actorStartTime = FPlatformTime::Seconds();
+		_actors[_actorIndex]->FinishLayout();
+		_finishTimes[_actorIndex] = FPlatformTime::Seconds() - _actorStartTime;
+		_segmentCount += _actors[_actorIndex]->GetSegmentCount();
+	}
+	const double _endTime = FPlatformTime::Seconds();
+
+	// Print the timings of each actor
+	for (int _actorIndex = 0; _actorIndex < _actorCount && _logActors; _actorIndex++)
+	{
+		const ADynamicSplineMeshActor* _actor = _actors[_actorIndex];
+		UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("  %s: %d segments, prepare %.3f ms, layout %.3f ms, meshes %.3f ms"),
+			*_actor->GetActorNameOrLabel(), _actor->GetSegmentCount(), _prepareTimes[_actorIndex] * 1000.0, _computeTimes[_actorIndex] * 1000.0, _finishTimes[_actorIndex] * 1000.0);
+	}
+
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("%d actors, %d segments: prepare %.3f ms, parallel layout %.3f ms, meshes %.3f ms, total %.3f ms"),
+		_actorCount, _segmentCount, (_prepareEndTime - _startTime) * 1000.0, (_computeEndTime - _prepareEndTime) * 1000.0, (_endTime - _computeEndTime) * 1000.0, (_endTime - _startTime) * 1000.0);
+
+	// Print how many copies of identical splines were laid out from the shared cache
+	FSplineMeshLayoutCache::Get().LogStats();
+
+	return _segmentCount;
+}
+
+bool UDynamicSplineMeshRegenerateCommandlet::RegenerateMap(const FString& _mapName, const bool _save) const
+{
+	UWorld* _world = LoadWorld(_mapName);
+	if (!_world) return false;
+
+	// Find all the actors of the map
+	TArray<ADynamicSplineMeshActor*> _actors = TArray<ADynamicSplineMeshActor*>();
+	for (TActorIterator<ADynamicSplineMeshActor> _iterator(_world); _iterator; ++_iterator)
+	{
+		_actors.Add(*_iterator);
+	}
+
+	RegenerateActors(_actors);
+
+	// Save the map
+	const bool _isSaved = !_save || _actors.IsEmpty() || SaveWorld(_world);
+	ReleaseWorld(_world);
+	return _isSaved;
+}
+
+UWorld* UDynamicSplineMeshRegenerateCommandlet::LoadWorld(const FString& _mapName)
+{
+	UE_LOG(LogDynamicSplineMeshEditor, Display, TEXT("Loading %s"), *_mapName);
+
+	// Load the map
+	UPackage* _package = LoadPackage(nullptr, *_mapName, LOAD_None);
+	UWorld* _world = _package ? UWorld::FindWorldInPackage(_package) : nullptr;
+	if (!_world)
+	{
+		UE_LOG(LogDynamicSplineMeshEditor, Error, TEXT("Can't load the map %s"), *_mapName);
+		return nullptr;
+	}
+
+	// Initialize the world without rendering, the physics scene is needed by the ground checks
+	_world->WorldType = EWorldType::Editor;
+	_world->AddToRoot();
+	if (!_world->bIsWorldInitialized)
+	{
+		_world->InitWorld(UWorld::InitializationValues()
+			.RequiresHitProxies(false)
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(true)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(true));
+	}
+	_world->UpdateWorldComponents(false, false);
+
+	return _world;
+}
+
+bool UDynamicSplineMeshRegenerateCommandlet::SaveWorld(UWorld* _world)
+{
+	UPackage* _package = _world->GetPackage();
+	_package->MarkPackageDirty();
+	const FString& _filename = FPackageName::LongPackageNameToFilename(_package->GetName(), FPackageName::GetMapPackageExtension());
+
+	FSavePackageArgs _saveArgs = FSavePackageArgs();
+	_saveArgs.TopLevelFlags = RF_Standalone;
+	_saveArgs.SaveFlags = SAVE_NoError;
+	const bool _isSaved = UPackage::SavePackage(_package, _world, *_filename, _saveArgs);
+
+	if (!_isSaved)
+	{
+		UE_LOG(LogDynamicSplineMeshEditor, Error, TEXT("Can't save the map %s"), *_filename);
+	}
+
+	return _isSaved;
+}
+
+void UDynamicSplineMeshRegenerateCommandlet::ReleaseWorld(UWorld* _world)
+{
+	_world->RemoveFromRoot();
+	_world->DestroyWorld(false);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
\ No newline at end of file
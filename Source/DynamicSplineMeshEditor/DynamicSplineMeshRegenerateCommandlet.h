@@ -0,0 +1,42 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DynamicSplineMeshRegenerateCommandlet.generated.h"
+
+class ADynamicSplineMeshActor;
+
+/*
+ * Regenerate every DynamicSplineMesh actor of a set of maps and save them
+ * The layouts are computed in parallel on the task graph, the ground checks and the meshes stay on the game thread
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=DynamicSplineMeshRegenerate -Maps=/Game/Levels/A+/Game/Levels/B [-NoSave] -nullrhi -unattended
+ */
+UCLASS()
+class UDynamicSplineMeshRegenerateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDynamicSplineMeshRegenerateCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	/*
+	 * Regenerate the given actors, the layouts are computed in parallel
+	 * Print the timings, of each actor when asked, and return the total number of segments
+	 */
+	static int RegenerateActors(const TArray<ADynamicSplineMeshActor*>& _actors, const bool _logActors = true);
+
+	/* Load a map and initialize its world for the ground checks, without rendering */
+	static UWorld* LoadWorld(const FString& _mapName);
+
+	/* Save the map of a world */
+	static bool SaveWorld(UWorld* _world);
+
+	/* Release a world loaded by LoadWorld */
+	static void ReleaseWorld(UWorld* _world);
+
+private:
+	/* Load a map, regenerate its actors and save it */
+	bool RegenerateMap(const FString& _mapName, const bool _save) const;
+};
\ No newline at end of file
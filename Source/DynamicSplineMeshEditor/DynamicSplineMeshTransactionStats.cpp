@@ -0,0 +1,86 @@
+#include "DynamicSplineMeshEditor.h"
+
+#include "DynamicSplineMeshActor.h"
+#include "Editor.h"
+#include "Editor/Transactor.h"
+#include "Engine/Selection.h"
+#include "HAL/IConsoleManager.h"
+#include "ScopedTransaction.h"
+
+/* Get the number of transactions and the memory of the undo buffer */
+static SIZE_T GetTransactionBufferSize(int& _transactionsCount)
+{
+	_transactionsCount = 0;
+	if (!GEditor || !GEditor->Trans) return 0;
+
+	SIZE_T _size = 0;
+	_transactionsCount = GEditor->Trans->GetQueueLength();
+	for (int _transactionIndex = 0; _transactionIndex < _transactionsCount; _transactionIndex++)
+	{
+		const FTransaction* _transaction = GEditor->Trans->GetTransaction(_transactionIndex);
+		if (_transaction) _size += _transaction->DataSize();
+	}
+
+	return _size;
+}
+
+/* Print the size of the undo buffer */
+static void LogTransactionBuffer(FOutputDevice& _output)
+{
+	int _transactionsCount = 0;
+	const SIZE_T _size = GetTransactionBufferSize(_transactionsCount);
+	_output.Logf(TEXT("Undo buffer: %d transactions, %.1f KB"), _transactionsCount, _size / 1024.0);
+}
+
+/*
+ * Edit the gap of the selected spline actor in as many transactions and print the growth of the undo buffer
+ * The edits are left in the undo buffer
+ */
+static void MeasureTransactionBuffer(const TArray<FString>& _args, FOutputDevice& _output)
+{
+	if (!GEditor) return;
+
+	int _editsCount = 100;
+	FParse::Value(*FString::Join(_args, TEXT(" ")), TEXT("Edits="), _editsCount);
+
+	// Get the selected spline actor and its gap
+	ADynamicSplineMeshActor* _actor = GEditor->GetSelectedActors()->GetTop<ADynamicSplineMeshActor>();
+	const FFloatProperty* _gapProperty = FindFProperty<FFloatProperty>(ADynamicSplineMeshActor::StaticClass(), TEXT("gap"));
+	if (!_actor || !_gapProperty)
+	{
+		UE_LOG(LogDynamicSplineMeshEditor, Warning, TEXT("Select a dynamic spline mesh actor to measure the undo buffer"));
+		return;
+	}
+
+	int _startTransactionsCount = 0;
+	const SIZE_T _startSize = GetTransactionBufferSize(_startTransactionsCount);
+
+	// Edit and rebuild the spline as the details panel would
+	const float _startGap = _gapProperty->GetPropertyValue_InContainer(_actor);
+	for (int _editIndex = 0; _editIndex < _editsCount; _editIndex++)
+	{
+		const FScopedTransaction _transaction(NSLOCTEXT("DynamicSplineMeshEditor", "MeasureUndoEdit", "Measure spline undo"));
+		_actor->Modify();
+		_gapProperty->SetPropertyValue_InContainer(_actor, _startGap + (_editIndex % 2 == 0 ? 1.0f : 0.0f));
+		_actor->PrepareLayout();
+		_actor->ComputeLayout();
+		_actor->FinishLayout();
+	}
+
+	int _endTransactionsCount = 0;
+	const SIZE_T _endSize = GetTransactionBufferSize(_endTransactionsCount);
+	const double _growth = (static_cast<double>(_endSize) - static_cast<double>(_startSize)) / 1024.0;
+	_output.Logf(TEXT("Undo buffer after %d edits of %s: %d -> %d transactions, %.1f KB -> %.1f KB (%.1f KB, %.2f KB per edit)"),
+		_editsCount, *_actor->GetActorNameOrLabel(), _startTransactionsCount, _endTransactionsCount,
+		_startSize / 1024.0, _endSize / 1024.0, _growth, _editsCount > 0 ? _growth / _editsCount : 0.0);
+}
+
+static FAutoConsoleCommandWithOutputDevice CmdUndoStats(
+	TEXT("dsm.Undo.Stats"),
+	TEXT("Print the number of transactions and the memory of the undo buffer"),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&LogTransactionBuffer));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CmdUndoMeasure(
+	TEXT("dsm.Undo.Measure"),
+	TEXT("Rebuild the selected spline actor in as many transactions and print the growth of the undo buffer. Args: [Edits=100]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& _args, UWorld*, FOutputDevice& _output) { MeasureTransactionBuffer(_args, _output); }));
\ No newline at end of file
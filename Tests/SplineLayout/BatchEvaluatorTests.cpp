@@ -0,0 +1,109 @@
+#include "SplineLayoutTestUtils.h"
+#include <random>
+#include <string>
+
+using namespace SplineLayoutTest;
+
+namespace
+{
+	/* Name of the target the evaluator was compiled for */
+	std::string GetCompiledTarget()
+	{
+#if defined(SPLINE_LAYOUT_AVX)
+		return "AVX";
+#elif defined(SPLINE_LAYOUT_SSE2)
+		return "SSE2";
+#elif defined(SPLINE_LAYOUT_NEON)
+		return "NEON";
+#else
+		return "Scalar";
+#endif
+	}
+
+	/* Check the batch against the scalar evaluation of each distance */
+	void ExpectDistancesMatchScalar(const HermiteSpline& _spline, const std::vector<double>& _distances)
+	{
+		SplineSamples _samples = SplineSamples();
+		BatchEvaluator(_spline).EvaluateDistances(_distances.data(), _distances.size(), _samples);
+		ASSERT_EQ(_samples.Num(), _distances.size());
+
+		for (size_t _index = 0; _index < _distances.size(); _index++)
+		{
+			const double _key = _spline.GetKeyAtDistance(_distances[_index]);
+			ExpectVectorNear(_samples.GetLocation(_index), _spline.GetLocation(_key), 1e-9);
+			ExpectVectorNear(_samples.GetTangent(_index), _spline.GetTangent(_key), 1e-9);
+		}
+	}
+}
+
+TEST(BatchEvaluator, CompiledForTheExpectedTarget)
+{
+	EXPECT_EQ(GetCompiledTarget(), SPLINE_LAYOUT_EXPECTED_TARGET);
+}
+
+TEST(BatchEvaluator, SortedDistancesMatchScalar)
+{
+	const HermiteSpline& _spline = MakeWindingSpline(64);
+	std::vector<double> _distances = std::vector<double>();
+	for (int _index = 0; _index <= 4099; _index++)
+	{
+		_distances.push_back(_spline.GetLength() * _index / 4099.0);
+	}
+
+	ExpectDistancesMatchScalar(_spline, _distances);
+}
+
+TEST(BatchEvaluator, UnsortedAndOutOfRangeDistancesMatchScalar)
+{
+	const HermiteSpline& _spline = MakeWindingSpline(32, true);
+	std::mt19937 _random = std::mt19937(42);
+	std::uniform_real_distribution<double> _distribution = std::uniform_real_distribution<double>(-100.0, _spline.GetLength() + 100.0);
+
+	// An odd count also covers the queries after the last group of four
+	std::vector<double> _distances = std::vector<double>(1023);
+	for (double& _distance : _distances)
+	{
+		_distance = _distribution(_random);
+	}
+
+	ExpectDistancesMatchScalar(_spline, _distances);
+}
+
+TEST(BatchEvaluator, KeysMatchScalar)
+{
+	const HermiteSpline& _spline = MakeWindingSpline(16);
+	std::vector<double> _keys = std::vector<double>();
+	for (int _index = -3; _index <= 170; _index++)
+	{
+		_keys.push_back(_index * 0.1);
+	}
+
+	SplineSamples _samples = SplineSamples();
+	BatchEvaluator(_spline).EvaluateKeys(_keys.data(), _keys.size(), _samples);
+	for (size_t _index = 0; _index < _keys.size(); _index++)
+	{
+		ExpectVectorNear(_samples.GetLocation(_index), _spline.GetLocation(_keys[_index]), 1e-9);
+		ExpectVectorNear(_samples.GetTangent(_index), _spline.GetTangent(_keys[_index]), 1e-9);
+	}
+}
+
+TEST(BatchEvaluator, SplineWithoutSegmentIsItsFirstPoint)
+{
+	const HermiteSpline& _spline = MakeLinearSpline({ Vector3(1.0, 2.0, 3.0) });
+	const std::vector<double> _distances = { 0.0, 5.0, 10.0, 15.0, 20.0 };
+
+	SplineSamples _samples = SplineSamples();
+	BatchEvaluator(_spline).EvaluateDistances(_distances.data(), _distances.size(), _samples);
+	for (size_t _index = 0; _index < _distances.size(); _index++)
+	{
+		ExpectVectorNear(_samples.GetLocation(_index), Vector3(1.0, 2.0, 3.0), 0.0);
+	}
+}
+
+TEST(BatchEvaluator, EmptyBatch)
+{
+	const HermiteSpline& _spline = MakeWindingSpline(4);
+	SplineSamples _samples = SplineSamples();
+	BatchEvaluator(_spline).EvaluateDistances(nullptr, 0, _samples);
+	EXPECT_EQ(_samples.Num(), 0u);
+}
\ No newline at end of file
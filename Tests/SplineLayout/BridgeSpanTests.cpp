@@ -0,0 +1,146 @@
+#include "SplineLayoutTestUtils.h"
+
+using namespace SplineLayoutTest;
+
+namespace
+{
+	const Vector3 Up = Vector3(0.0, 0.0, 1.0);
+
+	Vector3 GetLocation(const BridgeSpan& _span, const double _distance)
+	{
+		Vector3 _location = Vector3(), _direction = Vector3();
+		_span.GetAtDistance(_distance, _location, _direction);
+		return _location;
+	}
+
+	Vector3 GetDirection(const BridgeSpan& _span, const double _distance)
+	{
+		Vector3 _location = Vector3(), _direction = Vector3();
+		_span.GetAtDistance(_distance, _location, _direction);
+		return _direction;
+	}
+}
+
+TEST(BridgeSpan, ParabolaSagsByTheDepthAtTheMiddle)
+{
+	BridgeSpan _span = BridgeSpan();
+	_span.Build(Vector3(0.0, 0.0, 0.0), Vector3(1000.0, 0.0, 0.0), Up, 100.0, SagProfile::Parabola, 0.0);
+	EXPECT_EQ(_span.GetBaysCount(), 1);
+
+	ExpectVectorNear(GetLocation(_span, 0.0), Vector3(0.0, 0.0, 0.0), 1e-9);
+	ExpectVectorNear(GetLocation(_span, _span.GetLength()), Vector3(1000.0, 0.0, 0.0), 1e-9);
+	ExpectVectorNear(GetLocation(_span, _span.GetLength() / 2.0), Vector3(500.0, 0.0, -100.0), 1e-6);
+}
+
+TEST(BridgeSpan, ParabolaLengthMatchesTheArc)
+{
+	const double _chord = 1000.0;
+	const double _sag = 150.0;
+	BridgeSpan _span = BridgeSpan();
+	_span.Build(Vector3(0.0, 0.0, 0.0), Vector3(_chord, 0.0, 0.0), Up, _sag, SagProfile::Parabola, 0.0);
+
+	// Length of y = 4 s x (L - x) / L^2 between 0 and L
+	const double _slope = 4.0 * _sag / _chord;
+	const double _arcLength = _chord / 2.0 * (std::sqrt(1.0 + _slope * _slope) + std::asinh(_slope) / _slope);
+	EXPECT_NEAR(_span.GetLength(), _arcLength, _arcLength * 1e-3);
+	EXPECT_LT(_span.GetLength(), _arcLength);
+}
+
+TEST(BridgeSpan, CatenarySagsByTheDepthAtTheMiddle)
+{
+	BridgeSpan _span = BridgeSpan();
+	_span.Build(Vector3(0.0, 0.0, 0.0), Vector3(1000.0, 0.0, 0.0), Up, 200.0, SagProfile::Catenary, 0.0);
+	ExpectVectorNear(GetLocation(_span, _span.GetLength() / 2.0), Vector3(500.0, 0.0, -200.0), 1e-6);
+	ExpectVectorNear(GetLocation(_span, _span.GetLength()), Vector3(1000.0, 0.0, 0.0), 1e-9);
+}
+
+TEST(BridgeSpan, CatenaryParameterSolvesTheSag)
+{
+	for (const double _depth : { 0.5, 10.0, 100.0, 500.0, 2000.0 })
+	{
+		const double _parameter = BridgeSpan::SolveCatenary(1000.0, _depth);
+		EXPECT_NEAR(_parameter * (std::cosh(500.0 / _parameter) - 1.0), _depth, _depth * 1e-9);
+	}
+
+	EXPECT_DOUBLE_EQ(BridgeSpan::SolveCatenary(1000.0, 0.0), 0.0);
+}
+
+TEST(BridgeSpan, NegativeSagArches)
+{
+	BridgeSpan _span = BridgeSpan();
+	_span.Build(Vector3(0.0, 0.0, 0.0), Vector3(1000.0, 0.0, 0.0), Up, -80.0, SagProfile::Parabola, 0.0);
+	ExpectVectorNear(GetLocation(_span, _span.GetLength() / 2.0), Vector3(500.0, 0.0, 80.0), 1e-6);
+	EXPECT_GT(GetDirection(_span, 0.0).z, 0.0);
+}
+
+TEST(BridgeSpan, DirectionsFollowTheSlope)
+{
+	BridgeSpan _span = BridgeSpan();
+	_span.Build(Vector3(0.0, 0.0, 0.0), Vector3(1000.0, 0.0, 0.0), Up, 100.0, SagProfile::Parabola, 0.0);
+
+	// The slope of the parabola at its ends is 4 s / L, flat at the middle
+	ExpectVectorNear(GetDirection(_span, 0.0), Vector3(1.0, 0.0, -0.4).GetSafeNormal(), 1e-9);
+	ExpectVectorNear(GetDirection(_span, _span.GetLength()), Vector3(1.0, 0.0, 0.4).GetSafeNormal(), 1e-9);
+	ExpectVectorNear(GetDirection(_span, _span.GetLength() / 2.0), Vector3(1.0, 0.0, 0.0), 1e-6);
+}
+
+TEST(BridgeSpan, SupportSpacingSplitsTheBays)
+{
+	BridgeSpan _span = BridgeSpan();
+	_span.Build(Vector3(0.0, 0.0, 0.0), Vector3(0.0, 900.0, 0.0), Up, 30.0, SagProfile::Catenary, 400.0);
+	ASSERT_EQ(_span.GetBaysCount(), 3);
+
+	// The supports are on the chord and the bays sag between them
+	const double _bayLength = _span.GetLength() / 3.0;
+	ExpectVectorNear(GetLocation(_span, _bayLength), Vector3(0.0, 300.0, 0.0), 1e-6);
+	ExpectVectorNear(GetLocation(_span, _bayLength * 2.0), Vector3(0.0, 600.0, 0.0), 1e-6);
+	ExpectVectorNear(GetLocation(_span, _bayLength * 1.5), Vector3(0.0, 450.0, -30.0), 1e-6);
+}
+
+TEST(BridgeSpan, DistancesAreClamped)
+{
+	BridgeSpan _span = BridgeSpan();
+	_span.Build(Vector3(0.0, 0.0, 0.0), Vector3(100.0, 0.0, 0.0), Up, 10.0, SagProfile::Parabola, 0.0);
+	ExpectVectorNear(GetLocation(_span, -50.0), Vector3(0.0, 0.0, 0.0), 1e-9);
+	ExpectVectorNear(GetLocation(_span, 1e6), Vector3(100.0, 0.0, 0.0), 1e-9);
+}
+
+TEST(BridgeSpan, EmptyChordHasNoDeck)
+{
+	BridgeSpan _span = BridgeSpan();
+	_span.Build(Vector3(5.0, 5.0, 5.0), Vector3(5.0, 5.0, 5.0), Up, 10.0, SagProfile::Catenary, 0.0);
+	EXPECT_DOUBLE_EQ(_span.GetLength(), 0.0);
+
+	int _planks = 0;
+	PlaceDeck(_span, 10.0, 0.0, [&_planks](const double, const double) { _planks++; });
+	EXPECT_EQ(_planks, 0);
+}
+
+TEST(PlaceDeck, PlanksCoverTheDeck)
+{
+	BridgeSpan _span = BridgeSpan();
+	_span.Build(Vector3(0.0, 0.0, 0.0), Vector3(1000.0, 0.0, 0.0), Up, 100.0, SagProfile::Catenary, 0.0);
+
+	std::vector<std::pair<double, double>> _planks = std::vector<std::pair<double, double>>();
+	PlaceDeck(_span, 90.0, 10.0, [&_planks](const double _start, const double _end) { _planks.emplace_back(_start, _end); });
+
+	// The count is rounded and the planks stretch to end on the far side
+	const int _expectedCount = static_cast<int>(std::lround(_span.GetLength() / 100.0));
+	ASSERT_EQ(static_cast<int>(_planks.size()), _expectedCount);
+	EXPECT_DOUBLE_EQ(_planks.front().first, 0.0);
+	EXPECT_NEAR(_planks.back().second, _span.GetLength() - 10.0, 1e-9);
+	for (size_t _index = 1; _index < _planks.size(); _index++)
+	{
+		EXPECT_NEAR(_planks[_index].first - _planks[_index - 1].second, 10.0, 1e-9);
+	}
+}
+
+TEST(PlaceDeck, ShortDeckGetsOnePlank)
+{
+	BridgeSpan _span = BridgeSpan();
+	_span.Build(Vector3(0.0, 0.0, 0.0), Vector3(30.0, 0.0, 0.0), Up, 0.0, SagProfile::Parabola, 0.0);
+
+	int _planks = 0;
+	PlaceDeck(_span, 100.0, 0.0, [&_planks](const double _start, const double _end) { _planks++; EXPECT_DOUBLE_EQ(_end - _start, 30.0); });
+	EXPECT_EQ(_planks, 1);
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "SplineLayoutTestUtils.h"
+
+using namespace SplineLayoutTest;
+
+TEST(FrameTable, SamplesCoverTheWholeSpline)
+{
+	const HermiteSpline& _spline = MakeLinearSpline({ Vector3(0.0, 0.0, 0.0), Vector3(105.0, 0.0, 0.0) });
+	FrameTable _frameTable = FrameTable();
+	_frameTable.Build(_spline, 10.0, Vector3(0.0, 0.0, 1.0));
+
+	// Eleven samples at 10 apart and the last one at the end
+	EXPECT_EQ(_frameTable.GetFrameCount(), 12u);
+	EXPECT_DOUBLE_EQ(_frameTable.GetLength(), 105.0);
+	ExpectVectorNear(_frameTable.GetFrameAtDistance(105.0).location, Vector3(105.0, 0.0, 0.0), 1e-9);
+	ExpectVectorNear(_frameTable.GetFrameAtDistance(102.5).location, Vector3(102.5, 0.0, 0.0), 1e-9);
+}
+
+TEST(FrameTable, SpacingIsAtLeastOne)
+{
+	const HermiteSpline& _spline = MakeLinearSpline({ Vector3(0.0, 0.0, 0.0), Vector3(10.5, 0.0, 0.0) });
+	FrameTable _frameTable = FrameTable();
+	_frameTable.Build(_spline, 0.0, Vector3(0.0, 0.0, 1.0));
+	EXPECT_EQ(_frameTable.GetFrameCount(), 12u);
+}
+
+TEST(FrameTable, FramesAreOrthonormal)
+{
+	const HermiteSpline& _spline = MakeWindingSpline(20);
+	FrameTable _frameTable = FrameTable();
+	_frameTable.Build(_spline, 25.0, Vector3(0.0, 0.0, 1.0));
+
+	for (int _index = 0; _index <= 500; _index++)
+	{
+		const SplineFrame& _frame = _frameTable.GetFrameAtDistance(_spline.GetLength() * _index / 500.0);
+		if (_frame.tangent.Length() <= 0.0) continue;
+
+		EXPECT_NEAR(_frame.right.Length(), 1.0, 1e-9);
+		EXPECT_NEAR(_frame.up.Length(), 1.0, 1e-9);
+		EXPECT_NEAR(_frame.right.Dot(_frame.up), 0.0, 1e-2);
+		EXPECT_NEAR(_frame.right.Dot(Vector3(0.0, 0.0, 1.0)), 0.0, 1e-9);
+	}
+}
+
+TEST(FrameTable, InterpolationStaysCloseToTheSpline)
+{
+	const HermiteSpline& _spline = MakeQuarterCircle(1000.0);
+	FrameTable _frameTable = FrameTable();
+	_frameTable.Build(_spline, 10.0, Vector3(0.0, 0.0, 1.0));
+
+	// The chord between two samples 10 apart on a radius of 1000 is off by 10^2 / (8 * 1000), plus the error of the distance table along the curve
+	for (int _index = 0; _index <= 300; _index++)
+	{
+		const double _distance = _spline.GetLength() * _index / 300.0;
+		ExpectVectorNear(_frameTable.GetFrameAtDistance(_distance).location, _spline.GetLocationAtDistance(_distance), 0.1);
+	}
+}
+
+TEST(FrameTable, RightVectorOfAFlatCurveIsHorizontal)
+{
+	const HermiteSpline& _spline = MakeLinearSpline({ Vector3(0.0, 0.0, 0.0), Vector3(100.0, 0.0, 0.0) });
+	FrameTable _frameTable = FrameTable();
+	_frameTable.Build(_spline, 10.0, Vector3(0.0, 0.0, 1.0));
+
+	const SplineFrame& _frame = _frameTable.GetFrameAtDistance(50.0);
+	ExpectVectorNear(_frame.right, Vector3(0.0, 1.0, 0.0), 1e-9);
+	ExpectVectorNear(_frame.up, Vector3(0.0, 0.0, 1.0), 1e-9);
+	ExpectVectorNear(_frame.GetOffsetLocation(200.0, 10.0), Vector3(50.0, 200.0, 10.0), 1e-9);
+}
+
+TEST(FrameTable, VerticalTangentFallsBackOnY)
+{
+	const SplineFrame& _frame = FrameTable::MakeFrame(Vector3(), Vector3(0.0, 0.0, 10.0), Vector3(0.0, 0.0, 1.0));
+	ExpectVectorNear(_frame.right, Vector3(0.0, 1.0, 0.0), 0.0);
+}
+
+TEST(FrameTable, EmptyTableReturnsADefaultFrame)
+{
+	const FrameTable _frameTable = FrameTable();
+	ExpectVectorNear(_frameTable.GetFrameAtDistance(10.0).location, Vector3(), 0.0);
+}
\ No newline at end of file
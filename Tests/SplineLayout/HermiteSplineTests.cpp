@@ -0,0 +1,100 @@
+#include "SplineLayoutTestUtils.h"
+
+using namespace SplineLayoutTest;
+
+TEST(HermiteSpline, EmptyAndSinglePointHaveNoLength)
+{
+	const HermiteSpline _empty = HermiteSpline();
+	EXPECT_EQ(_empty.GetSegmentCount(), 0);
+	EXPECT_DOUBLE_EQ(_empty.GetLength(), 0.0);
+	EXPECT_DOUBLE_EQ(_empty.GetKeyAtDistance(10.0), 0.0);
+
+	const HermiteSpline& _single = MakeLinearSpline({ Vector3(5.0, 6.0, 7.0) });
+	EXPECT_EQ(_single.GetSegmentCount(), 0);
+	EXPECT_DOUBLE_EQ(_single.GetLength(), 0.0);
+	ExpectVectorNear(_single.GetLocationAtDistance(3.0), Vector3(5.0, 6.0, 7.0), 0.0);
+}
+
+TEST(HermiteSpline, LinearLengthIsTheSumOfTheSides)
+{
+	const HermiteSpline& _spline = MakeLinearSpline({ Vector3(0.0, 0.0, 0.0), Vector3(300.0, 0.0, 0.0), Vector3(300.0, 400.0, 0.0) });
+	EXPECT_NEAR(_spline.GetLength(), 700.0, 1e-9);
+	EXPECT_NEAR(_spline.GetDistanceAtPoint(1), 300.0, 1e-9);
+	EXPECT_NEAR(_spline.GetDistanceAtPoint(2), 700.0, 1e-9);
+}
+
+TEST(HermiteSpline, ClosedLoopAddsTheClosingSide)
+{
+	const HermiteSpline& _spline = MakeLinearSpline({ Vector3(0.0, 0.0, 0.0), Vector3(300.0, 0.0, 0.0), Vector3(300.0, 400.0, 0.0) }, true);
+	EXPECT_EQ(_spline.GetSegmentCount(), 3);
+	EXPECT_NEAR(_spline.GetLength(), 1200.0, 1e-9);
+	ExpectVectorNear(_spline.GetLocationAtDistance(1200.0), Vector3(0.0, 0.0, 0.0), 1e-9);
+}
+
+TEST(HermiteSpline, StraightCurveLengthIsExact)
+{
+	// Tangents equal to the chord make a uniform straight segment
+	const HermiteSpline _spline = HermiteSpline({ MakePoint(Vector3(0.0, 0.0, 0.0), Vector3(500.0, 0.0, 0.0)), MakePoint(Vector3(500.0, 0.0, 0.0), Vector3(500.0, 0.0, 0.0)) });
+	EXPECT_NEAR(_spline.GetLength(), 500.0, 1e-9);
+	EXPECT_NEAR(_spline.GetKeyAtDistance(125.0), 0.25, 1e-9);
+	ExpectVectorNear(_spline.GetLocationAtDistance(125.0), Vector3(125.0, 0.0, 0.0), 1e-9);
+}
+
+TEST(HermiteSpline, QuarterCircleLengthMatchesTheArc)
+{
+	const double _radius = 1000.0;
+	const HermiteSpline& _spline = MakeQuarterCircle(_radius);
+
+	// The cubic is not exactly a circle, it stays within a few hundredths of a percent
+	const double _arcLength = _radius * 3.14159265358979323846 / 2.0;
+	EXPECT_NEAR(_spline.GetLength(), _arcLength, _arcLength * 5e-4);
+}
+
+TEST(HermiteSpline, KeyLookupFollowsTheSides)
+{
+	const HermiteSpline& _spline = MakeLinearSpline({ Vector3(0.0, 0.0, 0.0), Vector3(100.0, 0.0, 0.0), Vector3(100.0, 300.0, 0.0) });
+
+	// A linear side is traveled at a constant speed, the key is proportional to the distance
+	EXPECT_NEAR(_spline.GetKeyAtDistance(50.0), 0.5, 1e-9);
+	EXPECT_NEAR(_spline.GetKeyAtDistance(100.0), 1.0, 1e-9);
+	EXPECT_NEAR(_spline.GetKeyAtDistance(175.0), 1.25, 1e-9);
+	ExpectVectorNear(_spline.GetLocationAtDistance(175.0), Vector3(100.0, 75.0, 0.0), 1e-9);
+}
+
+TEST(HermiteSpline, KeyLookupClampsOutOfRangeDistances)
+{
+	const HermiteSpline& _spline = MakeLinearSpline({ Vector3(0.0, 0.0, 0.0), Vector3(100.0, 0.0, 0.0), Vector3(200.0, 0.0, 0.0) });
+	EXPECT_DOUBLE_EQ(_spline.GetKeyAtDistance(-10.0), 0.0);
+	EXPECT_DOUBLE_EQ(_spline.GetKeyAtDistance(1000.0), 2.0);
+	ExpectVectorNear(_spline.GetLocationAtDistance(1000.0), Vector3(200.0, 0.0, 0.0), 1e-9);
+}
+
+TEST(HermiteSpline, KeyLookupIsMonotonicAndRoundTrips)
+{
+	const HermiteSpline& _spline = MakeWindingSpline(40);
+	const double _length = _spline.GetLength();
+
+	double _previousKey = -1.0;
+	for (int _index = 0; _index <= 1000; _index++)
+	{
+		const double _distance = _length * _index / 1000.0;
+		const double _key = _spline.GetKeyAtDistance(_distance);
+		EXPECT_GE(_key, _previousKey);
+		_previousKey = _key;
+	}
+
+	// The distance of each point maps back to its key, the end of a constant segment shares the distance of its start
+	for (int _pointIndex = 0; _pointIndex < _spline.GetPointCount(); _pointIndex++)
+	{
+		if (_pointIndex < _spline.GetSegmentCount() && _spline.GetSegmentLength(_pointIndex) <= 0.0) continue;
+		EXPECT_NEAR(_spline.GetKeyAtDistance(_spline.GetDistanceAtPoint(_pointIndex)), _pointIndex, 1e-9);
+	}
+}
+
+TEST(HermiteSpline, ConstantSegmentStaysOnItsStart)
+{
+	const HermiteSpline _spline = HermiteSpline({ MakePoint(Vector3(0.0, 0.0, 0.0), Vector3(), InterpMode::Constant), MakePoint(Vector3(100.0, 0.0, 0.0), Vector3()) });
+	EXPECT_DOUBLE_EQ(_spline.GetLength(), 0.0);
+	ExpectVectorNear(_spline.GetLocation(0.5), Vector3(0.0, 0.0, 0.0), 0.0);
+	ExpectVectorNear(_spline.GetTangent(0.5), Vector3(), 0.0);
+}
\ No newline at end of file
@@ -0,0 +1,310 @@
+#include "SplineLayoutTestUtils.h"
+#include <tuple>
+
+using namespace SplineLayoutTest;
+
+namespace
+{
+	/* A mesh placed by a plan */
+	struct PlacedMesh
+	{
+		PatternPart part = PatternPart::Pattern;
+		int index = 0;
+		double startDistance = 0.0;
+		double length = 0.0;
+
+		bool operator==(const PlacedMesh& _other) const
+		{
+			return std::tie(part, index, startDistance, length) == std::tie(_other.part, _other.index, _other.startDistance, _other.length);
+		}
+	};
+
+	std::vector<PlacedMesh> RunPatternPlan(const std::vector<double>& _start, const std::vector<double>& _pattern, const std::vector<double>& _end, const double _gap, const double _splineLength, int* _reserved = nullptr)
+	{
+		std::vector<PlacedMesh> _placed = std::vector<PlacedMesh>();
+		PatternPlan(_start, _pattern, _end, _gap, _splineLength,
+			[_reserved](const int _count) { if (_reserved) *_reserved = _count; },
+			[&_placed](const PatternPart _part, const int _index, const double _startDistance, const double _length) { _placed.push_back({ _part, _index, _startDistance, _length }); });
+		return _placed;
+	}
+}
+
+TEST(PatternPlan, CapsFramePeriodsAndPartialPeriod)
+{
+	int _reserved = -1;
+	const std::vector<PlacedMesh>& _placed = RunPatternPlan({ 50.0 }, { 100.0, 200.0 }, { 30.0, 20.0 }, 0.0, 1000.0, &_reserved);
+
+	// 50 of start cap, 50 of end cap, 900 left: three periods of 300
+	const std::vector<PlacedMesh> _expected = {
+		{ PatternPart::StartCap, 0, 0.0, 50.0 },
+		{ PatternPart::Pattern, 0, 50.0, 100.0 }, { PatternPart::Pattern, 1, 150.0, 200.0 },
+		{ PatternPart::Pattern, 0, 350.0, 100.0 }, { PatternPart::Pattern, 1, 450.0, 200.0 },
+		{ PatternPart::Pattern, 0, 650.0, 100.0 }, { PatternPart::Pattern, 1, 750.0, 200.0 },
+		{ PatternPart::EndCap, 0, 950.0, 30.0 }, { PatternPart::EndCap, 1, 980.0, 20.0 } };
+	EXPECT_EQ(_placed, _expected);
+	EXPECT_EQ(_reserved, static_cast<int>(_expected.size()));
+}
+
+TEST(PatternPlan, PartialPeriodStopsAtTheFirstMeshThatDoesntFit)
+{
+	const std::vector<PlacedMesh>& _placed = RunPatternPlan({}, { 100.0, 200.0 }, { 50.0 }, 10.0, 500.0);
+
+	// 60 for the end cap, 440 left: one period of 320 and one mesh of 110
+	const std::vector<PlacedMesh> _expected = {
+		{ PatternPart::Pattern, 0, 0.0, 100.0 }, { PatternPart::Pattern, 1, 110.0, 200.0 },
+		{ PatternPart::Pattern, 0, 320.0, 100.0 },
+		{ PatternPart::EndCap, 0, 430.0, 50.0 } };
+	EXPECT_EQ(_placed, _expected);
+}
+
+TEST(PatternPlan, EndCapIsDroppedWhenItDoesntFit)
+{
+	const std::vector<PlacedMesh>& _placed = RunPatternPlan({ 100.0 }, { 100.0 }, { 100.0 }, 0.0, 150.0);
+	const std::vector<PlacedMesh> _expected = { { PatternPart::StartCap, 0, 0.0, 100.0 } };
+	EXPECT_EQ(_placed, _expected);
+}
+
+TEST(PatternPlan, StartCapIsCutWhereItStopsFitting)
+{
+	const std::vector<PlacedMesh>& _placed = RunPatternPlan({ 60.0, 60.0 }, { 10.0 }, {}, 0.0, 100.0);
+
+	// The second start mesh doesn't fit, the pattern fills the rest
+	ASSERT_EQ(_placed.size(), 5u);
+	EXPECT_EQ(_placed[0], (PlacedMesh { PatternPart::StartCap, 0, 0.0, 60.0 }));
+	EXPECT_EQ(_placed[1], (PlacedMesh { PatternPart::Pattern, 0, 60.0, 10.0 }));
+	EXPECT_EQ(_placed[4], (PlacedMesh { PatternPart::Pattern, 0, 90.0, 10.0 }));
+}
+
+TEST(PatternPlan, InvalidMeshesAreSkipped)
+{
+	const std::vector<PlacedMesh>& _placed = RunPatternPlan({ -1.0, 40.0 }, { 100.0, -1.0 }, { -1.0 }, 0.0, 300.0);
+	const std::vector<PlacedMesh> _expected = {
+		{ PatternPart::StartCap, 1, 0.0, 40.0 },
+		{ PatternPart::Pattern, 0, 40.0, 100.0 }, { PatternPart::Pattern, 0, 140.0, 100.0 } };
+	EXPECT_EQ(_placed, _expected);
+}
+
+TEST(PatternPlan, EmptyPatternOnlyPlacesTheCaps)
+{
+	const std::vector<PlacedMesh>& _placed = RunPatternPlan({ 10.0 }, {}, { 20.0 }, 0.0, 1000.0);
+	const std::vector<PlacedMesh> _expected = { { PatternPart::StartCap, 0, 0.0, 10.0 }, { PatternPart::EndCap, 0, 10.0, 20.0 } };
+	EXPECT_EQ(_placed, _expected);
+}
+
+TEST(FillPlan, FillsWhileTheMeshFits)
+{
+	std::vector<double> _starts = std::vector<double>();
+	FillPlan(100.0, 10.0, 345.0, [&_starts](const double _startDistance, const double) { _starts.push_back(_startDistance); });
+	EXPECT_EQ(_starts, (std::vector<double> { 0.0, 110.0, 220.0 }));
+}
+
+TEST(RandomPlan, PlacesValidMeshesUntilTheSplineIsFull)
+{
+	const std::vector<double> _lengths = { 100.0, -1.0, 50.0 };
+	int _draw = 0;
+	double _totalLength = 0.0;
+	RandomPlan(static_cast<int>(_lengths.size()), 0.0, 1000.0, [&_draw]() { return _draw++ % 3; }, [&_lengths](const int _index) { return _lengths[_index]; },
+		[&_totalLength](const int _index, const double _startDistance, const double _length)
+		{
+			EXPECT_NE(_index, 1);
+			EXPECT_DOUBLE_EQ(_startDistance, _totalLength);
+			_totalLength += _length;
+		});
+	EXPECT_LE(_totalLength, 1000.0);
+	EXPECT_GT(_totalLength, 900.0);
+}
+
+TEST(RandomPlan, EndsWhenNoMeshIsValid)
+{
+	int _placed = 0;
+	int _draws = 0;
+	RandomPlan(3, 0.0, 1000.0, [&_draws]() { return _draws++ % 3; }, [](const int) { return -1.0; }, [&_placed](const int, const double, const double) { _placed++; });
+	EXPECT_EQ(_placed, 0);
+	EXPECT_EQ(_draws, 0);
+}
+
+TEST(RandomPlan, EndsWhenTheMeshesDontMoveForward)
+{
+	int _placed = 0;
+	RandomPlan(2, 0.0, 1000.0, []() { return 0; }, [](const int) { return 0.0; }, [&_placed](const int, const double, const double) { _placed++; });
+	EXPECT_EQ(_placed, 0);
+
+	// A negative gap eating the whole mesh
+	RandomPlan(2, -50.0, 1000.0, []() { return 1; }, [](const int) { return 40.0; }, [&_placed](const int, const double, const double) { _placed++; });
+	EXPECT_EQ(_placed, 0);
+}
+
+namespace
+{
+	/* A mesh placed by a sequence plan */
+	struct SequencedMesh
+	{
+		int index = 0;
+		double startDistance = 0.0;
+		double length = 0.0;
+
+		bool operator==(const SequencedMesh& _other) const
+		{
+			return std::tie(index, startDistance, length) == std::tie(_other.index, _other.startDistance, _other.length);
+		}
+	};
+
+	std::vector<SequencedMesh> RunSequencePlan(const std::vector<double>& _lengths, const double _gap, const double _splineLength)
+	{
+		std::vector<SequencedMesh> _placed = std::vector<SequencedMesh>();
+		SequencePlan(static_cast<int>(_lengths.size()), _gap, _splineLength, [&_lengths](const int _index) { return _lengths[_index]; },
+			[&_placed](const int _index, const double _startDistance, const double _length) { _placed.push_back({ _index, _startDistance, _length }); });
+		return _placed;
+	}
+
+	std::vector<Bridge> RunDetectBridges(const std::vector<Vector3>& _groundPoints, const double _gap)
+	{
+		std::vector<Bridge> _bridges = std::vector<Bridge>();
+		DetectBridges(_groundPoints.data(), static_cast<int>(_groundPoints.size()), _gap, [&_bridges](const Bridge& _bridge) { _bridges.push_back(_bridge); });
+		return _bridges;
+	}
+}
+
+TEST(FillPlan, FillsTheWholeSplineWhenNothingRemains)
+{
+	std::vector<double> _starts = std::vector<double>();
+	FillPlan(100.0, 0.0, 300.0, [&_starts](const double _startDistance, const double) { _starts.push_back(_startDistance); });
+	EXPECT_EQ(_starts, (std::vector<double> { 0.0, 100.0, 200.0 }));
+}
+
+TEST(SequencePlan, PlacesEachMeshOnceInOrder)
+{
+	const std::vector<SequencedMesh>& _placed = RunSequencePlan({ 100.0, 50.0, 200.0, 80.0 }, 10.0, 400.0);
+
+	// 380 used after the third mesh, the fourth needs 90
+	const std::vector<SequencedMesh> _expected = { { 0, 0.0, 100.0 }, { 1, 110.0, 50.0 }, { 2, 170.0, 200.0 } };
+	EXPECT_EQ(_placed, _expected);
+}
+
+TEST(SequencePlan, StopsAtTheFirstMeshThatDoesntFit)
+{
+	// The last mesh would fit but the sequence isn't reordered
+	const std::vector<SequencedMesh>& _placed = RunSequencePlan({ 100.0, 500.0, 10.0 }, 0.0, 300.0);
+	const std::vector<SequencedMesh> _expected = { { 0, 0.0, 100.0 } };
+	EXPECT_EQ(_placed, _expected);
+}
+
+TEST(SequencePlan, InvalidMeshesAreSkipped)
+{
+	const std::vector<SequencedMesh>& _placed = RunSequencePlan({ -1.0, 100.0, -1.0, 50.0 }, 0.0, 1000.0);
+	const std::vector<SequencedMesh> _expected = { { 1, 0.0, 100.0 }, { 3, 100.0, 50.0 } };
+	EXPECT_EQ(_placed, _expected);
+}
+
+TEST(SequencePlan, EmptyCompositionPlacesNothing)
+{
+	EXPECT_TRUE(RunSequencePlan({}, 0.0, 1000.0).empty());
+	EXPECT_TRUE(RunSequencePlan({ -1.0, -1.0 }, 0.0, 1000.0).empty());
+}
+
+TEST(SequencePlan, MeshesFillingTheSplineExactlyArePlaced)
+{
+	const std::vector<SequencedMesh>& _placed = RunSequencePlan({ 100.0, 100.0 }, 0.0, 200.0);
+	const std::vector<SequencedMesh> _expected = { { 0, 0.0, 100.0 }, { 1, 100.0, 100.0 } };
+	EXPECT_EQ(_placed, _expected);
+
+	// Nothing fits on an empty spline
+	EXPECT_TRUE(RunSequencePlan({ 100.0 }, 0.0, 0.0).empty());
+}
+
+TEST(GetExtendScale, StretchesTheMeshBetweenTheLocations)
+{
+	EXPECT_DOUBLE_EQ(GetExtendScale(Vector3(0.0, 0.0, 0.0), Vector3(300.0, 400.0, 0.0), 100.0), 5.0);
+	EXPECT_DOUBLE_EQ(GetExtendScale(Vector3(300.0, 400.0, 0.0), Vector3(0.0, 0.0, 0.0), 250.0), 2.0);
+}
+
+TEST(GetExtendScale, DegenerateInputsGiveAZeroScale)
+{
+	EXPECT_DOUBLE_EQ(GetExtendScale(Vector3(0.0, 0.0, 0.0), Vector3(100.0, 0.0, 0.0), 0.0), 0.0);
+	EXPECT_DOUBLE_EQ(GetExtendScale(Vector3(0.0, 0.0, 0.0), Vector3(100.0, 0.0, 0.0), -50.0), 0.0);
+	EXPECT_DOUBLE_EQ(GetExtendScale(Vector3(10.0, 20.0, 30.0), Vector3(10.0, 20.0, 30.0), 100.0), 0.0);
+}
+
+TEST(DetectBridges, FindsTheGapBetweenTwoHeightChanges)
+{
+	const std::vector<Bridge>& _bridges = RunDetectBridges({ Vector3(0.0, 0.0, 0.0), Vector3(100.0, 0.0, 0.0), Vector3(200.0, 0.0, -500.0), Vector3(300.0, 0.0, -500.0), Vector3(400.0, 0.0, 0.0) }, 100.0);
+
+	// The bridge starts one gap before the drop, at the height of the ground before it
+	ASSERT_EQ(_bridges.size(), 1u);
+	ExpectVectorNear(_bridges[0].start, Vector3(100.0, 0.0, 0.0), 1e-9);
+	ExpectVectorNear(_bridges[0].end, Vector3(400.0, 0.0, 0.0), 1e-9);
+	ExpectVectorNear(_bridges[0].ComputeMiddleLocation(), Vector3(250.0, 0.0, 0.0), 1e-9);
+}
+
+TEST(DetectBridges, FindsSuccessiveBridges)
+{
+	const std::vector<Bridge>& _bridges = RunDetectBridges({ Vector3(0.0, 0.0, 0.0), Vector3(50.0, 0.0, -100.0), Vector3(100.0, 0.0, 0.0), Vector3(150.0, 0.0, 0.0), Vector3(200.0, 0.0, -100.0), Vector3(250.0, 0.0, 0.0) }, 50.0);
+	ASSERT_EQ(_bridges.size(), 2u);
+	ExpectVectorNear(_bridges[0].start, Vector3(0.0, 0.0, 0.0), 1e-9);
+	ExpectVectorNear(_bridges[0].end, Vector3(100.0, 0.0, 0.0), 1e-9);
+	ExpectVectorNear(_bridges[1].start, Vector3(150.0, 0.0, 0.0), 1e-9);
+	ExpectVectorNear(_bridges[1].end, Vector3(250.0, 0.0, 0.0), 1e-9);
+}
+
+TEST(DetectBridges, FlatOrUnclosedGroundHasNoBridge)
+{
+	EXPECT_TRUE(RunDetectBridges({ Vector3(0.0, 0.0, 0.0), Vector3(100.0, 0.0, 0.0), Vector3(200.0, 0.0, 0.0) }, 100.0).empty());
+
+	// The ground drops and never comes back
+	EXPECT_TRUE(RunDetectBridges({ Vector3(0.0, 0.0, 0.0), Vector3(100.0, 0.0, -500.0), Vector3(200.0, 0.0, -500.0) }, 100.0).empty());
+}
+
+TEST(DetectBridges, NoSamplesHasNoBridge)
+{
+	EXPECT_TRUE(RunDetectBridges({}, 100.0).empty());
+	EXPECT_TRUE(RunDetectBridges({ Vector3(0.0, 0.0, -500.0) }, 100.0).empty());
+}
+
+TEST(GetRotatedVector, EachAxisTurnsInItsPlane)
+{
+	ExpectVectorNear(GetRotatedVector(RotationAxis::X, 0.0), Vector3(0.0, -1.0, 0.0), 1e-12);
+	ExpectVectorNear(GetRotatedVector(RotationAxis::X, 90.0), Vector3(0.0, 0.0, 1.0), 1e-12);
+	ExpectVectorNear(GetRotatedVector(RotationAxis::Y, 0.0), Vector3(1.0, 0.0, 0.0), 1e-12);
+	ExpectVectorNear(GetRotatedVector(RotationAxis::Y, 90.0), Vector3(0.0, 0.0, 1.0), 1e-12);
+	ExpectVectorNear(GetRotatedVector(RotationAxis::Z, 0.0), Vector3(1.0, 0.0, 0.0), 1e-12);
+	ExpectVectorNear(GetRotatedVector(RotationAxis::Z, 90.0), Vector3(0.0, 1.0, 0.0), 1e-12);
+
+	// The direction stays a unit vector at any angle
+	for (const RotationAxis _axis : { RotationAxis::X, RotationAxis::Y, RotationAxis::Z })
+	{
+		EXPECT_NEAR(GetRotatedVector(_axis, 37.0).Length(), 1.0, 1e-12);
+	}
+}
+
+TEST(RotateSegment, EachAxisKeepsTheLengthOfTheSegment)
+{
+	const Vector3 _start = Vector3(10.0, 20.0, 30.0);
+	const Vector3 _end = Vector3(110.0, 20.0, 30.0);
+
+	const RotatedSegment& _x = RotateSegment(_start, _end, RotationAxis::X, 90.0);
+	ExpectVectorNear(_x.end, Vector3(10.0, 20.0, 130.0), 1e-9);
+	ExpectVectorNear(_x.tangent, Vector3(0.0, 20.0, 0.0), 1e-9);
+
+	// The tangent of the Y axis keeps the height of the new end, the others its Y
+	const RotatedSegment& _y = RotateSegment(_start, _end, RotationAxis::Y, 90.0);
+	ExpectVectorNear(_y.end, Vector3(10.0, 20.0, 130.0), 1e-9);
+	ExpectVectorNear(_y.tangent, Vector3(0.0, 0.0, 130.0), 1e-9);
+
+	const RotatedSegment& _z = RotateSegment(_start, _end, RotationAxis::Z, 90.0);
+	ExpectVectorNear(_z.end, Vector3(10.0, 120.0, 30.0), 1e-9);
+	ExpectVectorNear(_z.tangent, Vector3(0.0, 120.0, 0.0), 1e-9);
+
+	for (const RotationAxis _axis : { RotationAxis::X, RotationAxis::Y, RotationAxis::Z })
+	{
+		EXPECT_NEAR((RotateSegment(_start, _end, _axis, 25.0).end - _start).Length(), 100.0, 1e-9);
+	}
+}
+
+TEST(RotateSegment, ZeroLengthSegmentStaysOnItsStart)
+{
+	const Vector3 _start = Vector3(10.0, 20.0, 30.0);
+	for (const RotationAxis _axis : { RotationAxis::X, RotationAxis::Y, RotationAxis::Z })
+	{
+		ExpectVectorNear(RotateSegment(_start, _start, _axis, 45.0).end, _start, 1e-12);
+	}
+}
\ No newline at end of file
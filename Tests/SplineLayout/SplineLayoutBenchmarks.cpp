@@ -0,0 +1,218 @@
+#include "SplineLayout.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+
+using namespace SplineLayout;
+
+namespace
+{
+	/* A winding spline of a number of points, 1000 units apart */
+	HermiteSpline MakeSpline(const int _pointsCount)
+	{
+		std::vector<SplinePoint> _points = std::vector<SplinePoint>(static_cast<size_t>(_pointsCount));
+		for (int _pointIndex = 0; _pointIndex < _pointsCount; _pointIndex++)
+		{
+			SplinePoint& _point = _points[static_cast<size_t>(_pointIndex)];
+			_point.position = Vector3(_pointIndex * 1000.0, std::sin(_pointIndex * 0.7) * 400.0, 0.0);
+			_point.arriveTangent = Vector3(1200.0, std::cos(_pointIndex * 0.7) * 300.0, 0.0);
+			_point.leaveTangent = _point.arriveTangent;
+		}
+
+		return HermiteSpline(_points);
+	}
+
+	/* Sorted distances spread over a spline */
+	std::vector<double> MakeDistances(const HermiteSpline& _spline, const int64_t _count)
+	{
+		std::vector<double> _distances = std::vector<double>(static_cast<size_t>(_count));
+		for (size_t _index = 0; _index < _distances.size(); _index++)
+		{
+			_distances[_index] = _spline.GetLength() * static_cast<double>(_index) / static_cast<double>(_count);
+		}
+
+		return _distances;
+	}
+}
+
+static void BM_HermiteSplineBuild(benchmark::State& _state)
+{
+	const HermiteSpline& _source = MakeSpline(static_cast<int>(_state.range(0)));
+	std::vector<SplinePoint> _points = std::vector<SplinePoint>();
+	for (int _pointIndex = 0; _pointIndex < _source.GetPointCount(); _pointIndex++) _points.push_back(_source.GetPoint(_pointIndex));
+
+	for (auto _ : _state)
+	{
+		HermiteSpline _spline = HermiteSpline(_points);
+		benchmark::DoNotOptimize(_spline.GetLength());
+	}
+	_state.SetItemsProcessed(_state.iterations() * _state.range(0));
+}
+BENCHMARK(BM_HermiteSplineBuild)->Arg(16)->Arg(256)->Arg(4096);
+
+static void BM_HermiteSplineKeyAtDistance(benchmark::State& _state)
+{
+	const HermiteSpline& _spline = MakeSpline(256);
+	const std::vector<double>& _distances = MakeDistances(_spline, 4096);
+	for (auto _ : _state)
+	{
+		for (const double _distance : _distances) benchmark::DoNotOptimize(_spline.GetKeyAtDistance(_distance));
+	}
+	_state.SetItemsProcessed(_state.iterations() * static_cast<int64_t>(_distances.size()));
+}
+BENCHMARK(BM_HermiteSplineKeyAtDistance);
+
+static void BM_ScalarEvaluateDistances(benchmark::State& _state)
+{
+	const HermiteSpline& _spline = MakeSpline(256);
+	const std::vector<double>& _distances = MakeDistances(_spline, _state.range(0));
+	for (auto _ : _state)
+	{
+		for (const double _distance : _distances)
+		{
+			const double _key = _spline.GetKeyAtDistance(_distance);
+			benchmark::DoNotOptimize(_spline.GetLocation(_key));
+			benchmark::DoNotOptimize(_spline.GetTangent(_key));
+		}
+	}
+	_state.SetItemsProcessed(_state.iterations() * _state.range(0));
+}
+BENCHMARK(BM_ScalarEvaluateDistances)->Arg(1024)->Arg(65536);
+
+static void BM_BatchEvaluateDistances(benchmark::State& _state)
+{
+	const HermiteSpline& _spline = MakeSpline(256);
+	const std::vector<double>& _distances = MakeDistances(_spline, _state.range(0));
+	SplineSamples _samples = SplineSamples();
+	for (auto _ : _state)
+	{
+		BatchEvaluator(_spline).EvaluateDistances(_distances.data(), _distances.size(), _samples);
+		benchmark::DoNotOptimize(_samples.x.data());
+	}
+	_state.SetItemsProcessed(_state.iterations() * _state.range(0));
+}
+BENCHMARK(BM_BatchEvaluateDistances)->Arg(1024)->Arg(65536);
+
+static void BM_FillPlan(benchmark::State& _state)
+{
+	// The plan of as many meshes as the evaluation benchmarks evaluate ends
+	const double _splineLength = static_cast<double>(_state.range(0)) * 100.0;
+	std::vector<double> _entries = std::vector<double>();
+	for (auto _ : _state)
+	{
+		_entries.clear();
+		FillPlan(100.0, 0.0, _splineLength, [&_entries](const double _startDistance, const double) { _entries.push_back(_startDistance); });
+		benchmark::DoNotOptimize(_entries.data());
+	}
+	_state.SetItemsProcessed(_state.iterations() * _state.range(0));
+}
+BENCHMARK(BM_FillPlan)->Arg(512)->Arg(32768);
+
+static void BM_PatternPlan(benchmark::State& _state)
+{
+	const std::vector<double> _start = { 120.0, 80.0 };
+	const std::vector<double> _pattern = { 100.0, 250.0, -1.0, 60.0 };
+	const std::vector<double> _end = { 90.0 };
+	const double _splineLength = static_cast<double>(_state.range(0)) * 100.0;
+	std::vector<double> _entries = std::vector<double>();
+	for (auto _ : _state)
+	{
+		_entries.clear();
+		PatternPlan(_start, _pattern, _end, 5.0, _splineLength, [&_entries](const int _count) { _entries.reserve(static_cast<size_t>(_count)); },
+			[&_entries](const PatternPart, const int, const double _startDistance, const double) { _entries.push_back(_startDistance); });
+		benchmark::DoNotOptimize(_entries.data());
+	}
+	_state.SetItemsProcessed(_state.iterations() * static_cast<int64_t>(_entries.size()));
+}
+BENCHMARK(BM_PatternPlan)->Arg(512)->Arg(32768);
+
+static void BM_FrameTableBuild(benchmark::State& _state)
+{
+	const HermiteSpline& _spline = MakeSpline(256);
+	FrameTable _frameTable = FrameTable();
+	for (auto _ : _state)
+	{
+		_frameTable.Build(_spline, static_cast<double>(_state.range(0)), Vector3(0.0, 0.0, 1.0));
+		benchmark::DoNotOptimize(_frameTable.GetFrameCount());
+	}
+	_state.SetItemsProcessed(_state.iterations() * static_cast<int64_t>(_frameTable.GetFrameCount()));
+}
+BENCHMARK(BM_FrameTableBuild)->Arg(10)->Arg(100);
+
+static void BM_FrameTableGetFrame(benchmark::State& _state)
+{
+	const HermiteSpline& _spline = MakeSpline(256);
+	FrameTable _frameTable = FrameTable();
+	_frameTable.Build(_spline, 10.0, Vector3(0.0, 0.0, 1.0));
+	const std::vector<double>& _distances = MakeDistances(_spline, 4096);
+	for (auto _ : _state)
+	{
+		for (const double _distance : _distances) benchmark::DoNotOptimize(_frameTable.GetFrameAtDistance(_distance));
+	}
+	_state.SetItemsProcessed(_state.iterations() * static_cast<int64_t>(_distances.size()));
+}
+BENCHMARK(BM_FrameTableGetFrame);
+
+static void BM_BridgeSpanDeck(benchmark::State& _state)
+{
+	const SagProfile _profile = _state.range(0) == 0 ? SagProfile::Catenary : SagProfile::Parabola;
+	int64_t _planksCount = 0;
+	for (auto _ : _state)
+	{
+		BridgeSpan _span = BridgeSpan();
+		_span.Build(Vector3(0.0, 0.0, 0.0), Vector3(5000.0, 0.0, 0.0), Vector3(0.0, 0.0, 1.0), 250.0, _profile, 1200.0);
+		PlaceDeck(_span, 40.0, 2.0, [&_span, &_planksCount](const double _startDistance, const double _endDistance)
+		{
+			Vector3 _location = Vector3(), _direction = Vector3();
+			_span.GetAtDistance(_startDistance, _location, _direction);
+			_span.GetAtDistance(_endDistance, _location, _direction);
+			benchmark::DoNotOptimize(_location);
+			_planksCount++;
+		});
+	}
+	_state.SetItemsProcessed(_planksCount);
+}
+BENCHMARK(BM_BridgeSpanDeck)->Arg(0)->Arg(1);
+
+static void BM_ScatterProps(benchmark::State& _state)
+{
+	// The scatter of a layer: jittered distances sorted, evaluated in one batch, then turned by the tangent and pushed aside
+	// The timePer1000Props counter is checked against the 1 ms per 1000 props budget of the scatter layers
+	const HermiteSpline& _spline = MakeSpline(256);
+	const int64_t _propsCount = _state.range(0);
+	const double _spacing = _spline.GetLength() / static_cast<double>(_propsCount);
+	std::vector<double> _distances = std::vector<double>(static_cast<size_t>(_propsCount));
+	std::vector<double> _sideJitters = std::vector<double>(static_cast<size_t>(_propsCount));
+	std::vector<Vector3> _locations = std::vector<Vector3>(static_cast<size_t>(_propsCount));
+	std::vector<double> _yaws = std::vector<double>(static_cast<size_t>(_propsCount));
+	SplineSamples _samples = SplineSamples();
+	for (auto _ : _state)
+	{
+		std::mt19937 _random = std::mt19937(1337u);
+		std::uniform_real_distribution<double> _jitter = std::uniform_real_distribution<double>(-0.5, 0.5);
+		for (size_t _index = 0; _index < _distances.size(); _index++)
+		{
+			_distances[_index] = std::clamp((static_cast<double>(_index) + 0.5 + _jitter(_random)) * _spacing, 0.0, _spline.GetLength());
+			_sideJitters[_index] = 150.0 + _jitter(_random) * 50.0;
+		}
+		std::sort(_distances.begin(), _distances.end());
+
+		BatchEvaluator(_spline).EvaluateDistances(_distances.data(), _distances.size(), _samples);
+		for (size_t _index = 0; _index < _distances.size(); _index++)
+		{
+			const Vector3& _location = _samples.GetLocation(_index);
+			const Vector3& _tangent = _samples.GetTangent(_index);
+			const double _yaw = std::atan2(_tangent.y, _tangent.x);
+			_yaws[_index] = _yaw;
+			_locations[_index] = Vector3(_location.x - std::sin(_yaw) * _sideJitters[_index], _location.y + std::cos(_yaw) * _sideJitters[_index], _location.z);
+		}
+		benchmark::DoNotOptimize(_locations.data());
+		benchmark::DoNotOptimize(_yaws.data());
+	}
+	_state.SetItemsProcessed(_state.iterations() * _propsCount);
+	_state.counters["timePer1000Props"] = benchmark::Counter(static_cast<double>(_propsCount) / 1000.0,
+		benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_ScatterProps)->Arg(1000)->Arg(100000);
+
+BENCHMARK_MAIN();
\ No newline at end of file
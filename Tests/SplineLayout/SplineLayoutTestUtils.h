@@ -0,0 +1,62 @@
+#pragma once
+#include "SplineLayout.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+/* Splines shared by the tests and the benchmarks of the layout core */
+namespace SplineLayoutTest
+{
+	using namespace SplineLayout;
+
+	/* Make a point of a spline, the tangent is used on both sides */
+	inline SplinePoint MakePoint(const Vector3& _position, const Vector3& _tangent, const InterpMode _interpMode = InterpMode::Curve)
+	{
+		SplinePoint _point = SplinePoint();
+		_point.position = _position;
+		_point.arriveTangent = _tangent;
+		_point.leaveTangent = _tangent;
+		_point.interpMode = _interpMode;
+		return _point;
+	}
+
+	/* Make a polyline through points */
+	inline HermiteSpline MakeLinearSpline(const std::vector<Vector3>& _positions, const bool _closedLoop = false)
+	{
+		std::vector<SplinePoint> _points = std::vector<SplinePoint>();
+		for (const Vector3& _position : _positions)
+		{
+			_points.push_back(MakePoint(_position, Vector3(), InterpMode::Linear));
+		}
+
+		return HermiteSpline(_points, _closedLoop);
+	}
+
+	/* Make a quarter of a circle of a radius in the XY plane, around the origin */
+	inline HermiteSpline MakeQuarterCircle(const double _radius)
+	{
+		// The tangent length that best fits a circle with one cubic segment, 3 times the usual Bezier handle
+		const double _tangentLength = _radius * 4.0 * (std::sqrt(2.0) - 1.0);
+		return HermiteSpline({ MakePoint(Vector3(_radius, 0.0, 0.0), Vector3(0.0, _tangentLength, 0.0)), MakePoint(Vector3(0.0, _radius, 0.0), Vector3(-_tangentLength, 0.0, 0.0)) });
+	}
+
+	/* Make a winding curve mixing the three interpolation modes, like an edited road */
+	inline HermiteSpline MakeWindingSpline(const int _pointsCount, const bool _closedLoop = false)
+	{
+		std::vector<SplinePoint> _points = std::vector<SplinePoint>();
+		for (int _pointIndex = 0; _pointIndex < _pointsCount; _pointIndex++)
+		{
+			const double _x = _pointIndex * 1000.0;
+			const InterpMode _interpMode = _pointIndex % 7 == 3 ? InterpMode::Linear : _pointIndex % 11 == 5 ? InterpMode::Constant : InterpMode::Curve;
+			_points.push_back(MakePoint(Vector3(_x, std::sin(_pointIndex * 0.7) * 400.0, std::cos(_pointIndex * 0.3) * 50.0), Vector3(1200.0, std::cos(_pointIndex * 0.7) * 300.0, 0.0), _interpMode));
+		}
+
+		return HermiteSpline(_points, _closedLoop);
+	}
+
+	inline void ExpectVectorNear(const Vector3& _actual, const Vector3& _expected, const double _tolerance)
+	{
+		EXPECT_NEAR(_actual.x, _expected.x, _tolerance);
+		EXPECT_NEAR(_actual.y, _expected.y, _tolerance);
+		EXPECT_NEAR(_actual.z, _expected.z, _tolerance);
+	}
+}
\ No newline at end of file